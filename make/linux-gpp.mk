@@ -96,6 +96,7 @@ LINK_GUI_PLAYGROUND = $(CPP_TARGET_PLATFORM) -Wall
 
 TARGET_PLATFORM_LFLAGS = \
 	$(ARCH_LFLAGS) \
+	-pthread \
 	-lcairo \
 	-lxcb \
 	-lxcb-render
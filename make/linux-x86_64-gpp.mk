@@ -17,7 +17,7 @@
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 ###############################################################################
 
-INSTRUCTION_SET ?= avx
+INSTRUCTION_SET ?= dispatch
 
 LIB_PATH ?= $(BUILD_DIR)/lib64
 SYS_LIB_PATH ?= /usr/lib/x86_64-linux-gnu
@@ -17,7 +17,7 @@
 # along with this program.  If not, see <https://www.gnu.org/licenses/>.
 ###############################################################################
 
-INSTRUCTION_SET ?= avx
+INSTRUCTION_SET ?= dispatch
 
 SUFFIX = x86_64
 
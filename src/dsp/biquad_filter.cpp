@@ -30,6 +30,36 @@ namespace JS80P
 BiquadFilterTypeParam dummy_filter_type("dummy_filter_type");
 
 
+BiquadFilterCoefficientWrapper::BiquadFilterCoefficientWrapper(
+        Number const value
+) noexcept
+    : value(value)
+{
+}
+
+
+Number BiquadFilterCoefficientWrapper::operator[](
+        Integer const index
+) const noexcept {
+    return value;
+}
+
+
+BiquadFilterCoefficientBufferWrapper::BiquadFilterCoefficientBufferWrapper(
+        Number const* const buffer
+) noexcept
+    : buffer(buffer)
+{
+}
+
+
+Number BiquadFilterCoefficientBufferWrapper::operator[](
+        Integer const index
+) const noexcept {
+    return buffer[index];
+}
+
+
 BiquadFilterSharedBuffers::BiquadFilterSharedBuffers()
     : round(-1),
     b0_buffer(NULL),
@@ -130,10 +160,10 @@ void BiquadFilter<
 
     this->allocate_buffers();
 
-    x_n_m1 = new Sample[this->channels];
-    x_n_m2 = new Sample[this->channels];
-    y_n_m1 = new Sample[this->channels];
-    y_n_m2 = new Sample[this->channels];
+    x_n_m1 = new Number[this->channels];
+    x_n_m2 = new Number[this->channels];
+    y_n_m1 = new Number[this->channels];
+    y_n_m2 = new Number[this->channels];
 
     BiquadFilter<InputSignalProducerClass, fixed_type>::reset();
     update_helper_variables();
@@ -146,7 +176,7 @@ void BiquadFilter<
         fixed_type
 >::update_helper_variables() noexcept
 {
-    w0_scale = (Sample)Math::PI_DOUBLE * (Sample)this->sampling_period;
+    w0_scale = Math::PI_DOUBLE * (Number)this->sampling_period;
     low_pass_no_op_frequency = std::min(
         (Number)this->nyquist_frequency, frequency.get_max_value()
     );
@@ -345,11 +375,11 @@ void BiquadFilter<
         return;
     }
 
-    b0_buffer = new Sample[this->block_size];
-    b1_buffer = new Sample[this->block_size];
-    b2_buffer = new Sample[this->block_size];
-    a1_buffer = new Sample[this->block_size];
-    a2_buffer = new Sample[this->block_size];
+    b0_buffer = new Number[this->block_size];
+    b1_buffer = new Number[this->block_size];
+    b2_buffer = new Number[this->block_size];
+    a1_buffer = new Number[this->block_size];
+    a2_buffer = new Number[this->block_size];
 }
 
 
@@ -408,6 +438,17 @@ void BiquadFilter<InputSignalProducerClass, fixed_type>::update_inaccuracy(
 }
 
 
+template<class InputSignalProducerClass, BiquadFilterFixedType fixed_type>
+void BiquadFilter<InputSignalProducerClass, fixed_type>::set_shared_buffers(
+        BiquadFilterSharedBuffers* const shared_buffers
+) noexcept {
+    JS80P_ASSERT(this->shared_buffers != NULL);
+    JS80P_ASSERT(shared_buffers != NULL);
+
+    this->shared_buffers = shared_buffers;
+}
+
+
 #define JS80P_BF_CALL_INIT_FQ(func)                                     \
     do {                                                                \
         if (is_freq_inaccurate) {                                       \
@@ -825,24 +866,24 @@ void BiquadFilter<
         Number const frequency_value,
         Number const q_value
 ) const noexcept {
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample const alpha_qdb = (
+    Number const alpha_qdb = (
         0.5 * sin_w0 * Math::pow_10_inv(
             apply_q_inaccuracy<is_q_inaccurate>(q_value)
             * Constants::BIQUAD_FILTER_Q_SCALE
         )
     );
 
-    Sample const b1 = 1.0 - cos_w0;
-    Sample const b0_b2 = 0.5 * b1;
+    Number const b1 = 1.0 - cos_w0;
+    Number const b0_b2 = 0.5 * b1;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -953,24 +994,24 @@ void BiquadFilter<
         Number const frequency_value,
         Number const q_value
 ) const noexcept {
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample const alpha_qdb = (
+    Number const alpha_qdb = (
         0.5 * sin_w0 * Math::pow_10_inv(
             apply_q_inaccuracy<is_q_inaccurate>(q_value)
             * Constants::BIQUAD_FILTER_Q_SCALE
         )
     );
 
-    Sample const b1 = -1.0 - cos_w0;
-    Sample const b0_b2 = -0.5 * b1;
+    Number const b1 = -1.0 - cos_w0;
+    Number const b0_b2 = -0.5 * b1;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -1074,16 +1115,16 @@ void BiquadFilter<
         Number const frequency_value,
         Number const q_value
 ) const noexcept {
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample q;
+    Number q;
 
     if constexpr (is_q_inaccurate) {
         q = std::max(THRESHOLD, apply_q_inaccuracy<true>(q_value));
@@ -1094,7 +1135,7 @@ void BiquadFilter<
         JS80P_ASSERT(q >= THRESHOLD);
     }
 
-    Sample const alpha_q = 0.5 * sin_w0 / q;
+    Number const alpha_q = 0.5 * sin_w0 / q;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -1202,16 +1243,16 @@ void BiquadFilter<
         Number const frequency_value,
         Number const q_value
 ) const noexcept {
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample q;
+    Number q;
 
     if constexpr (is_q_inaccurate) {
         q = std::max(THRESHOLD, apply_q_inaccuracy<true>(q_value));
@@ -1222,9 +1263,9 @@ void BiquadFilter<
         JS80P_ASSERT(q >= THRESHOLD);
     }
 
-    Sample const alpha_q = 0.5 * sin_w0 / q;
+    Number const alpha_q = 0.5 * sin_w0 / q;
 
-    Sample const b1_a1 = -2.0 * cos_w0;
+    Number const b1_a1 = -2.0 * cos_w0;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -1339,18 +1380,18 @@ void BiquadFilter<
         Number const q_value,
         Number const gain_value
 ) const noexcept {
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample const b1_a1 = -2.0 * cos_w0;
+    Number const b1_a1 = -2.0 * cos_w0;
 
-    Sample q;
+    Number q;
 
     if constexpr (is_q_inaccurate) {
         q = std::max(THRESHOLD, apply_q_inaccuracy<true>(q_value));
@@ -1361,14 +1402,14 @@ void BiquadFilter<
         JS80P_ASSERT(q >= THRESHOLD);
     }
 
-    Sample const alpha_q = 0.5 * sin_w0 / q;
+    Number const alpha_q = 0.5 * sin_w0 / q;
 
-    Sample const a = Math::pow_10(
-        (Sample)gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
+    Number const a = Math::pow_10(
+        gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
     );
 
-    Sample const alpha_q_times_a = alpha_q * a;
-    Sample const alpha_q_over_a = alpha_q / a;
+    Number const alpha_q_times_a = alpha_q * a;
+    Number const alpha_q_over_a = alpha_q / a;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -1483,32 +1524,32 @@ void BiquadFilter<
         Number const frequency_value,
         Number const gain_value
 ) const noexcept {
-    Sample const a = Math::pow_10(
-        (Sample)gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
+    Number const a = Math::pow_10(
+        gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
     );
-    Sample const a_p_1 = a + 1.0;
-    Sample const a_m_1 = a - 1.0;
+    Number const a_p_1 = a + 1.0;
+    Number const a_m_1 = a - 1.0;
 
     /* Recalculating the power seems to be slightly faster than std::sqrt(a). */
-    Sample const a_sqrt = Math::pow_10((Sample)gain_value * GAIN_SCALE_HALF);
+    Number const a_sqrt = Math::pow_10(gain_value * GAIN_SCALE_HALF);
 
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample const a_m_1_cos_w0 = a_m_1 * cos_w0;
-    Sample const a_p_1_cos_w0 = a_p_1 * cos_w0;
+    Number const a_m_1_cos_w0 = a_m_1 * cos_w0;
+    Number const a_p_1_cos_w0 = a_p_1 * cos_w0;
 
     /*
     S = 1 makes sqrt((A + 1/A) * (1/S - 1) + 2) collapse to just sqrt(2). Also,
     alpha_s is always multiplied by 2, which cancels dividing the sine by 2.
     */
-    Sample const alpha_s_double_a_sqrt = sin_w0 * FREQUENCY_SINE_SCALE * a_sqrt;
+    Number const alpha_s_double_a_sqrt = sin_w0 * FREQUENCY_SINE_SCALE * a_sqrt;
 
     /*
     The a1 and a2 coefficients are multiplied by -1 here so that rendering can
@@ -1623,32 +1664,32 @@ void BiquadFilter<
         Number const frequency_value,
         Number const gain_value
 ) const noexcept {
-    Sample const a = Math::pow_10(
-        (Sample)gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
+    Number const a = Math::pow_10(
+        gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
     );
-    Sample const a_p_1 = a + 1.0;
-    Sample const a_m_1 = a - 1.0;
+    Number const a_p_1 = a + 1.0;
+    Number const a_m_1 = a - 1.0;
 
     /* Recalculating the power seems to be slightly faster than std::sqrt(a). */
-    Sample const a_sqrt = Math::pow_10((Sample)gain_value * GAIN_SCALE_HALF);
+    Number const a_sqrt = Math::pow_10(gain_value * GAIN_SCALE_HALF);
 
-    Sample const w0 = (
+    Number const w0 = (
         w0_scale * apply_freq_inaccuracy<is_freq_inaccurate>(frequency_value)
     );
 
-    Sample sin_w0;
-    Sample cos_w0;
+    Number sin_w0;
+    Number cos_w0;
 
     Math::sincos(w0, sin_w0, cos_w0);
 
-    Sample const a_m_1_cos_w0 = a_m_1 * cos_w0;
-    Sample const a_p_1_cos_w0 = a_p_1 * cos_w0;
+    Number const a_m_1_cos_w0 = a_m_1 * cos_w0;
+    Number const a_p_1_cos_w0 = a_p_1 * cos_w0;
 
     /*
     S = 1 makes sqrt((A + 1/A) * (1/S - 1) + 2) collapse to just sqrt(2). Also,
     alpha_s is always multiplied by 2, which cancels dividing the sine by 2.
     */
-    Sample const alpha_s_double_a_sqrt = (
+    Number const alpha_s_double_a_sqrt = (
         sin_w0 * FREQUENCY_SINE_SCALE * a_sqrt
     );
 
@@ -1678,7 +1719,7 @@ void BiquadFilter<
 ) const noexcept {
     store_normalized_coefficient_samples(
         index,
-        (Sample)Math::db_to_linear(gain_value),
+        Math::db_to_linear(gain_value),
         0.0,
         0.0,
         1.0,
@@ -1694,14 +1735,14 @@ void BiquadFilter<
         fixed_type
 >::store_normalized_coefficient_samples(
         Integer const index,
-        Sample const b0,
-        Sample const b1,
-        Sample const b2,
-        Sample const a0,
-        Sample const a1,
-        Sample const a2
+        Number const b0,
+        Number const b1,
+        Number const b2,
+        Number const a0,
+        Number const a1,
+        Number const a2
 ) const noexcept {
-    Sample const a0_inv = 1.0 / a0;
+    Number const a0_inv = 1.0 / a0;
 
     b0_buffer[index] = b0 * a0_inv;
     b1_buffer[index] = b1 * a0_inv;
@@ -1760,54 +1801,54 @@ void BiquadFilter<InputSignalProducerClass, fixed_type>::render(
 
     if (are_coefficients_constant) {
         if (can_use_shared_coefficients) {
-            render<ParamValueWrapper>(
+            render<BiquadFilterCoefficientWrapper>(
                 round,
                 first_sample_index,
                 end_sample_index,
                 buffer,
-                ParamValueWrapper(shared_buffers->b0_buffer[0]),
-                ParamValueWrapper(shared_buffers->b1_buffer[0]),
-                ParamValueWrapper(shared_buffers->b2_buffer[0]),
-                ParamValueWrapper(shared_buffers->a1_buffer[0]),
-                ParamValueWrapper(shared_buffers->a2_buffer[0])
+                BiquadFilterCoefficientWrapper(shared_buffers->b0_buffer[0]),
+                BiquadFilterCoefficientWrapper(shared_buffers->b1_buffer[0]),
+                BiquadFilterCoefficientWrapper(shared_buffers->b2_buffer[0]),
+                BiquadFilterCoefficientWrapper(shared_buffers->a1_buffer[0]),
+                BiquadFilterCoefficientWrapper(shared_buffers->a2_buffer[0])
             );
         } else {
-            render<ParamValueWrapper>(
+            render<BiquadFilterCoefficientWrapper>(
                 round,
                 first_sample_index,
                 end_sample_index,
                 buffer,
-                ParamValueWrapper(b0_buffer[0]),
-                ParamValueWrapper(b1_buffer[0]),
-                ParamValueWrapper(b2_buffer[0]),
-                ParamValueWrapper(a1_buffer[0]),
-                ParamValueWrapper(a2_buffer[0])
+                BiquadFilterCoefficientWrapper(b0_buffer[0]),
+                BiquadFilterCoefficientWrapper(b1_buffer[0]),
+                BiquadFilterCoefficientWrapper(b2_buffer[0]),
+                BiquadFilterCoefficientWrapper(a1_buffer[0]),
+                BiquadFilterCoefficientWrapper(a2_buffer[0])
             );
         }
     } else {
         if (can_use_shared_coefficients) {
-            render<ParamValueBufferWrapper>(
+            render<BiquadFilterCoefficientBufferWrapper>(
                 round,
                 first_sample_index,
                 end_sample_index,
                 buffer,
-                ParamValueBufferWrapper(shared_buffers->b0_buffer),
-                ParamValueBufferWrapper(shared_buffers->b1_buffer),
-                ParamValueBufferWrapper(shared_buffers->b2_buffer),
-                ParamValueBufferWrapper(shared_buffers->a1_buffer),
-                ParamValueBufferWrapper(shared_buffers->a2_buffer)
+                BiquadFilterCoefficientBufferWrapper(shared_buffers->b0_buffer),
+                BiquadFilterCoefficientBufferWrapper(shared_buffers->b1_buffer),
+                BiquadFilterCoefficientBufferWrapper(shared_buffers->b2_buffer),
+                BiquadFilterCoefficientBufferWrapper(shared_buffers->a1_buffer),
+                BiquadFilterCoefficientBufferWrapper(shared_buffers->a2_buffer)
             );
         } else {
-            render<ParamValueBufferWrapper>(
+            render<BiquadFilterCoefficientBufferWrapper>(
                 round,
                 first_sample_index,
                 end_sample_index,
                 buffer,
-                ParamValueBufferWrapper(b0_buffer),
-                ParamValueBufferWrapper(b1_buffer),
-                ParamValueBufferWrapper(b2_buffer),
-                ParamValueBufferWrapper(a1_buffer),
-                ParamValueBufferWrapper(a2_buffer)
+                BiquadFilterCoefficientBufferWrapper(b0_buffer),
+                BiquadFilterCoefficientBufferWrapper(b1_buffer),
+                BiquadFilterCoefficientBufferWrapper(b2_buffer),
+                BiquadFilterCoefficientBufferWrapper(a1_buffer),
+                BiquadFilterCoefficientBufferWrapper(a2_buffer)
             );
         }
     }
@@ -1830,34 +1871,42 @@ void BiquadFilter<InputSignalProducerClass, fixed_type>::render(
     Integer const channels = this->channels;
     Sample const* const* const input_buffer = this->input_buffer;
 
-    for (Integer c = 0; c != channels; ++c) {
-        Sample const* const input_channel = input_buffer[c];
-        Sample* const output_channel = buffer[c];
-        Sample x_n_m1 = this->x_n_m1[c];
-        Sample x_n_m2 = this->x_n_m2[c];
-        Sample y_n_m1 = this->y_n_m1[c];
-        Sample y_n_m2 = this->y_n_m2[c];
-
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            Sample const x_n = input_channel[i];
-            Sample const y_n = (
-                b0[i] * x_n + b1[i] * x_n_m1 + b2[i] * x_n_m2
-                + a1[i] * y_n_m1 + a2[i] * y_n_m2
-            );
-
-            output_channel[i] = y_n;
-
-            x_n_m2 = x_n_m1;
-            x_n_m1 = x_n;
-            y_n_m2 = y_n_m1;
-            y_n_m1 = y_n;
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            for (Integer c = 0; c != channels; ++c) {
+                Sample const* const input_channel = input_buffer[c];
+                Sample* const output_channel = buffer[c];
+                Number x_n_m1 = this->x_n_m1[c];
+                Number x_n_m2 = this->x_n_m2[c];
+                Number y_n_m1 = this->y_n_m1[c];
+                Number y_n_m2 = this->y_n_m2[c];
+
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    Sample const x_n = input_channel[i];
+                    Number const y_n = (
+                        b0[i] * x_n + b1[i] * x_n_m1 + b2[i] * x_n_m2
+                        + a1[i] * y_n_m1 + a2[i] * y_n_m2
+                    );
+
+                    output_channel[i] = y_n;
+
+                    x_n_m2 = x_n_m1;
+                    x_n_m1 = x_n;
+                    y_n_m2 = y_n_m1;
+                    y_n_m1 = y_n;
+                }
+
+                this->x_n_m1[c] = x_n_m1;
+                this->x_n_m2[c] = x_n_m2;
+                this->y_n_m1[c] = y_n_m1;
+                this->y_n_m2[c] = y_n_m2;
+            }
         }
-
-        this->x_n_m1[c] = x_n_m1;
-        this->x_n_m2[c] = x_n_m2;
-        this->y_n_m1[c] = y_n_m1;
-        this->y_n_m2[c] = y_n_m2;
-    }
+    );
 }
 
 }
@@ -21,6 +21,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.hpp"
 #include "dsp/filter.hpp"
 #include "dsp/math.hpp"
 #include "dsp/param.hpp"
@@ -50,17 +51,49 @@ class BiquadFilter;
 typedef BiquadFilter<SignalProducer> SimpleBiquadFilter;
 
 
+/**
+ * \brief Coefficients are kept in double precision even when samples are
+ *        single precision, because the filter's poles get very close to the
+ *        unit circle at low frequencies, where single precision coefficients
+ *        would make it go out of tune or become unstable.
+ */
+class BiquadFilterCoefficientWrapper
+{
+    public:
+        explicit BiquadFilterCoefficientWrapper(Number const value) noexcept;
+
+        JS80P_INLINE Number operator[](Integer const index) const noexcept;
+
+    private:
+        Number const value;
+};
+
+
+class BiquadFilterCoefficientBufferWrapper
+{
+    public:
+        explicit BiquadFilterCoefficientBufferWrapper(
+            Number const* const buffer
+        ) noexcept;
+
+        JS80P_INLINE Number operator[](Integer const index) const noexcept;
+
+    private:
+        Number const* const buffer;
+};
+
+
 class BiquadFilterSharedBuffers
 {
     public:
         BiquadFilterSharedBuffers();
 
         Integer round;
-        Sample* b0_buffer;
-        Sample* b1_buffer;
-        Sample* b2_buffer;
-        Sample* a1_buffer;
-        Sample* a2_buffer;
+        Number* b0_buffer;
+        Number* b1_buffer;
+        Number* b2_buffer;
+        Number* a1_buffer;
+        Number* a2_buffer;
         bool are_coefficients_constant:1;
         bool is_silent:1;
         bool is_no_op:1;
@@ -175,6 +208,18 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
             Number const random_2
         ) noexcept;
 
+        /**
+         * \brief Switch to a different set of shared buffers, e.g. in order to
+         *        let filters that are rendered on different threads use
+         *        separate sets.
+         *
+         * \warning Only allowed for filters which were created with shared
+         *          buffers.
+         */
+        void set_shared_buffers(
+            BiquadFilterSharedBuffers* const shared_buffers
+        ) noexcept;
+
         FloatParamS frequency;
         FloatParamS q;
         FloatParamS gain;
@@ -331,12 +376,12 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
 
         void store_normalized_coefficient_samples(
             Integer const index,
-            Sample const b0,
-            Sample const b1,
-            Sample const b2,
-            Sample const a0,
-            Sample const a1,
-            Sample const a2
+            Number const b0,
+            Number const b1,
+            Number const b2,
+            Number const a0,
+            Number const a1,
+            Number const a2
         ) const noexcept;
 
         void store_no_op_coefficient_samples(
@@ -364,25 +409,25 @@ class BiquadFilter : public Filter<InputSignalProducerClass>
         FloatParamB const* const freq_inaccuracy_param;
         FloatParamB const* const q_inaccuracy_param;
 
-        BiquadFilterSharedBuffers* const shared_buffers;
+        BiquadFilterSharedBuffers* shared_buffers;
 
         /*
         Notation:
            https://www.w3.org/TR/webaudio/#filters-characteristics
            https://www.w3.org/TR/2021/NOTE-audio-eq-cookbook-20210608/
          */
-        Sample* b0_buffer;
-        Sample* b1_buffer;
-        Sample* b2_buffer;
-        Sample* a1_buffer;
-        Sample* a2_buffer;
-
-        Sample* x_n_m1;
-        Sample* x_n_m2;
-        Sample* y_n_m1;
-        Sample* y_n_m2;
-
-        Sample w0_scale;
+        Number* b0_buffer;
+        Number* b1_buffer;
+        Number* b2_buffer;
+        Number* a1_buffer;
+        Number* a2_buffer;
+
+        Number* x_n_m1;
+        Number* x_n_m2;
+        Number* y_n_m1;
+        Number* y_n_m2;
+
+        Number w0_scale;
 
         Number low_pass_no_op_frequency;
         Number freq_inaccuracy;
@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__CHORUS_CPP
 #define JS80P__DSP__CHORUS_CPP
 
+#include <algorithm>
+
 #include "dsp/chorus.hpp"
 
 #include "dsp/math.hpp"
@@ -44,7 +46,9 @@ template<class InputSignalProducerClass>
 Chorus<InputSignalProducerClass>::Chorus(
         std::string const& name,
         InputSignalProducerClass& input
-) : Effect<InputSignalProducerClass>(name, input, 19 + VOICES * 3, &mixer),
+) : Effect<InputSignalProducerClass>(
+        name, input, 19 + VOICES * 2, &comb_filters
+    ),
     type(name + "TYP"),
     delay_time(
         name + "DEL",
@@ -133,7 +137,7 @@ Chorus<InputSignalProducerClass>::Chorus(
     ),
     high_pass_filter(
         input,
-        CombFilter::CHANNELS,
+        CombFilters::CHANNELS,
         high_pass_frequency,
         high_pass_q,
         high_pass_filter_gain
@@ -156,61 +160,10 @@ Chorus<InputSignalProducerClass>::Chorus(
         FloatParamS(name + "DEL6", 0.0, DELAY_TIME_MAX, DELAY_TIME_DEFAULT),
         FloatParamS(name + "DEL7", 0.0, DELAY_TIME_MAX, DELAY_TIME_DEFAULT),
     },
-    comb_filters{
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[0],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[1],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[2],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[3],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[4],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[5],
-            &tempo_sync
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            delay_times[6],
-            &tempo_sync
-        },
-    },
-    mixer(CombFilter::CHANNELS),
+    comb_filters(high_pass_filter, width, delay_times, &tempo_sync),
     high_shelf_filter(
-        mixer,
-        CombFilter::CHANNELS,
+        comb_filters,
+        CombFilters::CHANNELS,
         damping_frequency,
         biquad_filter_q,
         damping_gain,
@@ -218,9 +171,9 @@ Chorus<InputSignalProducerClass>::Chorus(
         0.0,
         NULL,
         NULL,
-        &mixer
+        &comb_filters
     ),
-    feedback_gain(high_shelf_filter, feedback, NULL, CombFilter::CHANNELS),
+    feedback_gain(high_shelf_filter, feedback, NULL, CombFilters::CHANNELS),
     previous_type(255),
     should_start_lfos(true)
 {
@@ -243,32 +196,32 @@ Chorus<InputSignalProducerClass>::Chorus(
     this->register_child(high_pass_filter_gain);
     this->register_child(high_pass_filter);
 
-    this->register_child(mixer);
+    this->register_child(comb_filters);
 
     this->register_child(high_shelf_filter);
 
     this->register_child(feedback_gain);
 
+    comb_filters.set_feedback_signal_producer(feedback_gain);
+
     for (size_t i = 0; i != VOICES; ++i) {
         lfos[i].center.set_value(ToggleParam::ON);
         delay_times[i].set_lfo(&lfos[i]);
-        comb_filters[i].delay.set_feedback_signal_producer(feedback_gain);
-
-        if (i > 0) {
-            comb_filters[i].delay.use_shared_delay_buffer(
-                comb_filters[0].delay
-            );
-        }
-
-        mixer.add(comb_filters[i]);
 
         this->register_child(lfos[i]);
         this->register_child(delay_times[i]);
-        this->register_child(comb_filters[i]);
     }
 }
 
 
+template<class InputSignalProducerClass>
+void Chorus<InputSignalProducerClass>::use_delay_buffer_arena(
+        DelayBufferArena& arena
+) noexcept {
+    comb_filters.use_delay_buffer_arena(arena);
+}
+
+
 template<class InputSignalProducerClass>
 void Chorus<InputSignalProducerClass>::start_lfos(
         Seconds const time_offset
@@ -316,6 +269,21 @@ Sample const* const* Chorus<InputSignalProducerClass>::initialize_rendering(
     );
 
     if (buffer != NULL) {
+        /*
+        The delay times are controlled by the LFOs of the effect, which nobody
+        else renders, and an LFO which is not rendered doesn't advance its
+        phase, so these need to keep running while the effect is asleep in
+        order to let it wake up at the same point of the modulation where an
+        effect which has never slept would be.
+        */
+        if (this->is_sleeping) {
+            for (size_t i = 0; i != VOICES; ++i) {
+                FloatParamS::produce<FloatParamS>(
+                    delay_times[i], round, sample_count
+                );
+            }
+        }
+
         return buffer;
     }
 
@@ -336,26 +304,53 @@ Sample const* const* Chorus<InputSignalProducerClass>::initialize_rendering(
 }
 
 
+template<class InputSignalProducerClass>
+Seconds Chorus<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    Tuning const* const tunings = TUNINGS[type.get_value()];
+    Number weights = 0.0;
+
+    for (size_t i = 0; i != VOICES; ++i) {
+        weights += tunings[i].weight;
+    }
+
+    /* See DELAY_TIME_MAX. */
+    Seconds delay_time = this->delay_time.get_value() * 2.0;
+
+    if (tempo_sync.get_value() == ToggleParam::ON) {
+        delay_time *= (
+            Math::SECONDS_IN_ONE_MINUTE
+            / std::max(CombFilters::BPM_MIN, this->bpm)
+        );
+    }
+
+    /*
+    All voices are fed back together, so in the worst case, their amplitudes
+    add up in the feedback.
+    */
+    return this->calculate_feedback_tail_length(
+        delay_time, feedback.get_value() * weights
+    );
+}
+
+
 template<class InputSignalProducerClass>
 void Chorus<InputSignalProducerClass>::update_tunings(Byte const type) noexcept
 {
     Tuning const* const tunings = TUNINGS[type];
 
-    mixer.reset();
+    comb_filters.reset();
 
     for (size_t i = 0; i != VOICES; ++i) {
         Tuning const& tuning = tunings[i];
-
-        CombFilter& comb_filter = comb_filters[i];
         LFO& lfo = lfos[i];
 
-        comb_filter.reset();
-        comb_filter.set_panning_scale(tuning.panning_scale);
-
         lfo.reset();
         lfo.phase.set_value(tuning.lfo_phase);
 
-        mixer.set_weight(i, tuning.weight);
+        comb_filters.set_tap(
+            (Integer)i, tuning.panning_scale, tuning.weight
+        );
     }
 
     if (should_start_lfos) {
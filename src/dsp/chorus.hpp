@@ -25,11 +25,10 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.hpp"
-#include "dsp/delay.hpp"
 #include "dsp/effect.hpp"
 #include "dsp/gain.hpp"
 #include "dsp/lfo.hpp"
-#include "dsp/mixer.hpp"
+#include "dsp/multi_tap_delay.hpp"
 #include "dsp/param.hpp"
 #include "dsp/signal_producer.hpp"
 
@@ -64,10 +63,14 @@ class Chorus : public Effect<InputSignalProducerClass>
             BiquadFilterFixedType::BFFT_HIGH_PASS
         > HighPassedInput;
 
-        typedef StereoPannedDelay<HighPassedInput> CombFilter;
+        /*
+        The voices are the taps of a single delay line, so that the input and
+        the feedback need to be written only once.
+        */
+        typedef MultiTapDelay<HighPassedInput, 7> CombFilters;
 
         typedef BiquadFilter<
-            Mixer<CombFilter>,
+            CombFilters,
             BiquadFilterFixedType::BFFT_HIGH_SHELF
         > HighShelfFilter;
 
@@ -88,6 +91,11 @@ class Chorus : public Effect<InputSignalProducerClass>
 
         Chorus(std::string const& name, InputSignalProducerClass& input);
 
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena()
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
         void start_lfos(Seconds const time_offset) noexcept;
         void stop_lfos(Seconds const time_offset) noexcept;
 
@@ -126,6 +134,8 @@ class Chorus : public Effect<InputSignalProducerClass>
             Sample** const buffer
         ) noexcept JS80P_OVERRIDE;
 
+        virtual Seconds get_tail_length() const noexcept override;
+
     private:
         class Tuning
         {
@@ -162,7 +172,7 @@ class Chorus : public Effect<InputSignalProducerClass>
             Constants::CHORUS_DELAY_TIME_DEFAULT * 2.0
         );
 
-        static constexpr size_t VOICES = 7;
+        static constexpr size_t VOICES = CombFilters::TAPS;
 
         static constexpr Tuning TUNINGS[][VOICES] = {
             /* CHORUS_1 */
@@ -338,8 +348,7 @@ class Chorus : public Effect<InputSignalProducerClass>
         HighPassedInput high_pass_filter;
         LFO lfos[VOICES];
         FloatParamS delay_times[VOICES];
-        CombFilter comb_filters[VOICES];
-        Mixer<CombFilter> mixer;
+        CombFilters comb_filters;
         HighShelfFilter high_shelf_filter;
         Feedback feedback_gain;
         Sample const* const* chorused;
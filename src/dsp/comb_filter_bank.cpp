@@ -0,0 +1,1189 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__COMB_FILTER_BANK_CPP
+#define JS80P__DSP__COMB_FILTER_BANK_CPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/comb_filter_bank.hpp"
+
+
+namespace JS80P
+{
+
+template<class InputSignalProducerClass, Integer lanes>
+CombFilterBank<InputSignalProducerClass, lanes>::CombFilterBank(
+        InputSignalProducerClass& input,
+        FloatParamS& panning,
+        FloatParamS& gain,
+        FloatParamS& time_scale,
+        Seconds const time_max,
+        BiquadFilterSharedBuffers& high_shelf_filter_shared_buffers,
+        FloatParamS& high_shelf_filter_frequency,
+        FloatParamS& high_shelf_filter_gain,
+        FloatParamS& distortion_level
+) noexcept
+    : Filter<InputSignalProducerClass>(input, 0, CHANNELS),
+    panning(panning),
+    gain(gain),
+    time_scale(time_scale),
+    high_shelf_filter_frequency(high_shelf_filter_frequency),
+    high_shelf_filter_gain(high_shelf_filter_gain),
+    distortion_level(distortion_level),
+    high_shelf_filter_shared_buffers(high_shelf_filter_shared_buffers),
+    time_max(time_max),
+    delay_buffer_arena_region(NULL),
+    delay_buffer(NULL),
+    feedback_buffer(NULL),
+    gain_buffer(NULL),
+    time_scale_buffer(NULL),
+    panning_buffer(NULL),
+    distortion_level_buffer(NULL),
+    w0_scale(0.0),
+    high_shelf_no_op_frequency(0.0),
+    gain_value(0.0),
+    time_scale_value(0.0),
+    distortion_level_value(0.0),
+    read_index(0.0),
+    delay_buffer_size_float(0.0),
+    delay_buffer_size(0),
+    write_index_input(0),
+    write_index_feedback(0),
+    clear_index(0),
+    silent_input_samples(0),
+    feedback_sample_count(0),
+    rendered_lanes(0),
+    is_starting(true),
+    are_coefficients_constant(true)
+{
+    static_assert(lanes > 0, "A comb filter bank needs at least one lane");
+
+    Distortion::tables.load();
+
+    for (Integer l = 0; l != lanes; ++l) {
+        delay_time[l] = 0.0;
+        panning_scale[l] = 1.0;
+        weight[l] = 0.0;
+        time_in_samples[l] = 0.0;
+    }
+
+    w0_scale = Math::PI_DOUBLE * (Number)this->sampling_period;
+    high_shelf_no_op_frequency = std::min(
+        (Number)this->nyquist_frequency,
+        high_shelf_filter_frequency.get_max_value()
+    );
+
+    allocate_feedback_buffer();
+    reallocate_delay_buffer_if_needed();
+    reset();
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+CombFilterBank<InputSignalProducerClass, lanes>::~CombFilterBank()
+{
+    free_delay_buffer();
+    free_feedback_buffer();
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::set_sample_rate(
+        Frequency const new_sample_rate
+) noexcept {
+    Filter<InputSignalProducerClass>::set_sample_rate(new_sample_rate);
+
+    w0_scale = Math::PI_DOUBLE * (Number)this->sampling_period;
+    high_shelf_no_op_frequency = std::min(
+        (Number)this->nyquist_frequency,
+        high_shelf_filter_frequency.get_max_value()
+    );
+
+    reallocate_delay_buffer_if_needed();
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    if (new_block_size == this->block_size) {
+        return;
+    }
+
+    Filter<InputSignalProducerClass>::set_block_size(new_block_size);
+
+    free_feedback_buffer();
+    allocate_feedback_buffer();
+    reallocate_delay_buffer_if_needed();
+    reset();
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::reset() noexcept
+{
+    Filter<InputSignalProducerClass>::reset();
+
+    Integer const delay_buffer_samples = delay_buffer_size * lanes;
+    Integer const feedback_buffer_samples = this->block_size * lanes;
+
+    bool const is_delay_buffer_in_arena = (
+        delay_buffer_arena_region != NULL
+        && delay_buffer == delay_buffer_arena_region->buffer
+    );
+
+    if (is_delay_buffer_in_arena) {
+        delay_buffer_arena_region->clear();
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        if (delay_buffer != NULL && !is_delay_buffer_in_arena) {
+            std::fill_n(delay_buffer[c], delay_buffer_samples, 0.0);
+        }
+
+        std::fill_n(feedback_buffer[c], feedback_buffer_samples, 0.0);
+    }
+
+    write_index_input = 0;
+    write_index_feedback = 0;
+    clear_index = this->block_size;
+    silent_input_samples = delay_buffer_size;
+    feedback_sample_count = 0;
+    is_starting = true;
+
+    Sample f_of_zero;
+    Sample F0_of_zero;
+
+    look_up_distortion(
+        &(Distortion::tables.get_f_table(DISTORTION_TYPE)[0]),
+        &(Distortion::tables.get_F0_table(DISTORTION_TYPE)[0]),
+        0.0,
+        f_of_zero,
+        F0_of_zero
+    );
+
+    for (Integer l = 0; l != lanes; ++l) {
+        reset_lane_state(l);
+
+        silent_feedback_samples[l] = delay_buffer_size;
+        feedback_peak[l] = 0.0;
+        is_lane_rendered[l] = false;
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            distortion_previous_input[c][l] = 0.0;
+            distortion_F0_previous_input[c][l] = F0_of_zero;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::set_lane(
+        Integer const lane,
+        Seconds const delay_time,
+        Number const panning_scale,
+        Number const weight
+) noexcept {
+    JS80P_ASSERT(0 <= lane && lane < lanes);
+
+    this->delay_time[lane] = std::max(0.0, std::min(time_max, delay_time));
+    this->panning_scale[lane] = panning_scale;
+    this->weight[lane] = weight;
+
+    rendered_lanes = 0;
+
+    for (Integer l = 0; l != lanes; ++l) {
+        if (this->weight[l] > SILENCE_WEIGHT) {
+            rendered_lanes = l + 1;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::use_delay_buffer_arena(
+        DelayBufferArena& arena
+) noexcept {
+    if (delay_buffer_arena_region != NULL) {
+        return;
+    }
+
+    delay_buffer_arena_region = arena.reserve(
+        CHANNELS,
+        calculate_delay_buffer_size(
+            DelayBufferArena::SAMPLE_RATE_MAX, DelayBufferArena::BLOCK_SIZE_MAX
+        ) * lanes
+    );
+
+    if (delay_buffer_size * lanes <= delay_buffer_arena_region->capacity) {
+        /* See Delay::use_delay_buffer_arena() */
+        free_delay_buffer();
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size * lanes);
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+Integer CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::calculate_delay_buffer_size(
+        Frequency const sample_rate,
+        Integer const block_size
+) const noexcept {
+    return block_size * 2 + std::max(
+        (Integer)(sample_rate * time_max) + 1, block_size
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::reallocate_delay_buffer_if_needed() noexcept {
+    Integer const new_delay_buffer_size = calculate_delay_buffer_size(
+        this->sample_rate, this->block_size
+    );
+
+    if (new_delay_buffer_size != delay_buffer_size) {
+        free_delay_buffer();
+        delay_buffer_size = new_delay_buffer_size;
+        delay_buffer_size_float = (Number)delay_buffer_size;
+        allocate_delay_buffer();
+        reset();
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::allocate_delay_buffer(
+) noexcept {
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer_size * lanes <= delay_buffer_arena_region->capacity
+    ) {
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size * lanes);
+
+        return;
+    }
+
+    delay_buffer = new Sample*[CHANNELS];
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        delay_buffer[c] = new Sample[delay_buffer_size * lanes];
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::free_delay_buffer(
+) noexcept {
+    if (delay_buffer == NULL) {
+        return;
+    }
+
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer = NULL;
+
+        return;
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        delete[] delay_buffer[c];
+
+        delay_buffer[c] = NULL;
+    }
+
+    delete[] delay_buffer;
+
+    delay_buffer = NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::allocate_feedback_buffer() noexcept {
+    feedback_buffer = new Sample*[CHANNELS];
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        feedback_buffer[c] = new Sample[this->block_size * lanes];
+
+        std::fill_n(feedback_buffer[c], this->block_size * lanes, 0.0);
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::free_feedback_buffer() noexcept {
+    if (feedback_buffer == NULL) {
+        return;
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        delete[] feedback_buffer[c];
+
+        feedback_buffer[c] = NULL;
+    }
+
+    delete[] feedback_buffer;
+
+    feedback_buffer = NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::reset_lane_state(
+        Integer const lane
+) noexcept {
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        x_n_m1[c][lane] = 0.0;
+        x_n_m2[c][lane] = 0.0;
+        y_n_m1[c][lane] = 0.0;
+        y_n_m2[c][lane] = 0.0;
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+Sample const* const* CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::initialize_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    JS80P_ASSERT(this->input.get_channels() == CHANNELS);
+
+    Filter<InputSignalProducerClass>::initialize_rendering(round, sample_count);
+
+    read_index = (Number)write_index_input;
+
+    clear_delay_buffer(sample_count);
+    mix_feedback_into_delay_buffer(sample_count);
+    mix_input_into_delay_buffer(round, sample_count);
+
+    feedback_sample_count = sample_count;
+
+    gain_buffer = FloatParamS::produce_if_not_constant(
+        gain, round, sample_count
+    );
+    time_scale_buffer = FloatParamS::produce_if_not_constant(
+        time_scale, round, sample_count
+    );
+    distortion_level_buffer = FloatParamS::produce_if_not_constant(
+        distortion_level, round, sample_count
+    );
+
+    initialize_high_shelf_filter(round, sample_count);
+    initialize_panning(round, sample_count);
+
+    bool const is_input_silent = silent_input_samples >= delay_buffer_size;
+    bool is_any_lane_rendered = false;
+
+    for (Integer l = 0; l != lanes; ++l) {
+        feedback_peak[l] = 0.0;
+        is_lane_rendered[l] = (
+            weight[l] > SILENCE_WEIGHT
+            && !(
+                is_input_silent
+                && silent_feedback_samples[l] >= delay_buffer_size
+            )
+        );
+
+        if (is_lane_rendered[l]) {
+            is_any_lane_rendered = true;
+        } else {
+            reset_lane_state(l);
+        }
+    }
+
+    if (!is_any_lane_rendered) {
+        /*
+        The buffer may be shared with an owner which renders into it, so it
+        cannot be assumed to stay silent between rounds.
+        */
+        this->render_silence(round, 0, sample_count, this->buffer);
+        this->mark_round_as_silent(round);
+
+        return this->buffer;
+    }
+
+    gain_value = gain.get_value();
+    distortion_level_value = distortion_level.get_value();
+
+    if (time_scale_buffer == NULL) {
+        time_scale_value = this->sample_rate * time_scale.get_value();
+    } else {
+        time_scale_value = this->sample_rate;
+    }
+
+    for (Integer l = 0; l != lanes; ++l) {
+        time_in_samples[l] = delay_time[l] * time_scale_value;
+    }
+
+    return NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::clear_delay_buffer(
+        Integer const sample_count
+) noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer index = clear_index;
+
+    for (Integer i = 0; i != sample_count;) {
+        Integer const batch_size = std::min(
+            sample_count - i, delay_buffer_size - index
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            std::fill_n(
+                delay_buffer[c] + index * lanes, batch_size * lanes, 0.0
+            );
+        }
+
+        i += batch_size;
+        index += batch_size;
+
+        if (JS80P_UNLIKELY(index == delay_buffer_size)) {
+            index = 0;
+        }
+    }
+
+    clear_index = index;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::mix_feedback_into_delay_buffer(
+        Integer const sample_count
+) noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+
+    if (JS80P_UNLIKELY(is_starting)) {
+        is_starting = false;
+        write_index_feedback = (write_index_feedback + sample_count)
+            % delay_buffer_size;
+
+        for (Integer l = 0; l != lanes; ++l) {
+            if (silent_feedback_samples[l] < delay_buffer_size) {
+                silent_feedback_samples[l] += sample_count;
+            }
+        }
+
+        return;
+    }
+
+    Integer const feedback_sample_count = this->feedback_sample_count;
+    Sample feedback_mask[lanes];
+    bool has_feedback = false;
+
+    for (Integer l = 0; l != lanes; ++l) {
+        if (
+                !is_lane_rendered[l]
+                || feedback_peak[l] < SignalProducer::SILENCE_THRESHOLD
+        ) {
+            feedback_mask[l] = 0.0;
+
+            if (silent_feedback_samples[l] < delay_buffer_size) {
+                silent_feedback_samples[l] += feedback_sample_count;
+            }
+        } else {
+            feedback_mask[l] = 1.0;
+            silent_feedback_samples[l] = 0;
+            has_feedback = true;
+        }
+    }
+
+    Integer index = write_index_feedback;
+
+    if (has_feedback) {
+        for (Integer i = 0; i != feedback_sample_count;) {
+            Integer const batch_size = std::min(
+                feedback_sample_count - i, delay_buffer_size - index
+            );
+
+            for (Integer c = 0; c != CHANNELS; ++c) {
+                Sample* const delay_channel = delay_buffer[c] + index * lanes;
+                Sample const* const feedback_channel = (
+                    feedback_buffer[c] + i * lanes
+                );
+
+                for (Integer j = 0; j != batch_size * lanes; ++j) {
+                    delay_channel[j] += (
+                        feedback_mask[j % lanes] * feedback_channel[j]
+                    );
+                }
+            }
+
+            i += batch_size;
+            index += batch_size;
+
+            if (JS80P_UNLIKELY(index == delay_buffer_size)) {
+                index = 0;
+            }
+        }
+    } else {
+        index = (index + feedback_sample_count) % delay_buffer_size;
+    }
+
+    write_index_feedback = index;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::mix_input_into_delay_buffer(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+
+    if (this->input.is_silent(round, sample_count)) {
+        write_index_input = (write_index_input + sample_count)
+            % delay_buffer_size;
+
+        if (silent_input_samples < delay_buffer_size) {
+            silent_input_samples += sample_count;
+        }
+
+        return;
+    }
+
+    silent_input_samples = 0;
+
+    Integer index = write_index_input;
+
+    for (Integer i = 0; i != sample_count;) {
+        Integer const batch_size = std::min(
+            sample_count - i, delay_buffer_size - index
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            Sample* const delay_channel = delay_buffer[c] + index * lanes;
+            Sample const* const input_channel = this->input_buffer[c] + i;
+
+            for (Integer j = 0; j != batch_size; ++j) {
+                Sample const input_sample = input_channel[j];
+                Sample* const delay_frame = delay_channel + j * lanes;
+
+                for (Integer l = 0; l != lanes; ++l) {
+                    delay_frame[l] += input_sample;
+                }
+            }
+        }
+
+        i += batch_size;
+        index += batch_size;
+
+        if (JS80P_UNLIKELY(index == delay_buffer_size)) {
+            index = 0;
+        }
+    }
+
+    write_index_input = index;
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::initialize_high_shelf_filter(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /*
+    The coefficients are not cached across filters like BiquadFilter does, so
+    other users of the buffers must not mistake them for their own.
+    */
+    high_shelf_filter_shared_buffers.round = -1;
+
+    are_coefficients_constant = (
+        high_shelf_filter_frequency.is_constant_in_next_round(
+            round, sample_count
+        )
+        && high_shelf_filter_gain.is_constant_in_next_round(round, sample_count)
+    );
+
+    if (are_coefficients_constant) {
+        high_shelf_filter_frequency.skip_round(round, sample_count);
+        high_shelf_filter_gain.skip_round(round, sample_count);
+
+        store_high_shelf_coefficient_samples(
+            0,
+            high_shelf_filter_frequency.get_value(),
+            high_shelf_filter_gain.get_value()
+        );
+
+        return;
+    }
+
+    Sample const* const frequency_buffer = (
+        FloatParamS::produce<FloatParamS>(
+            high_shelf_filter_frequency, round, sample_count
+        )[0]
+    );
+    Sample const* const gain_buffer = (
+        FloatParamS::produce<FloatParamS>(
+            high_shelf_filter_gain, round, sample_count
+        )[0]
+    );
+
+    for (Integer i = 0; i != sample_count; ++i) {
+        store_high_shelf_coefficient_samples(
+            i, frequency_buffer[i], gain_buffer[i]
+        );
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<
+        InputSignalProducerClass,
+        lanes
+>::store_high_shelf_coefficient_samples(
+        Integer const index,
+        Number const frequency_value,
+        Number const gain_value
+) const noexcept {
+    BiquadFilterSharedBuffers& buffers = high_shelf_filter_shared_buffers;
+
+    if (frequency_value >= high_shelf_no_op_frequency) {
+        buffers.b0_buffer[index] = 1.0;
+        buffers.b1_buffer[index] =
+            buffers.b2_buffer[index] =
+            buffers.a1_buffer[index] =
+            buffers.a2_buffer[index] = 0.0;
+
+        return;
+    }
+
+    Number const a = Math::pow_10(
+        gain_value * Constants::BIQUAD_FILTER_GAIN_SCALE
+    );
+    Number const a_p_1 = a + 1.0;
+    Number const a_m_1 = a - 1.0;
+    Number const a_sqrt = Math::pow_10(gain_value * HIGH_SHELF_GAIN_SCALE_HALF);
+    Number const w0 = w0_scale * frequency_value;
+
+    Number sin_w0;
+    Number cos_w0;
+
+    Math::sincos(w0, sin_w0, cos_w0);
+
+    Number const a_m_1_cos_w0 = a_m_1 * cos_w0;
+    Number const a_p_1_cos_w0 = a_p_1 * cos_w0;
+    Number const alpha_s_double_a_sqrt = (
+        sin_w0 * HIGH_SHELF_FREQUENCY_SINE_SCALE * a_sqrt
+    );
+
+    /* See BiquadFilter::store_high_shelf_coefficient_samples() */
+    Number const a0_inv = 1.0 / (a_p_1 - a_m_1_cos_w0 + alpha_s_double_a_sqrt);
+
+    buffers.b0_buffer[index] = (
+        a * (a_p_1 + a_m_1_cos_w0 + alpha_s_double_a_sqrt) * a0_inv
+    );
+    buffers.b1_buffer[index] = -2.0 * a * (a_m_1 + a_p_1_cos_w0) * a0_inv;
+    buffers.b2_buffer[index] = (
+        a * (a_p_1 + a_m_1_cos_w0 - alpha_s_double_a_sqrt) * a0_inv
+    );
+    buffers.a1_buffer[index] = -2.0 * (a_m_1 - a_p_1_cos_w0) * a0_inv;
+    buffers.a2_buffer[index] = (
+        (a_m_1_cos_w0 + alpha_s_double_a_sqrt - a_p_1) * a0_inv
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::initialize_panning(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    panning_buffer = FloatParamS::produce_if_not_constant(
+        panning, round, sample_count
+    );
+
+    if (panning_buffer != NULL) {
+        return;
+    }
+
+    Number const panning_value = panning.get_value();
+
+    for (Integer l = 0; l != lanes; ++l) {
+        calculate_panning_matrix(
+            l, panning_value * panning_scale[l], panning_matrix
+        );
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::calculate_panning_matrix(
+        Integer const lane,
+        Number const panning_value,
+        Sample matrix[4][lanes]
+) const noexcept {
+    /* https://www.w3.org/TR/webaudio/#stereopanner-algorithm */
+    Number const x = (
+        (panning_value <= 0.0 ? panning_value + 1.0 : panning_value)
+        * Math::PI_HALF
+    );
+    Number const weight = this->weight[lane];
+
+    Number sin_x;
+    Number cos_x;
+
+    Math::sincos(x, sin_x, cos_x);
+
+    if (panning_value > 0.0) {
+        matrix[0][lane] = weight * cos_x;
+        matrix[1][lane] = 0.0;
+        matrix[2][lane] = weight * sin_x;
+        matrix[3][lane] = weight;
+    } else {
+        matrix[0][lane] = weight;
+        matrix[1][lane] = weight * cos_x;
+        matrix[2][lane] = 0.0;
+        matrix[3][lane] = weight * sin_x;
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::render(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample** const buffer
+) noexcept {
+    bool const need_distortion = (
+        distortion_level_buffer != NULL || distortion_level_value >= 0.000001
+    );
+
+    if (panning_buffer == NULL) {
+        if (need_distortion) {
+            render<true, true>(first_sample_index, end_sample_index, buffer);
+        } else {
+            render<true, false>(first_sample_index, end_sample_index, buffer);
+        }
+    } else {
+        if (need_distortion) {
+            render<false, true>(first_sample_index, end_sample_index, buffer);
+        } else {
+            render<false, false>(first_sample_index, end_sample_index, buffer);
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+template<bool is_panning_constant, bool need_distortion>
+void CombFilterBank<InputSignalProducerClass, lanes>::render(
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample** const buffer
+) noexcept {
+    Sample const* const* const delay_buffer = this->delay_buffer;
+    Sample* const* const feedback_buffer = this->feedback_buffer;
+    Sample const* const gain_buffer = this->gain_buffer;
+    Sample const* const time_scale_buffer = this->time_scale_buffer;
+    Sample const* const panning_buffer = this->panning_buffer;
+    Sample const* const distortion_level_buffer = this->distortion_level_buffer;
+    Number const* const b0 = high_shelf_filter_shared_buffers.b0_buffer;
+    Number const* const b1 = high_shelf_filter_shared_buffers.b1_buffer;
+    Number const* const b2 = high_shelf_filter_shared_buffers.b2_buffer;
+    Number const* const a1 = high_shelf_filter_shared_buffers.a1_buffer;
+    Number const* const a2 = high_shelf_filter_shared_buffers.a2_buffer;
+    Number const* const f_table = &(
+        Distortion::tables.get_f_table(DISTORTION_TYPE)[0]
+    );
+    Number const* const F0_table = &(
+        Distortion::tables.get_F0_table(DISTORTION_TYPE)[0]
+    );
+    Number const gain_value = this->gain_value;
+    Number const distortion_level_value = this->distortion_level_value;
+    Number const read_index = this->read_index;
+    Number const delay_buffer_size_float = this->delay_buffer_size_float;
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer const rendered_lanes = this->rendered_lanes;
+    Integer const coefficient_index_mask = are_coefficients_constant ? 0 : -1;
+
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            Sample* const out_left = buffer[0];
+            Sample* const out_right = buffer[1];
+
+            /*
+            First, the delayed samples of each lane are collected into the
+            feedback buffer, which has the same interleaved layout as the delay
+            buffer, so that the rest of the signal chain can work on all lanes
+            at once. The shelving filter's output overwrites them, and that
+            will become the feedback in the next round.
+            */
+            for (Integer c = 0; c != CHANNELS; ++c) {
+                Sample* const x = feedback_buffer[c];
+
+                for (
+                        Integer i = first_sample_index * lanes;
+                        i != end_sample_index * lanes;
+                        ++i
+                ) {
+                    x[i] = 0.0;
+                }
+            }
+
+            for (Integer l = 0; l != rendered_lanes; ++l) {
+                if (!is_lane_rendered[l]) {
+                    continue;
+                }
+
+                Sample const* const delay_left = delay_buffer[0] + l;
+                Sample const* const delay_right = delay_buffer[1] + l;
+                Sample* const x_left = feedback_buffer[0] + l;
+                Sample* const x_right = feedback_buffer[1] + l;
+
+                if (time_scale_buffer == NULL) {
+                    /*
+                    The read position advances one sample at a time, so the
+                    interpolation weight stays the same for the whole block.
+                    */
+                    Number position = (
+                        read_index
+                        + (Number)first_sample_index
+                        - time_in_samples[l]
+                    );
+
+                    if (position < 0.0) {
+                        position += delay_buffer_size_float;
+                    }
+
+                    Number const position_floor = std::floor(position);
+                    Sample const after_weight = position - position_floor;
+                    Integer before = (Integer)position_floor;
+
+                    if (before >= delay_buffer_size) {
+                        before -= delay_buffer_size;
+                    }
+
+                    for (
+                            Integer i = first_sample_index;
+                            i != end_sample_index;
+                            ++i
+                    ) {
+                        Integer const after = (
+                            before + 1 == delay_buffer_size ? 0 : before + 1
+                        );
+                        Integer const before_index = before * lanes;
+                        Integer const after_index = after * lanes;
+                        Integer const x_index = i * lanes;
+                        Number const gain_sample = (
+                            gain_buffer == NULL ? gain_value : gain_buffer[i]
+                        );
+
+                        x_left[x_index] = gain_sample * Math::combine(
+                            after_weight,
+                            delay_left[after_index],
+                            delay_left[before_index]
+                        );
+                        x_right[x_index] = gain_sample * Math::combine(
+                            after_weight,
+                            delay_right[after_index],
+                            delay_right[before_index]
+                        );
+
+                        before = after;
+                    }
+                } else {
+                    Number const time_in_samples = this->time_in_samples[l];
+
+                    for (
+                            Integer i = first_sample_index;
+                            i != end_sample_index;
+                            ++i
+                    ) {
+                        Number position = (
+                            read_index
+                            + (Number)i
+                            - time_in_samples * time_scale_buffer[i]
+                        );
+
+                        if (position < 0.0) {
+                            position += delay_buffer_size_float;
+                        }
+
+                        Number const position_floor = std::floor(position);
+                        Sample const after_weight = position - position_floor;
+                        Integer before = (Integer)position_floor;
+
+                        if (before >= delay_buffer_size) {
+                            before -= delay_buffer_size;
+                        }
+
+                        Integer const after = (
+                            before + 1 == delay_buffer_size ? 0 : before + 1
+                        );
+                        Integer const before_index = before * lanes;
+                        Integer const after_index = after * lanes;
+                        Integer const x_index = i * lanes;
+                        Number const gain_sample = (
+                            gain_buffer == NULL ? gain_value : gain_buffer[i]
+                        );
+
+                        x_left[x_index] = gain_sample * Math::combine(
+                            after_weight,
+                            delay_left[after_index],
+                            delay_left[before_index]
+                        );
+                        x_right[x_index] = gain_sample * Math::combine(
+                            after_weight,
+                            delay_right[after_index],
+                            delay_right[before_index]
+                        );
+                    }
+                }
+            }
+
+            Sample* const feedback_left = feedback_buffer[0];
+            Sample* const feedback_right = feedback_buffer[1];
+
+            Sample matrix[4][lanes];
+            Sample previous_input[CHANNELS][lanes];
+            Sample F0_previous_input[CHANNELS][lanes];
+            Number x_n_m1[CHANNELS][lanes];
+            Number x_n_m2[CHANNELS][lanes];
+            Number y_n_m1[CHANNELS][lanes];
+            Number y_n_m2[CHANNELS][lanes];
+            Sample peak[lanes];
+
+            for (Integer l = 0; l != lanes; ++l) {
+                for (Integer k = 0; k != 4; ++k) {
+                    matrix[k][l] = (
+                        is_panning_constant ? panning_matrix[k][l] : 0.0
+                    );
+                }
+
+                for (Integer c = 0; c != CHANNELS; ++c) {
+                    previous_input[c][l] = distortion_previous_input[c][l];
+                    F0_previous_input[c][l] = (
+                        distortion_F0_previous_input[c][l]
+                    );
+                    x_n_m1[c][l] = this->x_n_m1[c][l];
+                    x_n_m2[c][l] = this->x_n_m2[c][l];
+                    y_n_m1[c][l] = this->y_n_m1[c][l];
+                    y_n_m2[c][l] = this->y_n_m2[c][l];
+                }
+
+                peak[l] = feedback_peak[l];
+            }
+
+            for (Integer i = first_sample_index; i != end_sample_index; ++i) {
+                Integer const ci = i & coefficient_index_mask;
+                Sample* const x[CHANNELS] = {
+                    feedback_left + i * lanes,
+                    feedback_right + i * lanes,
+                };
+
+                /*
+                Lanes which are not rendered have silent input and their filter
+                state is cleared, so they can go through the same calculations
+                as the others, without branching.
+                */
+                if constexpr (need_distortion) {
+                    Number const level = (
+                        distortion_level_buffer == NULL
+                            ? distortion_level_value
+                            : distortion_level_buffer[i]
+                    );
+
+                    for (Integer c = 0; c != CHANNELS; ++c) {
+                        for (Integer l = 0; l != lanes; ++l) {
+                            Sample const input_sample = x[c][l];
+                            Sample f_input_sample;
+                            Sample F0_input_sample;
+
+                            look_up_distortion(
+                                f_table,
+                                F0_table,
+                                input_sample,
+                                f_input_sample,
+                                F0_input_sample
+                            );
+
+                            Sample const delta = (
+                                input_sample - previous_input[c][l]
+                            );
+                            bool const is_delta_small = Math::is_abs_small(
+                                delta, 0.00000001
+                            );
+
+                            /* See Distortion::distort() */
+                            Sample const distorted = (
+                                is_delta_small
+                                    ? f_input_sample
+                                    : (
+                                        (
+                                            F0_input_sample
+                                            - F0_previous_input[c][l]
+                                        ) / (is_delta_small ? 1.0 : delta)
+                                    )
+                            );
+
+                            x[c][l] = Math::combine(
+                                level, distorted, input_sample
+                            );
+                            previous_input[c][l] = input_sample;
+                            F0_previous_input[c][l] = F0_input_sample;
+                        }
+                    }
+                }
+
+                if constexpr (!is_panning_constant) {
+                    Number const panning_value = panning_buffer[i];
+
+                    for (Integer l = 0; l != rendered_lanes; ++l) {
+                        calculate_panning_matrix(
+                            l, panning_value * panning_scale[l], matrix
+                        );
+                    }
+                }
+
+                Sample left = 0.0;
+                Sample right = 0.0;
+
+                for (Integer l = 0; l != lanes; ++l) {
+                    Number const y_n_left = (
+                        b0[ci] * x[0][l]
+                        + b1[ci] * x_n_m1[0][l]
+                        + b2[ci] * x_n_m2[0][l]
+                        + a1[ci] * y_n_m1[0][l]
+                        + a2[ci] * y_n_m2[0][l]
+                    );
+                    Number const y_n_right = (
+                        b0[ci] * x[1][l]
+                        + b1[ci] * x_n_m1[1][l]
+                        + b2[ci] * x_n_m2[1][l]
+                        + a1[ci] * y_n_m1[1][l]
+                        + a2[ci] * y_n_m2[1][l]
+                    );
+
+                    x_n_m2[0][l] = x_n_m1[0][l];
+                    x_n_m2[1][l] = x_n_m1[1][l];
+                    x_n_m1[0][l] = x[0][l];
+                    x_n_m1[1][l] = x[1][l];
+                    y_n_m2[0][l] = y_n_m1[0][l];
+                    y_n_m2[1][l] = y_n_m1[1][l];
+                    y_n_m1[0][l] = y_n_left;
+                    y_n_m1[1][l] = y_n_right;
+
+                    x[0][l] = y_n_left;
+                    x[1][l] = y_n_right;
+
+                    peak[l] = std::max(
+                        peak[l],
+                        (Sample)std::max(
+                            std::fabs(y_n_left), std::fabs(y_n_right)
+                        )
+                    );
+
+                    left += matrix[0][l] * y_n_left + matrix[1][l] * y_n_right;
+                    right += matrix[2][l] * y_n_left + matrix[3][l] * y_n_right;
+                }
+
+                out_left[i] = left;
+                out_right[i] = right;
+            }
+
+            for (Integer l = 0; l != lanes; ++l) {
+                for (Integer c = 0; c != CHANNELS; ++c) {
+                    distortion_previous_input[c][l] = previous_input[c][l];
+                    distortion_F0_previous_input[c][l] = (
+                        F0_previous_input[c][l]
+                    );
+                    this->x_n_m1[c][l] = x_n_m1[c][l];
+                    this->x_n_m2[c][l] = x_n_m2[c][l];
+                    this->y_n_m1[c][l] = y_n_m1[c][l];
+                    this->y_n_m2[c][l] = y_n_m2[c][l];
+                }
+
+                feedback_peak[l] = peak[l];
+            }
+        }
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer lanes>
+void CombFilterBank<InputSignalProducerClass, lanes>::look_up_distortion(
+        Number const* const f_table,
+        Number const* const F0_table,
+        Sample const x,
+        Sample& f,
+        Sample& F0
+) const noexcept {
+    /*
+    Same as Distortion::f() and Distortion::F0(), but without branches, so
+    that it can be vectorized across lanes: f is odd and F0 is even, and both
+    tables are indexed by the same position.
+    */
+    Sample const abs_x = std::fabs(x);
+    Number const index = std::min(
+        (Number)abs_x * DISTORTION_SCALE, (Number)DISTORTION_MAX_INDEX
+    );
+    int const before_index = std::min((int)index, DISTORTION_MAX_INDEX - 1);
+    int const after_index = before_index + 1;
+    Number const after_weight = index - (Number)before_index;
+
+    f = std::copysign(
+        Math::combine(
+            after_weight, f_table[after_index], f_table[before_index]
+        ),
+        x
+    );
+    F0 = (
+        abs_x > DISTORTION_INPUT_MAX
+            ? abs_x
+            : Math::combine(
+                after_weight, F0_table[after_index], F0_table[before_index]
+            )
+    );
+}
+
+}
+
+#endif
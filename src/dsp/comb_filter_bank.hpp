@@ -0,0 +1,260 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__COMB_FILTER_BANK_HPP
+#define JS80P__DSP__COMB_FILTER_BANK_HPP
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.hpp"
+#include "dsp/cpu.hpp"
+#include "dsp/delay_buffer_arena.hpp"
+#include "dsp/distortion.hpp"
+#include "dsp/filter.hpp"
+#include "dsp/math.hpp"
+#include "dsp/param.hpp"
+#include "dsp/signal_producer.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A set of stereo feedback comb filters which share the same input and
+ *        parameters, but have their own delay time, panning, and output
+ *        weight, and which are mixed together.
+ *
+ * Each lane renders the same signal chain as a
+ * \c DistortedHighShelfStereoPannedDelay with a \c DC_SCALABLE delay whose
+ * feedback is taken from its own high-shelf filter: delay, gain, distortion,
+ * high-shelf filter, stereo panning. The delay lines of the lanes are
+ * interleaved in a single buffer, and the state of the distortions and the
+ * filters is stored in per-lane arrays, so that a single pass over the block
+ * can process all lanes side by side with SIMD instructions. The feedback of
+ * the lanes stays independent from each other.
+ */
+template<class InputSignalProducerClass, Integer lanes>
+class CombFilterBank : public Filter<InputSignalProducerClass>
+{
+    friend class SignalProducer;
+
+    public:
+        static constexpr Integer CHANNELS = 2;
+        static constexpr Integer LANES = lanes;
+
+        CombFilterBank(
+            InputSignalProducerClass& input,
+            FloatParamS& panning,
+            FloatParamS& gain,
+            FloatParamS& time_scale,
+            Seconds const time_max,
+            BiquadFilterSharedBuffers& high_shelf_filter_shared_buffers,
+            FloatParamS& high_shelf_filter_frequency,
+            FloatParamS& high_shelf_filter_gain,
+            FloatParamS& distortion_level
+        ) noexcept;
+
+        virtual ~CombFilterBank();
+
+        virtual void set_sample_rate(
+            Frequency const new_sample_rate
+        ) noexcept override;
+
+        virtual void set_block_size(
+            Integer const new_block_size
+        ) noexcept override;
+
+        virtual void reset() noexcept override;
+
+        /**
+         * \brief Configure a lane. A lane with zero weight is not rendered.
+         */
+        void set_lane(
+            Integer const lane,
+            Seconds const delay_time,
+            Number const panning_scale,
+            Number const weight
+        ) noexcept;
+
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena()
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
+    protected:
+        Sample const* const* initialize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept JS80P_OVERRIDE;
+
+        void render(
+            Integer const round,
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample** const buffer
+        ) noexcept JS80P_OVERRIDE;
+
+    private:
+        static constexpr Number SILENCE_WEIGHT = 0.000001;
+
+        static constexpr Byte DISTORTION_TYPE = Distortion::TYPE_DELAY_FEEDBACK;
+        static constexpr int DISTORTION_MAX_INDEX = (
+            Distortion::Tables::MAX_INDEX
+        );
+        static constexpr Sample DISTORTION_INPUT_MAX = (
+            Distortion::Tables::INPUT_MAX
+        );
+        static constexpr Sample DISTORTION_SCALE = (
+            (Sample)Distortion::Tables::SIZE * (1.0 / DISTORTION_INPUT_MAX)
+        );
+
+        static constexpr Number HIGH_SHELF_FREQUENCY_SINE_SCALE = (
+            Math::SQRT_OF_2
+        );
+        static constexpr Number HIGH_SHELF_GAIN_SCALE_HALF = (
+            Constants::BIQUAD_FILTER_GAIN_SCALE / 2.0
+        );
+
+        Integer calculate_delay_buffer_size(
+            Frequency const sample_rate,
+            Integer const block_size
+        ) const noexcept;
+
+        void reallocate_delay_buffer_if_needed() noexcept;
+        void allocate_delay_buffer() noexcept;
+        void free_delay_buffer() noexcept;
+
+        void allocate_feedback_buffer() noexcept;
+        void free_feedback_buffer() noexcept;
+
+        void clear_delay_buffer(Integer const sample_count) noexcept;
+        void mix_feedback_into_delay_buffer(
+            Integer const sample_count
+        ) noexcept;
+        void mix_input_into_delay_buffer(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        void reset_lane_state(Integer const lane) noexcept;
+
+        void initialize_high_shelf_filter(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        void store_high_shelf_coefficient_samples(
+            Integer const index,
+            Number const frequency_value,
+            Number const gain_value
+        ) const noexcept;
+
+        void initialize_panning(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        JS80P_INLINE void calculate_panning_matrix(
+            Integer const lane,
+            Number const panning_value,
+            Sample matrix[4][lanes]
+        ) const noexcept;
+
+        template<bool is_panning_constant, bool need_distortion>
+        void render(
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample** const buffer
+        ) noexcept;
+
+        JS80P_INLINE void look_up_distortion(
+            Number const* const f_table,
+            Number const* const F0_table,
+            Sample const x,
+            Sample& f,
+            Sample& F0
+        ) const noexcept;
+
+        FloatParamS& panning;
+        FloatParamS& gain;
+        FloatParamS& time_scale;
+        FloatParamS& high_shelf_filter_frequency;
+        FloatParamS& high_shelf_filter_gain;
+        FloatParamS& distortion_level;
+        BiquadFilterSharedBuffers& high_shelf_filter_shared_buffers;
+        Seconds const time_max;
+
+        /*
+        Sample j of lane l is stored at index j * lanes + l in each channel of
+        the delay buffer and the feedback buffer.
+        */
+        DelayBufferArena::Region* delay_buffer_arena_region;
+        Sample** delay_buffer;
+        Sample** feedback_buffer;
+
+        Sample const* gain_buffer;
+        Sample const* time_scale_buffer;
+        Sample const* panning_buffer;
+        Sample const* distortion_level_buffer;
+
+        /*
+        Stereo panning and weighting of the lanes are done by a 2x2 matrix per
+        lane: the rows are the contributions of the left and right input
+        channels to the left output, then the same for the right output.
+        */
+        Sample panning_matrix[4][lanes];
+
+        Number delay_time[lanes];
+        Number panning_scale[lanes];
+        Number weight[lanes];
+        Number time_in_samples[lanes];
+
+        Sample distortion_previous_input[CHANNELS][lanes];
+        Sample distortion_F0_previous_input[CHANNELS][lanes];
+
+        Number x_n_m1[CHANNELS][lanes];
+        Number x_n_m2[CHANNELS][lanes];
+        Number y_n_m1[CHANNELS][lanes];
+        Number y_n_m2[CHANNELS][lanes];
+
+        Sample feedback_peak[lanes];
+        Integer silent_feedback_samples[lanes];
+        bool is_lane_rendered[lanes];
+
+        Number w0_scale;
+        Number high_shelf_no_op_frequency;
+        Number gain_value;
+        Number time_scale_value;
+        Number distortion_level_value;
+        Number read_index;
+        Number delay_buffer_size_float;
+        Integer delay_buffer_size;
+        Integer write_index_input;
+        Integer write_index_feedback;
+        Integer clear_index;
+        Integer silent_input_samples;
+        Integer feedback_sample_count;
+        Integer rendered_lanes;
+
+        bool is_starting:1;
+        bool are_coefficients_constant:1;
+};
+
+}
+
+#endif
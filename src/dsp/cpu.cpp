@@ -0,0 +1,98 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__CPU_CPP
+#define JS80P__DSP__CPU_CPP
+
+#include "dsp/cpu.hpp"
+
+
+namespace JS80P
+{
+
+#ifdef JS80P_CPU_DISPATCH_X86
+CPU::InstructionSet const CPU::instruction_set = CPU::detect_instruction_set();
+#endif
+
+
+CPU::InstructionSet CPU::detect_instruction_set() noexcept
+{
+#ifdef JS80P_CPU_DISPATCH_X86
+    /*
+    The __builtin_cpu_supports() checks also verify that the operating system
+    saves and restores the extended registers.
+    */
+    __builtin_cpu_init();
+
+    if (
+            __builtin_cpu_supports("avx512f")
+            && __builtin_cpu_supports("avx512dq")
+            && __builtin_cpu_supports("avx512vl")
+            && __builtin_cpu_supports("avx2")
+            && __builtin_cpu_supports("fma")
+    ) {
+        return InstructionSet::AVX512;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return InstructionSet::AVX2_FMA;
+    }
+
+    if (__builtin_cpu_supports("avx")) {
+        return InstructionSet::AVX;
+    }
+#endif
+
+    return InstructionSet::BASELINE;
+}
+
+
+CPU::InstructionSet CPU::get_instruction_set() noexcept
+{
+#ifdef JS80P_CPU_DISPATCH_X86
+    return instruction_set;
+#else
+    return InstructionSet::BASELINE;
+#endif
+}
+
+
+char const* CPU::get_instruction_set_name() noexcept
+{
+    switch (get_instruction_set()) {
+        case InstructionSet::AVX512:
+            return "avx512";
+
+        case InstructionSet::AVX2_FMA:
+            return "avx2+fma";
+
+        case InstructionSet::AVX:
+            return "avx";
+
+        default:
+#ifdef JS80P_CPU_DISPATCH_X86
+            return "sse2";
+#else
+            return JS80P_TO_STRING(JS80P_INSTRUCTION_SET);
+#endif
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__CPU_HPP
+#define JS80P__DSP__CPU_HPP
+
+#include "js80p.hpp"
+
+
+/*
+Runtime dispatching is only available for x86 targets when compiling with GCC
+or Clang, otherwise kernels are always run as they were compiled for the
+instruction set that was selected at build time.
+*/
+#if defined(JS80P_CPU_DISPATCH) \
+        && (defined(__GNUC__) || defined(__clang__)) \
+        && (defined(__x86_64__) || defined(__i386__))
+  #define JS80P_CPU_DISPATCH_X86
+#endif
+
+
+/*
+Mark the lambda of a kernel (see CPU::dispatch()) so that it gets compiled
+separately into each of the instruction set specific variants.
+*/
+#if defined(__GNUC__) || defined(__clang__)
+  #define JS80P_KERNEL __attribute__((always_inline))
+#else
+  #define JS80P_KERNEL
+#endif
+
+
+namespace JS80P
+{
+
+/**
+ * \brief Detect the best instruction set that is supported by the CPU, and run
+ *        hot DSP loops with code that was compiled for it.
+ */
+class CPU
+{
+    public:
+        enum InstructionSet {
+            BASELINE = 0,
+            AVX = 1,
+            AVX2_FMA = 2,
+            AVX512 = 3,
+        };
+
+        static InstructionSet get_instruction_set() noexcept;
+        static char const* get_instruction_set_name() noexcept;
+
+        /**
+         * \brief Run the given kernel (usually a lambda that is marked with
+         *        \c JS80P_KERNEL ) using the variant that was compiled for the
+         *        best instruction set that the CPU supports.
+         *
+         * \warning Functions which are called from the kernel are compiled
+         *          for the baseline instruction set unless they get inlined.
+         *
+         * \note Without \c JS80P_CPU_DISPATCH, this is just a plain call.
+         */
+        template<class KernelClass>
+        static void dispatch(KernelClass const& kernel) noexcept;
+
+    private:
+        static InstructionSet detect_instruction_set() noexcept;
+
+#ifdef JS80P_CPU_DISPATCH_X86
+        static InstructionSet const instruction_set;
+
+        template<class KernelClass>
+        __attribute__((target("avx")))
+        static void run_avx(KernelClass const& kernel) noexcept;
+
+        template<class KernelClass>
+        __attribute__((target("avx2,fma")))
+        static void run_avx2_fma(KernelClass const& kernel) noexcept;
+
+        template<class KernelClass>
+        __attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma")))
+        static void run_avx512(KernelClass const& kernel) noexcept;
+#endif
+};
+
+
+#ifdef JS80P_CPU_DISPATCH_X86
+
+template<class KernelClass>
+void CPU::dispatch(KernelClass const& kernel) noexcept
+{
+    switch (instruction_set) {
+        case InstructionSet::AVX512:
+            run_avx512<KernelClass>(kernel);
+            break;
+
+        case InstructionSet::AVX2_FMA:
+            run_avx2_fma<KernelClass>(kernel);
+            break;
+
+        case InstructionSet::AVX:
+            run_avx<KernelClass>(kernel);
+            break;
+
+        default:
+            kernel();
+            break;
+    }
+}
+
+
+template<class KernelClass>
+void CPU::run_avx(KernelClass const& kernel) noexcept
+{
+    kernel();
+}
+
+
+template<class KernelClass>
+void CPU::run_avx2_fma(KernelClass const& kernel) noexcept
+{
+    kernel();
+}
+
+
+template<class KernelClass>
+void CPU::run_avx512(KernelClass const& kernel) noexcept
+{
+    kernel();
+}
+
+#else
+
+template<class KernelClass>
+void CPU::dispatch(KernelClass const& kernel) noexcept
+{
+    kernel();
+}
+
+#endif
+
+}
+
+#endif
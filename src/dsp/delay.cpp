@@ -144,6 +144,7 @@ void Delay<
 >::initialize_instance() noexcept
 {
     shared_buffer_owner = NULL;
+    delay_buffer_arena_region = NULL;
 
     feedback_signal_producer = NULL;
     time_scale_param = NULL;
@@ -240,16 +241,29 @@ Delay<InputSignalProducerClass, capabilities>::Delay(
 }
 
 
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+Integer Delay<
+        InputSignalProducerClass,
+        capabilities
+>::calculate_delay_buffer_size(
+        Frequency const sample_rate,
+        Integer const block_size
+) const noexcept {
+    return block_size * 2 + std::max(
+        (Integer)(sample_rate * time.get_max_value()) + 1, block_size
+    ) * delay_buffer_oversize;
+}
+
+
 template<class InputSignalProducerClass, DelayCapabilities capabilities>
 void Delay<
         InputSignalProducerClass,
         capabilities
 >::reallocate_delay_buffer_if_needed() noexcept
 {
-    Integer const new_delay_buffer_size = this->block_size * 2 + std::max(
-        (Integer)(this->sample_rate * time.get_max_value()) + 1,
-        this->block_size
-    ) * delay_buffer_oversize;
+    Integer const new_delay_buffer_size = calculate_delay_buffer_size(
+        this->sample_rate, this->block_size
+    );
 
     if (new_delay_buffer_size != delay_buffer_size) {
         free_delay_buffer();
@@ -268,6 +282,15 @@ void Delay<InputSignalProducerClass, capabilities>::free_delay_buffer() noexcept
         return;
     }
 
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer = NULL;
+
+        return;
+    }
+
     for (Integer i = 0; i != this->channels; ++i) {
         delete[] delay_buffer[i];
 
@@ -291,10 +314,18 @@ void Delay<
         return;
     }
 
-    delay_buffer = new Sample*[this->channels];
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer_size <= delay_buffer_arena_region->capacity
+    ) {
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size);
+    } else {
+        delay_buffer = new Sample*[this->channels];
 
-    for (Integer c = 0; c != this->channels; ++c) {
-        delay_buffer[c] = new Sample[delay_buffer_size];
+        for (Integer c = 0; c != this->channels; ++c) {
+            delay_buffer[c] = new Sample[delay_buffer_size];
+        }
     }
 
     Delay<InputSignalProducerClass, capabilities>::reset();
@@ -307,7 +338,12 @@ void Delay<InputSignalProducerClass, capabilities>::reset() noexcept
 {
     Filter<InputSignalProducerClass>::reset();
 
-    if (shared_buffer_owner == NULL) {
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer_arena_region->clear();
+    } else if (shared_buffer_owner == NULL) {
         for (Integer c = 0; c != this->channels; ++c) {
             std::fill_n(delay_buffer[c], delay_buffer_size, 0.0);
         }
@@ -465,6 +501,86 @@ void Delay<InputSignalProducerClass, capabilities>::use_shared_delay_buffer(
 }
 
 
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<InputSignalProducerClass, capabilities>::use_delay_buffer_arena(
+        DelayBufferArena& arena,
+        bool const is_on_demand
+) noexcept {
+    if (
+            shared_buffer_owner != NULL
+            || delay_buffer_arena_region != NULL
+            || this->channels <= 0
+    ) {
+        return;
+    }
+
+    delay_buffer_arena_region = arena.reserve(
+        this->channels,
+        calculate_delay_buffer_size(
+            DelayBufferArena::SAMPLE_RATE_MAX, DelayBufferArena::BLOCK_SIZE_MAX
+        ),
+        is_on_demand
+    );
+
+    if (delay_buffer_size <= delay_buffer_arena_region->capacity) {
+        /*
+        The region is zeroed when it gets committed, so there's no need to
+        reset here.
+        */
+        free_delay_buffer();
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size);
+    }
+}
+
+
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+bool Delay<
+        InputSignalProducerClass,
+        capabilities
+>::acquire_delay_buffer() noexcept
+{
+    if (
+            delay_buffer_arena_region == NULL
+            || delay_buffer != delay_buffer_arena_region->buffer
+    ) {
+        return true;
+    }
+
+    return delay_buffer_arena_region->acquire();
+}
+
+
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<
+        InputSignalProducerClass,
+        capabilities
+>::release_delay_buffer() noexcept
+{
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer_arena_region->release();
+    }
+}
+
+
+template<class InputSignalProducerClass, DelayCapabilities capabilities>
+void Delay<
+        InputSignalProducerClass,
+        capabilities
+>::commit_delay_buffer_now() const noexcept
+{
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer_arena_region->commit_now();
+    }
+}
+
+
 template<class InputSignalProducerClass, DelayCapabilities capabilities>
 Sample const* const* Delay<
         InputSignalProducerClass,
@@ -971,7 +1087,7 @@ void Delay<InputSignalProducerClass, capabilities>::render_with_gain(
     Number reverse_done_samples = 0;
     Number reverse_target_delay_time_in_samples = 0;
     Number reverse_target_delay_time_in_samples_inv = 0;
-    Sample const* reverse_delay_envelope_table = NULL;
+    Number const* reverse_delay_envelope_table = NULL;
 
     if constexpr (is_reversed) {
         reverse_target_delay_time_in_samples = (
@@ -1267,7 +1383,7 @@ void Delay<
         Sample& sample,
         Number const reverse_done_samples,
         Number const reverse_target_delay_time_in_samples_inv,
-        Sample const* const reverse_delay_envelope_table
+        Number const* const reverse_delay_envelope_table
 ) const noexcept {
     Number const index = (
         ReverseDelayEnvelope::TABLE_MAX_INDEX_FLOAT
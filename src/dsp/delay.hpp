@@ -25,6 +25,7 @@
 
 #include "dsp/filter.hpp"
 #include "dsp/biquad_filter.hpp"
+#include "dsp/delay_buffer_arena.hpp"
 #include "dsp/distortion.hpp"
 #include "dsp/math.hpp"
 #include "dsp/lfo.hpp"
@@ -123,6 +124,34 @@ class Delay : public Filter<InputSignalProducerClass>
                 shared_buffer_owner
         ) noexcept;
 
+        /**
+         * \brief Keep the delay buffer in a region of the given arena instead
+         *        of the heap, so that changing the sample rate or the block
+         *        size within the limits of the arena does not reallocate it.
+         *
+         * \warning See \c DelayBufferArena.
+         */
+        void use_delay_buffer_arena(
+            DelayBufferArena& arena,
+            bool const is_on_demand = false
+        ) noexcept;
+
+        /**
+         * \brief See \c DelayBufferArena::Region::acquire(). (A delay buffer
+         *        which is not in an arena is always ready.)
+         */
+        bool acquire_delay_buffer() noexcept;
+
+        /**
+         * \brief See \c DelayBufferArena::Region::release().
+         */
+        void release_delay_buffer() noexcept;
+
+        /**
+         * \brief See \c DelayBufferArena::Region::commit_now().
+         */
+        void commit_delay_buffer_now() const noexcept;
+
         void set_time_scale_param(FloatParamS& time_scale_param) noexcept;
 
         void set_reverse_toggle_param(
@@ -168,6 +197,11 @@ class Delay : public Filter<InputSignalProducerClass>
 
         void initialize_instance() noexcept;
 
+        Integer calculate_delay_buffer_size(
+            Frequency const sample_rate,
+            Integer const block_size
+        ) const noexcept;
+
         void reallocate_delay_buffer_if_needed() noexcept;
         void free_delay_buffer() noexcept;
         void allocate_delay_buffer() noexcept;
@@ -236,7 +270,7 @@ class Delay : public Filter<InputSignalProducerClass>
             Sample& sample,
             Number const reverse_done_samples,
             Number const reverse_target_delay_time_in_samples_inv,
-            Sample const* const reverse_delay_envelope_table
+            Number const* const reverse_delay_envelope_table
         ) const noexcept;
 
         void advance_reverse_rendering(
@@ -267,6 +301,7 @@ class Delay : public Filter<InputSignalProducerClass>
         SignalProducer* feedback_signal_producer;
         FloatParamS* time_scale_param;
         ToggleParam* reverse_toggle_param;
+        DelayBufferArena::Region* delay_buffer_arena_region;
         Sample** delay_buffer;
         LFO** channel_lfos;
         Sample const** channel_lfo_buffers;
@@ -0,0 +1,636 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__DELAY_BUFFER_ARENA_CPP
+#define JS80P__DSP__DELAY_BUFFER_ARENA_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+/* The synth is compiled as a single unit, and it relies on std::min(). */
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "dsp/delay_buffer_arena.hpp"
+
+
+namespace JS80P
+{
+
+DelayBufferArena::Region::Region(
+        DelayBufferArena& arena,
+        Integer const channels,
+        Integer const capacity,
+        bool const is_on_demand
+) : channels(channels),
+    capacity(capacity),
+    buffer(new Sample*[channels]),
+    is_on_demand(is_on_demand),
+    arena(arena),
+    state(RELEASED),
+    used(0),
+    heap(NULL),
+    heap_capacity(0),
+    is_on_heap(false)
+{
+    for (Integer c = 0; c != channels; ++c) {
+        buffer[c] = NULL;
+    }
+}
+
+
+DelayBufferArena::Region::~Region()
+{
+    delete[] buffer;
+    delete[] heap;
+}
+
+
+void DelayBufferArena::Region::use(Integer const samples) noexcept
+{
+    JS80P_ASSERT(0 < samples && samples <= capacity);
+
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+    std::lock_guard<std::mutex> lock(arena.mutex);
+#endif
+
+    used = samples;
+
+    if (!arena.is_allocated()) {
+        return;
+    }
+
+    /*
+    A released region may still be acquired again before the memory is given
+    back, so it needs to be kept in sync with its size.
+    */
+    int const state = this->state.load(std::memory_order_acquire);
+
+    if (state == READY || state == RELEASE_REQUESTED) {
+        prepare();
+    }
+}
+
+
+void DelayBufferArena::Region::prepare() noexcept
+{
+    if (used == 0) {
+        return;
+    }
+
+    if (!is_on_heap) {
+        for (Integer c = 0; c != channels; ++c) {
+            if (!commit(buffer[c], used)) {
+                is_on_heap = true;
+
+                break;
+            }
+        }
+    }
+
+    if (is_on_heap && used > heap_capacity) {
+        delete[] heap;
+
+        heap_capacity = align(used);
+        heap = new Sample[heap_capacity * channels];
+
+        for (Integer c = 0; c != channels; ++c) {
+            buffer[c] = &heap[c * heap_capacity];
+        }
+    }
+
+    /*
+    Writing the samples makes the operating system back them with physical
+    memory now, instead of when the audio thread first touches them.
+    */
+    for (Integer c = 0; c != channels; ++c) {
+        std::fill_n(buffer[c], used, 0.0);
+    }
+}
+
+
+void DelayBufferArena::Region::clear() noexcept
+{
+    if (
+            buffer[0] == NULL
+            || state.load(std::memory_order_acquire) != READY
+    ) {
+        return;
+    }
+
+    for (Integer c = 0; c != channels; ++c) {
+        std::fill_n(buffer[c], used, 0.0);
+    }
+}
+
+
+bool DelayBufferArena::Region::acquire() noexcept
+{
+    if (!is_on_demand) {
+        return true;
+    }
+
+    int state = this->state.load(std::memory_order_acquire);
+
+    if (JS80P_LIKELY(state == READY)) {
+        return true;
+    }
+
+    if (
+            state == RELEASE_REQUESTED
+            && this->state.compare_exchange_strong(state, READY)
+    ) {
+        return true;
+    }
+
+    if (state == RELEASED) {
+        this->state.compare_exchange_strong(state, COMMIT_REQUESTED);
+    }
+
+    return false;
+}
+
+
+void DelayBufferArena::Region::release() noexcept
+{
+    if (!is_on_demand) {
+        return;
+    }
+
+    int state = this->state.load(std::memory_order_acquire);
+
+    if (state == READY) {
+        this->state.compare_exchange_strong(state, RELEASE_REQUESTED);
+    } else if (state == COMMIT_REQUESTED) {
+        this->state.compare_exchange_strong(state, RELEASED);
+    }
+}
+
+
+void DelayBufferArena::Region::commit_now() noexcept
+{
+    if (!is_on_demand) {
+        return;
+    }
+
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+    std::lock_guard<std::mutex> lock(arena.mutex);
+#endif
+
+    if (!arena.is_allocated()) {
+        return;
+    }
+
+    int state = this->state.load(std::memory_order_acquire);
+
+    /*
+    The audio thread may be switching between RELEASED and COMMIT_REQUESTED,
+    or it may take back a release request in the meantime.
+    */
+    while (state != READY) {
+        if (state == RELEASE_REQUESTED) {
+            if (this->state.compare_exchange_strong(state, READY)) {
+                return;
+            }
+        } else if (this->state.compare_exchange_strong(state, COMMITTING)) {
+            prepare();
+            this->state.store(READY, std::memory_order_release);
+
+            return;
+        }
+    }
+}
+
+
+void DelayBufferArena::Region::update() noexcept
+{
+    if (!is_on_demand) {
+        return;
+    }
+
+    int state = COMMIT_REQUESTED;
+
+    if (this->state.compare_exchange_strong(state, COMMITTING)) {
+        prepare();
+        this->state.store(READY, std::memory_order_release);
+
+        return;
+    }
+
+    state = RELEASE_REQUESTED;
+
+    if (this->state.compare_exchange_strong(state, RELEASING)) {
+        discard();
+        this->state.store(RELEASED, std::memory_order_release);
+    }
+}
+
+
+void DelayBufferArena::Region::discard() noexcept
+{
+    if (is_on_heap) {
+        delete[] heap;
+
+        heap = NULL;
+        heap_capacity = 0;
+
+        for (Integer c = 0; c != channels; ++c) {
+            buffer[c] = NULL;
+        }
+
+        return;
+    }
+
+    if (arena.page_size == 0 || buffer[0] == NULL) {
+        return;
+    }
+
+    /*
+    The channels of a region are laid out next to each other, and the first
+    and the last page may be shared with the neighbouring regions, so only
+    the pages in between are given back. The rest is overwritten anyway when
+    the region is committed again.
+    */
+    uintptr_t const page_mask = ~(uintptr_t)(arena.page_size - 1);
+    uintptr_t const begin = (uintptr_t)buffer[0];
+    uintptr_t const end = (uintptr_t)(
+        buffer[0] + align(capacity) * channels
+    );
+    uintptr_t const pages_begin = (begin + arena.page_size - 1) & page_mask;
+    uintptr_t const pages_end = end & page_mask;
+
+    if (pages_begin < pages_end) {
+        decommit((void*)pages_begin, (size_t)(pages_end - pages_begin));
+    }
+}
+
+
+DelayBufferArena::DelayBufferArena() noexcept
+    : samples(0),
+    mapping(NULL),
+    mapping_size(0),
+    page_size(0),
+    memory(NULL),
+    is_allocated_(false)
+{
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+    pager = NULL;
+    is_pager_stopping = false;
+#endif
+}
+
+
+DelayBufferArena::~DelayBufferArena()
+{
+    stop_pager();
+    unmap();
+
+    for (Region* const region : regions) {
+        delete region;
+    }
+
+    regions.clear();
+}
+
+
+DelayBufferArena::Region* DelayBufferArena::reserve(
+        Integer const channels,
+        Integer const capacity,
+        bool const is_on_demand
+) {
+    JS80P_ASSERT(!is_allocated());
+    JS80P_ASSERT(channels > 0);
+    JS80P_ASSERT(capacity > 0);
+
+#ifdef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+    Region* const region = new Region(*this, channels, capacity, false);
+#else
+    Region* const region = new Region(
+        *this, channels, capacity, is_on_demand
+    );
+#endif
+
+    regions.push_back(region);
+    samples += align(capacity) * channels;
+
+    return region;
+}
+
+
+void DelayBufferArena::allocate() noexcept
+{
+    if (is_allocated() || samples == 0) {
+        return;
+    }
+
+    is_allocated_ = true;
+
+    /*
+    Reserving address space for the highest sample rate would exhaust the
+    address space of 32-bit processes after a few instances.
+    */
+    bool const is_mapped = sizeof(void*) >= 8 && map();
+    bool has_on_demand_regions = false;
+    Integer offset = 0;
+
+    for (Region* const region : regions) {
+        if (is_mapped) {
+            Integer const aligned_capacity = align(region->capacity);
+
+            for (Integer c = 0; c != region->channels; ++c) {
+                region->buffer[c] = &memory[offset];
+                offset += aligned_capacity;
+            }
+        } else {
+            region->is_on_heap = true;
+        }
+
+        if (region->is_on_demand) {
+            has_on_demand_regions = true;
+        } else {
+            region->prepare();
+            region->state.store(Region::READY, std::memory_order_release);
+        }
+    }
+
+    JS80P_ASSERT(!is_mapped || offset == samples);
+
+    if (has_on_demand_regions) {
+        start_pager();
+    }
+}
+
+
+void DelayBufferArena::update_regions() noexcept
+{
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+
+    if (!is_allocated()) {
+        return;
+    }
+
+    for (Region* const region : regions) {
+        region->update();
+    }
+}
+
+
+bool DelayBufferArena::is_allocated() const noexcept
+{
+    return is_allocated_;
+}
+
+
+size_t DelayBufferArena::get_size() const noexcept
+{
+    return (size_t)samples * sizeof(Sample);
+}
+
+
+Integer DelayBufferArena::align(Integer const samples) noexcept
+{
+    return (samples + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+
+#ifdef _WIN32
+
+bool DelayBufferArena::commit(
+        Sample* const begin,
+        Integer const size
+) noexcept {
+    /* Committing pages which are already committed is a no-op. */
+    return VirtualAlloc(
+        begin, (size_t)size * sizeof(Sample), MEM_COMMIT, PAGE_READWRITE
+    ) != NULL;
+}
+
+
+void DelayBufferArena::decommit(void* const pages, size_t const size) noexcept
+{
+    VirtualFree(pages, size, MEM_DECOMMIT);
+}
+
+
+bool DelayBufferArena::map() noexcept
+{
+    size_t const size = get_size();
+    SYSTEM_INFO system_info;
+
+    /* Pages are committed by Region::use() when they are needed. */
+    mapping = VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_READWRITE);
+
+    if (mapping == NULL) {
+        return false;
+    }
+
+    GetSystemInfo(&system_info);
+
+    mapping_size = size;
+    page_size = (size_t)system_info.dwPageSize;
+    memory = (Sample*)mapping;
+
+    return true;
+}
+
+
+void DelayBufferArena::unmap() noexcept
+{
+    if (mapping != NULL) {
+        VirtualFree(mapping, 0, MEM_RELEASE);
+    }
+
+    mapping = NULL;
+    mapping_size = 0;
+    page_size = 0;
+    memory = NULL;
+}
+
+#else
+
+bool DelayBufferArena::commit(
+        Sample* const begin,
+        Integer const size
+) noexcept {
+    /* Anonymous mappings are backed by physical memory when written. */
+    return true;
+}
+
+
+void DelayBufferArena::decommit(void* const pages, size_t const size) noexcept
+{
+#ifdef __linux__
+    madvise(pages, size, MADV_DONTNEED);
+#else
+    /*
+    Elsewhere MADV_DONTNEED may keep the pages, so they are replaced with a
+    new mapping instead.
+    */
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+
+    mmap(pages, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+}
+
+
+bool DelayBufferArena::map() noexcept
+{
+    /*
+    Transparent huge pages can only be used for the parts of the mapping
+    which are aligned to the huge page size, so a little more is mapped than
+    what is needed, and the beginning of the memory is aligned manually.
+    */
+    size_t const size = get_size() + HUGE_PAGE_SIZE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+
+    void* const mapped = mmap(
+        NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0
+    );
+
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    uintptr_t const aligned = (
+        ((uintptr_t)mapped + HUGE_PAGE_SIZE - 1)
+        & ~(uintptr_t)(HUGE_PAGE_SIZE - 1)
+    );
+
+#ifdef MADV_HUGEPAGE
+    madvise((void*)aligned, get_size(), MADV_HUGEPAGE);
+#endif
+
+    long const system_page_size = sysconf(_SC_PAGESIZE);
+
+    mapping = mapped;
+    mapping_size = size;
+    page_size = system_page_size > 0 ? (size_t)system_page_size : 0;
+    memory = (Sample*)aligned;
+
+    return true;
+}
+
+
+void DelayBufferArena::unmap() noexcept
+{
+    if (mapping != NULL) {
+        munmap(mapping, mapping_size);
+    }
+
+    mapping = NULL;
+    mapping_size = 0;
+    page_size = 0;
+    memory = NULL;
+}
+
+#endif
+
+
+#ifdef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+
+void DelayBufferArena::start_pager() noexcept
+{
+}
+
+
+void DelayBufferArena::stop_pager() noexcept
+{
+}
+
+#else
+
+void DelayBufferArena::start_pager() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (pager != NULL) {
+        return;
+    }
+
+    is_pager_stopping = false;
+    pager = new std::thread(&page, this);
+}
+
+
+void DelayBufferArena::stop_pager() noexcept
+{
+    std::thread* stopped_pager = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (pager == NULL) {
+            return;
+        }
+
+        is_pager_stopping = true;
+        stopped_pager = pager;
+        pager = NULL;
+    }
+
+    pager_condition.notify_one();
+    stopped_pager->join();
+
+    delete stopped_pager;
+}
+
+
+void DelayBufferArena::page(DelayBufferArena* const arena) noexcept
+{
+    std::unique_lock<std::mutex> lock(arena->mutex);
+
+    /*
+    The audio thread doesn't notify the pager about requests, so that it never
+    has to touch the mutex, so the pager polls them.
+    */
+    while (!arena->is_pager_stopping) {
+        for (Region* const region : arena->regions) {
+            region->update();
+        }
+
+        arena->pager_condition.wait_for(
+            lock,
+            std::chrono::milliseconds(PAGER_POLL_MILLISECONDS),
+            [arena]() { return arena->is_pager_stopping; }
+        );
+    }
+}
+
+#endif
+
+}
+
+#endif
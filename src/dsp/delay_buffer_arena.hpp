@@ -0,0 +1,301 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__DELAY_BUFFER_ARENA_HPP
+#define JS80P__DSP__DELAY_BUFFER_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "js80p.hpp"
+
+
+/*
+MinGW-w64 toolchains which use the win32 threading model don't provide
+std::thread before GCC 13, so all regions are committed when the arena is
+allocated there.
+*/
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_HAS_GTHREADS)
+  #define JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+#else
+  #include <condition_variable>
+  #include <mutex>
+  #include <thread>
+#endif
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A single, contiguous block of memory which is carved into aligned
+ *        regions for the buffers of delay lines.
+ *
+ * Each region is large enough to hold the delay buffer of its owner at the
+ * highest supported sample rate and block size, so changing the sample rate
+ * or the block size never needs to allocate or free memory, only to use more
+ * or less of the region.
+ *
+ * The delay lines reserve their regions first, then \c allocate() reserves
+ * address space for all of them at once, directly from the operating system.
+ * Only the part of a region which its owner declares with \c Region::use() is
+ * backed by physical memory, and that part is committed and pre-faulted right
+ * away, outside the audio thread, so rendering never runs into page faults.
+ * Transparent huge pages are requested where they are available.
+ *
+ * Regions which are reserved as on-demand regions are not committed when the
+ * arena is allocated. Their owner has to \c Region::acquire() them on the
+ * audio thread before each use, and \c Region::release() them when it can do
+ * without them for a while. These calls only set a flag, and a background
+ * thread of the arena commits and pre-faults the acquired regions, and gives
+ * the memory of the released ones back to the operating system.
+ *
+ * Where the address space cannot be reserved, or where it is too scarce for
+ * the highest sample rate (i.e. in 32-bit processes), each region gets its
+ * own heap buffer instead, which is only as large as its current use.
+ *
+ * \warning The arena must outlive the delay lines which use it, and
+ *          \c allocate() must be called before any of them is rendered or
+ *          reset.
+ */
+class DelayBufferArena
+{
+    public:
+        static constexpr Frequency SAMPLE_RATE_MAX = 192000.0;
+        static constexpr Integer BLOCK_SIZE_MAX = 8192;
+
+        class Region
+        {
+            friend class DelayBufferArena;
+
+            public:
+                Region(Region const& region) = delete;
+                Region(Region&& region) = delete;
+
+                Region& operator=(Region const& region) = delete;
+                Region& operator=(Region&& region) = delete;
+
+                Integer const channels;
+
+                /**
+                 * \brief Number of samples per channel.
+                 */
+                Integer const capacity;
+
+                /**
+                 * \brief The channels of the region. The pointers are \c NULL
+                 *        until the arena is allocated.
+                 */
+                Sample** const buffer;
+
+                /**
+                 * \brief Whether the memory of the region is committed only
+                 *        between \c acquire() and \c release().
+                 */
+                bool const is_on_demand;
+
+                /**
+                 * \brief Make the first \c samples of each channel usable,
+                 *        and set them to zero. The owner must call this
+                 *        whenever it starts to use the region, and whenever
+                 *        the number of samples that it needs changes. (An
+                 *        on-demand region which is not acquired only records
+                 *        the new size, and it is committed later.)
+                 *
+                 * \warning Not real-time safe.
+                 */
+                void use(Integer const samples) noexcept;
+
+                /**
+                 * \brief Set the samples which are in use to zero, if the
+                 *        region is ready. (Pages are never returned to the
+                 *        operating system here, because that would need
+                 *        system calls, and the pages would be faulted in
+                 *        again on the audio thread when they are written
+                 *        next time.)
+                 */
+                void clear() noexcept;
+
+                /**
+                 * \brief Tell whether the samples in use can be read and
+                 *        written. If not, then ask the background thread of
+                 *        the arena to commit the region, and try again in the
+                 *        next round. (A region which is not on-demand is
+                 *        always ready.)
+                 *
+                 * \note Real-time safe.
+                 */
+                bool acquire() noexcept;
+
+                /**
+                 * \brief Let the background thread of the arena give the
+                 *        memory of an on-demand region back to the operating
+                 *        system. The samples must not be touched after this,
+                 *        until \c acquire() returns \c true again, and they
+                 *        are zero by then, unless the region is acquired
+                 *        before the background thread gets to it.
+                 *
+                 * \note Real-time safe.
+                 */
+                void release() noexcept;
+
+                /**
+                 * \brief Commit an on-demand region on the calling thread if
+                 *        it is not ready yet, so that the next \c acquire()
+                 *        succeeds without waiting for the background thread.
+                 *
+                 * \warning Not real-time safe.
+                 */
+                void commit_now() noexcept;
+
+            private:
+                enum State {
+                    RELEASED = 0,
+                    COMMIT_REQUESTED = 1,
+                    COMMITTING = 2,
+                    READY = 3,
+                    RELEASE_REQUESTED = 4,
+                    RELEASING = 5,
+                };
+
+                Region(
+                    DelayBufferArena& arena,
+                    Integer const channels,
+                    Integer const capacity,
+                    bool const is_on_demand
+                );
+                ~Region();
+
+                void prepare() noexcept;
+                void update() noexcept;
+                void discard() noexcept;
+
+                DelayBufferArena& arena;
+
+                /*
+                Only the audio thread can take a region out of the READY
+                state, and the non-real-time threads can only touch its
+                memory in the COMMITTING and RELEASING states, while they are
+                holding the mutex of the arena.
+                */
+                std::atomic<int> state;
+
+                /* Number of samples in use in each channel. */
+                Integer used;
+
+                Sample* heap;
+                Integer heap_capacity;
+                bool is_on_heap;
+        };
+
+        DelayBufferArena() noexcept;
+        ~DelayBufferArena();
+
+        DelayBufferArena(DelayBufferArena const& arena) = delete;
+        DelayBufferArena(DelayBufferArena&& arena) = delete;
+
+        DelayBufferArena& operator=(DelayBufferArena const& arena) = delete;
+        DelayBufferArena& operator=(DelayBufferArena&& arena) = delete;
+
+        /**
+         * \brief Reserve a region with the given number of channels, each
+         *        holding \c capacity samples. Must be called before
+         *        \c allocate().
+         */
+        Region* reserve(
+            Integer const channels,
+            Integer const capacity,
+            bool const is_on_demand = false
+        );
+
+        /**
+         * \brief Reserve the address space for the regions, commit the ones
+         *        which are not on-demand, and start the background thread
+         *        which commits and releases the on-demand regions.
+         *
+         * \warning Not real-time safe.
+         */
+        void allocate() noexcept;
+
+        /**
+         * \brief Commit the on-demand regions which have been acquired, and
+         *        give back the memory of the ones which have been released
+         *        since the last update. (The background thread of the arena
+         *        does this periodically.)
+         *
+         * \warning Not real-time safe.
+         */
+        void update_regions() noexcept;
+
+        bool is_allocated() const noexcept;
+
+        /**
+         * \brief Total size of the reserved regions in bytes, including
+         *        alignment padding.
+         */
+        size_t get_size() const noexcept;
+
+    private:
+        /* Channels start at cache line boundaries. */
+        static constexpr Integer ALIGNMENT = 64 / (Integer)sizeof(Sample);
+
+        static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        static constexpr int PAGER_POLL_MILLISECONDS = 100;
+
+        static Integer align(Integer const samples) noexcept;
+
+        static bool commit(Sample* const begin, Integer const size) noexcept;
+
+        static void decommit(void* const pages, size_t const size) noexcept;
+
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+        static void page(DelayBufferArena* const arena) noexcept;
+#endif
+
+        bool map() noexcept;
+        void unmap() noexcept;
+
+        void start_pager() noexcept;
+        void stop_pager() noexcept;
+
+        std::vector<Region*> regions;
+        Integer samples;
+
+        void* mapping;
+        size_t mapping_size;
+        size_t page_size;
+        Sample* memory;
+        bool is_allocated_;
+
+#ifndef JS80P_DELAY_BUFFER_ARENA_SINGLE_THREADED
+        /*
+        The non-real-time threads which resize, commit, and release regions
+        hold the mutex, the audio thread only uses the states of the regions.
+        */
+        std::mutex mutex;
+        std::condition_variable pager_condition;
+        std::thread* pager;
+        bool is_pager_stopping;
+#endif
+};
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #define JS80P__DSP__DISTORTION_CPP
 
 #include <cmath>
+#include <string>
 
 #include "dsp/distortion.hpp"
 
@@ -39,6 +40,98 @@ TypeParam::TypeParam(std::string const& name, Byte const default_type) noexcept
 
 
 Tables::Tables()
+    : load_state(NOT_LOADED),
+    table_cache(NULL),
+    owned_tables(NULL),
+    f_tables(NULL),
+    F0_tables(NULL)
+{
+}
+
+
+Tables::Tables(std::string const& cache_directory) : Tables()
+{
+    load(cache_directory);
+}
+
+
+void Tables::load() noexcept
+{
+    if (JS80P_LIKELY(load_state.load(std::memory_order_acquire) == LOADED)) {
+        return;
+    }
+
+    load(TableCache::get_default_directory());
+}
+
+
+void Tables::load(std::string const& cache_directory) noexcept
+{
+    /*
+    Plugin instances may be created on multiple threads simultaneously.
+    (std::call_once() is not available on all supported toolchains.)
+    */
+    int expected = NOT_LOADED;
+
+    if (load_state.compare_exchange_strong(expected, LOADING)) {
+        load_or_build(cache_directory);
+        load_state.store(LOADED, std::memory_order_release);
+
+        return;
+    }
+
+    while (load_state.load(std::memory_order_acquire) != LOADED) {
+        /* Another thread is loading the tables. */
+    }
+}
+
+
+std::string Tables::build_cache_name() noexcept
+{
+    return (
+        "distortion-v" + std::to_string(VERSION)
+        + "-" + std::to_string(TYPES)
+        + "x" + std::to_string(SIZE)
+        + "-" + std::to_string((int)INPUT_MAX)
+    );
+}
+
+
+void Tables::load_or_build(std::string const& cache_directory) noexcept
+{
+    table_cache = new TableCache(
+        cache_directory, build_cache_name(), sizeof(Table) * TYPES * 2
+    );
+
+    Table const* const cached_tables = (Table const*)table_cache->get_data();
+
+    if (cached_tables != NULL) {
+        f_tables = cached_tables;
+        F0_tables = cached_tables + TYPES;
+    } else {
+        owned_tables = new Table[TYPES * 2];
+        f_tables = owned_tables;
+        F0_tables = owned_tables + TYPES;
+
+        initialize_tables();
+        table_cache->store(owned_tables);
+    }
+}
+
+
+Tables::~Tables()
+{
+    delete[] owned_tables;
+    delete table_cache;
+
+    owned_tables = NULL;
+    table_cache = NULL;
+    f_tables = NULL;
+    F0_tables = NULL;
+}
+
+
+void Tables::initialize_tables() noexcept
 {
     initialize_tanh_tables(TYPE_TANH_3, 3.0);
     initialize_tanh_tables(TYPE_TANH_5, 5.0);
@@ -404,8 +497,8 @@ void Tables::initialize_tanh_tables(
         - steepness_inv_double * std::log1p(std::exp(-steepness * INPUT_MAX))
     );
 
-    Table& f_table = f_tables[type];
-    Table& F0_table = F0_tables[type];
+    Table& f_table = owned_tables[type];
+    Table& F0_table = owned_tables[TYPES + type];
 
     for (Integer i = 0; i != SIZE; ++i) {
         Number const x = INPUT_MAX * ((Sample)i * SIZE_INV);
@@ -557,8 +650,8 @@ void Tables::initialize_spline_tables(
     Number const Bo3 = B / 3.0;
     Number const Co2 = C / 2.0;
 
-    Table& f_table = f_tables[type];
-    Table& F0_table = F0_tables[type];
+    Table& f_table = owned_tables[type];
+    Table& F0_table = owned_tables[TYPES + type];
 
     for (Integer i = 0; i != SIZE; ++i) {
         Number const x = INPUT_MAX * ((Sample)i * SIZE_INV);
@@ -821,8 +914,8 @@ void Tables::initialize_delay_feedback_tables() noexcept
         cf
     );
 
-    Table& f_table = f_tables[TYPE_DELAY_FEEDBACK];
-    Table& F0_table = F0_tables[TYPE_DELAY_FEEDBACK];
+    Table& f_table = owned_tables[TYPE_DELAY_FEEDBACK];
+    Table& F0_table = owned_tables[TYPES + TYPE_DELAY_FEEDBACK];
 
     /*
     Floating point errors and interpolation errors become relatively large
@@ -838,12 +931,16 @@ void Tables::initialize_delay_feedback_tables() noexcept
 
 Table const& Tables::get_f_table(Byte const type) const noexcept
 {
+    JS80P_ASSERT(f_tables != NULL);
+
     return f_tables[type];
 }
 
 
 Table const& Tables::get_F0_table(Byte const type) const noexcept
 {
+    JS80P_ASSERT(F0_tables != NULL);
+
     return F0_tables[type];
 }
 
@@ -901,6 +998,8 @@ Distortion<InputSignalProducerClass>::Distortion(
 template<class InputSignalProducerClass>
 void Distortion<InputSignalProducerClass>::initialize_instance() noexcept
 {
+    tables.load();
+
     this->register_child(level);
 
     if (this->channels > 0) {
@@ -1037,31 +1136,41 @@ void Distortion<InputSignalProducerClass>::render(
     Sample* const previous_input_sample = this->previous_input_sample;
     Sample* const F0_previous_input_sample = this->F0_previous_input_sample;
 
-    for (Integer c = 0; c != channels; ++c) {
-        Sample const* const in_channel = input_buffer[c];
-        Sample* const out_channel = buffer[c];
-        Sample previous_input_sample_c = previous_input_sample[c];
-        Sample F0_previous_input_sample_c = F0_previous_input_sample[c];
-
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            Sample const input_sample = in_channel[i];
-
-            out_channel[i] = Math::combine(
-                level[i],
-                distort(
-                    f_table,
-                    F0_table,
-                    input_sample,
-                    previous_input_sample_c,
-                    F0_previous_input_sample_c
-                ),
-                input_sample
-            );
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            for (Integer c = 0; c != channels; ++c) {
+                Sample const* const in_channel = input_buffer[c];
+                Sample* const out_channel = buffer[c];
+                Sample previous_input_sample_c = previous_input_sample[c];
+                Sample F0_previous_input_sample_c = (
+                    F0_previous_input_sample[c]
+                );
+
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    Sample const input_sample = in_channel[i];
+
+                    out_channel[i] = Math::combine(
+                        level[i],
+                        distort(
+                            f_table,
+                            F0_table,
+                            input_sample,
+                            previous_input_sample_c,
+                            F0_previous_input_sample_c
+                        ),
+                        input_sample
+                    );
+                }
+
+                previous_input_sample[c] = previous_input_sample_c;
+                F0_previous_input_sample[c] = F0_previous_input_sample_c;
+            }
         }
-
-        this->previous_input_sample[c] = previous_input_sample_c;
-        this->F0_previous_input_sample[c] = F0_previous_input_sample_c;
-    }
+    );
 }
 
 
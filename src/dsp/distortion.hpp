@@ -19,10 +19,13 @@
 #ifndef JS80P__DSP__DISTORTION_HPP
 #define JS80P__DSP__DISTORTION_HPP
 
+#include <atomic>
 #include <string>
 
 #include "js80p.hpp"
+#include "table_cache.hpp"
 
+#include "dsp/cpu.hpp"
 #include "dsp/filter.hpp"
 #include "dsp/param.hpp"
 #include "dsp/signal_producer.hpp"
@@ -73,7 +76,7 @@ class TypeParam : public ByteParam
 };
 
 
-typedef Sample Table[0x2000];
+typedef Number Table[0x2000];
 
 
 /**
@@ -103,14 +106,61 @@ class Tables
         static constexpr Sample INPUT_MAX = 3.0;
         static constexpr Sample INPUT_MIN = - INPUT_MAX;
 
+        /*
+        Increment this whenever the code which computes the tables changes, so
+        that stale tables in the TableCache are not used.
+        */
+        static constexpr int VERSION = 1;
+
+        /**
+         * \brief The tables will be loaded from the \c TableCache in the
+         *        default directory, or built, when \c load() is first called.
+         *        (This way the global instance does not do any file I/O when
+         *        the plugin is loaded, only when it is first used.)
+         */
         Tables();
 
+        /**
+         * \brief Load the tables from the \c TableCache in the given directory
+         *        if possible, or build them and try to store them there. (An
+         *        empty string disables caching.)
+         */
+        explicit Tables(std::string const& cache_directory);
+
+        ~Tables();
+
+        Tables(Tables const& tables) = delete;
+        Tables(Tables&& tables) = delete;
+
+        Tables& operator=(Tables const& tables) = delete;
+        Tables& operator=(Tables&& tables) = delete;
+
+        /**
+         * \brief Make sure that the tables are loaded or built. Thread-safe,
+         *        but not real-time safe, so objects which use the tables must
+         *        call this before they are rendered, e.g. in their constructor.
+         */
+        void load() noexcept;
+
         Table const& get_f_table(Byte const type) const noexcept;
         Table const& get_F0_table(Byte const type) const noexcept;
 
     private:
+        enum LoadState {
+            NOT_LOADED = 0,
+            LOADING = 1,
+            LOADED = 2,
+        };
+
+        static std::string build_cache_name() noexcept;
+
+        void load(std::string const& cache_directory) noexcept;
+        void load_or_build(std::string const& cache_directory) noexcept;
+
         static constexpr Sample SIZE_INV = 1.0 / (Sample)SIZE;
 
+        void initialize_tables() noexcept;
+
         void initialize_tanh_tables(
             Byte const type,
             Number const steepness
@@ -159,11 +209,23 @@ class Tables
 
         void initialize_delay_feedback_tables() noexcept;
 
-        Table f_tables[TYPES];
-        Table F0_tables[TYPES];
+        std::atomic<int> load_state;
+
+        TableCache* table_cache;
+
+        /*
+        The f tables are followed by the F0 tables in a single block of memory,
+        which is either mapped from the cache, or owned by this object.
+        */
+        Table* owned_tables;
+        Table const* f_tables;
+        Table const* F0_tables;
 };
 
 
+extern Tables tables;
+
+
 /**
  * \brief Antialiased waveshaper based distortion, using Antiderivative
  *        Antialiasing (ADAA). See:
@@ -242,7 +304,7 @@ class Distortion : public Filter<InputSignalProducerClass>
             LevelBufferClass const& level
         ) noexcept;
 
-        Sample distort(
+        JS80P_INLINE Sample distort(
             Table const& f_table,
             Table const& F0_table,
             Sample const input_sample,
@@ -250,9 +312,20 @@ class Distortion : public Filter<InputSignalProducerClass>
             Sample& F0_previous_input_sample
         ) noexcept;
 
-        Sample f(Table const& f_table, Sample const x) const noexcept;
-        Sample F0(Table const& F0_table, Sample const x) const noexcept;
-        Sample lookup(Table const& table, Sample const x) const noexcept;
+        JS80P_INLINE Sample f(
+            Table const& f_table,
+            Sample const x
+        ) const noexcept;
+
+        JS80P_INLINE Sample F0(
+            Table const& F0_table,
+            Sample const x
+        ) const noexcept;
+
+        JS80P_INLINE Sample lookup(
+            Table const& table,
+            Sample const x
+        ) const noexcept;
 
         TypeParam const& type;
 
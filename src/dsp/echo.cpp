@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__ECHO_CPP
 #define JS80P__DSP__ECHO_CPP
 
+#include <algorithm>
+
 #include "dsp/echo.hpp"
 
 #include "dsp/math.hpp"
@@ -175,6 +177,15 @@ Echo<InputSignalProducerClass>::Echo(
 }
 
 
+template<class InputSignalProducerClass>
+void Echo<InputSignalProducerClass>::use_delay_buffer_arena(
+        DelayBufferArena& arena
+) noexcept {
+    comb_filter_1.delay.use_delay_buffer_arena(arena);
+    comb_filter_2.delay.use_delay_buffer_arena(arena);
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Echo<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -203,6 +214,24 @@ Sample const* const* Echo<InputSignalProducerClass>::initialize_rendering(
 }
 
 
+template<class InputSignalProducerClass>
+Seconds Echo<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    Seconds delay_time = this->delay_time.get_value();
+
+    if (tempo_sync.get_value() == ToggleParam::ON) {
+        delay_time *= (
+            Math::SECONDS_IN_ONE_MINUTE
+            / std::max(Delay<HighPassedInput>::BPM_MIN, this->bpm)
+        );
+    }
+
+    return this->calculate_feedback_tail_length(
+        delay_time, feedback.get_value()
+    );
+}
+
+
 template<class InputSignalProducerClass>
 void Echo<InputSignalProducerClass>::render(
         Integer const round,
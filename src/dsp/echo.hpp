@@ -63,6 +63,11 @@ class Echo : public SideChainCompressableEffect<InputSignalProducerClass>
             BiquadFilterSharedBuffers& high_shelf_filter_shared_buffers
         );
 
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena()
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
         FloatParamS delay_time;
         FloatParamS input_volume;
         FloatParamS feedback;
@@ -91,6 +96,8 @@ class Echo : public SideChainCompressableEffect<InputSignalProducerClass>
             Sample** const buffer
         ) noexcept JS80P_OVERRIDE;
 
+        virtual Seconds get_tail_length() const noexcept override;
+
     private:
         Distortion::TypeParam distortion_type;
         FloatParamS high_pass_filter_gain;
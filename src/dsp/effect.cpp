@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__EFFECT_CPP
 #define JS80P__DSP__EFFECT_CPP
 
+#include <cmath>
+
 #include "dsp/effect.hpp"
 
 
@@ -38,13 +40,57 @@ Effect<InputSignalProducerClass>::Effect(
         buffer_owner
     ),
     dry(name + "DRY", 0.0, 1.0, 1.0),
-    wet(name + "WET", 0.0, 1.0, 0.0)
+    wet(name + "WET", 0.0, 1.0, 0.0),
+    is_sleeping(false),
+    silent_input_samples(0)
 {
     this->register_child(dry);
     this->register_child(wet);
 }
 
 
+template<class InputSignalProducerClass>
+void Effect<InputSignalProducerClass>::reset() noexcept
+{
+    Filter<InputSignalProducerClass>::reset();
+
+    is_sleeping = false;
+    silent_input_samples = 0;
+}
+
+
+template<class InputSignalProducerClass>
+Seconds Effect<InputSignalProducerClass>::calculate_feedback_tail_length(
+        Seconds const delay_time,
+        Number const feedback
+) noexcept {
+    if (feedback >= 1.0) {
+        return TAIL_LENGTH_INFINITE;
+    }
+
+    /*
+    The input may be louder than 0 dBFS, and a reversed delay line may play a
+    pass late, so one extra pass is added for safety.
+    */
+    Number const passes = (
+        feedback < SignalProducer::SILENCE_THRESHOLD
+            ? 1.0
+            : std::ceil(
+                std::log(SignalProducer::SILENCE_THRESHOLD) / std::log(feedback)
+            )
+    );
+
+    return delay_time * (passes + 1.0);
+}
+
+
+template<class InputSignalProducerClass>
+Seconds Effect<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    return TAIL_LENGTH_INFINITE;
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Effect<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -52,6 +98,18 @@ Sample const* const* Effect<InputSignalProducerClass>::initialize_rendering(
 ) noexcept {
     Filter<InputSignalProducerClass>::initialize_rendering(round, sample_count);
 
+    if (this->input.is_silent(round, sample_count)) {
+        if (is_sleeping || should_sleep(sample_count)) {
+            is_sleeping = true;
+            this->mark_round_as_silent(round);
+
+            return this->input_buffer;
+        }
+    } else {
+        is_sleeping = false;
+        silent_input_samples = 0;
+    }
+
     dry_buffer = FloatParamS::produce_if_not_constant(dry, round, sample_count);
     wet_buffer = FloatParamS::produce_if_not_constant(wet, round, sample_count);
 
@@ -65,6 +123,39 @@ Sample const* const* Effect<InputSignalProducerClass>::initialize_rendering(
 }
 
 
+template<class InputSignalProducerClass>
+bool Effect<InputSignalProducerClass>::should_sleep(
+        Integer const sample_count
+) noexcept {
+    Seconds const tail_length = get_tail_length();
+
+    if (tail_length < 0.0) {
+        return false;
+    }
+
+    if ((Number)silent_input_samples < tail_length * this->sample_rate) {
+        silent_input_samples += sample_count;
+
+        return false;
+    }
+
+    /*
+    The tail is estimated from the current parameter values which might have
+    been different when the input was last audible, so the last rendered
+    block must be silent as well.
+    */
+    Integer last_sample_count;
+    Sample const* const* const last_block = this->get_last_rendered_block(
+        last_sample_count
+    );
+
+    return (
+        last_block == NULL
+        || this->is_silent(last_block, last_sample_count, this->channels)
+    );
+}
+
+
 template<class InputSignalProducerClass>
 void Effect<InputSignalProducerClass>::render(
         Integer const round,
@@ -44,10 +44,24 @@ class Effect : public Filter<InputSignalProducerClass>
             SignalProducer* const buffer_owner = NULL
         );
 
+        virtual void reset() noexcept override;
+
         FloatParamS dry;
         FloatParamS wet;
 
     protected:
+        static constexpr Seconds TAIL_LENGTH_INFINITE = -1.0;
+
+        /**
+         * \brief Calculate how long a delay line keeps producing sound after
+         *        its input became silent, if each pass through the line is
+         *        attenuated by \c feedback.
+         */
+        static Seconds calculate_feedback_tail_length(
+            Seconds const delay_time,
+            Number const feedback
+        ) noexcept;
+
         Sample const* const* initialize_rendering(
             Integer const round,
             Integer const sample_count
@@ -60,11 +74,27 @@ class Effect : public Filter<InputSignalProducerClass>
             Sample** const buffer
         ) noexcept JS80P_OVERRIDE;
 
+        /**
+         * \brief Tell how long the effect may keep producing sound after its
+         *        input became silent, based on the current values of its
+         *        parameters, or \c TAIL_LENGTH_INFINITE if the tail might
+         *        never end.
+         */
+        virtual Seconds get_tail_length() const noexcept;
+
         Sample const* wet_buffer;
         Sample const* dry_buffer;
         bool is_dry;
 
+        /*
+        A sleeping effect passes its silent input through without rendering
+        anything, until the input becomes audible again.
+        */
+        bool is_sleeping;
+
     private:
+        bool should_sleep(Integer const sample_count) noexcept;
+
         template<bool is_dry, class DryBufferClass, class WetBufferClass>
         void render(
             Integer const round,
@@ -74,6 +104,8 @@ class Effect : public Filter<InputSignalProducerClass>
             DryBufferClass const& dry,
             WetBufferClass const& wet
         ) const noexcept;
+
+        Integer silent_input_samples;
 };
 
 }
@@ -119,6 +119,14 @@ Effects<InputSignalProducerClass>::Effects(
     this->register_child(reverb);
     this->register_child(tape_2);
     this->register_child(volume_3);
+
+    tape_1.use_delay_buffer_arena(delay_buffer_arena);
+    chorus.use_delay_buffer_arena(delay_buffer_arena);
+    echo.use_delay_buffer_arena(delay_buffer_arena);
+    reverb.use_delay_buffer_arena(delay_buffer_arena);
+    tape_2.use_delay_buffer_arena(delay_buffer_arena);
+
+    delay_buffer_arena.allocate();
 }
 
 } }
@@ -24,6 +24,7 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.hpp"
+#include "dsp/delay_buffer_arena.hpp"
 #include "dsp/distortion.hpp"
 #include "dsp/echo.hpp"
 #include "dsp/filter.hpp"
@@ -81,6 +82,12 @@ using Volume3 = Gain< Tape2<InputSignalProducerClass> >;
 template<class InputSignalProducerClass>
 class Effects : public Filter< Volume3<InputSignalProducerClass> >
 {
+    private:
+        /*
+        Declared before the effects so that it outlives their delay lines.
+        */
+        DelayBufferArena delay_buffer_arena;
+
     public:
         static constexpr Integer CHANNELS = 2;
 
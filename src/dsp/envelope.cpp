@@ -24,6 +24,7 @@
 
 #include "dsp/envelope.hpp"
 
+#include "dsp/cpu.hpp"
 #include "dsp/math.hpp"
 #include "dsp/signal_producer.hpp"
 
@@ -378,7 +379,6 @@ void Envelope::render(
     );
 
     Number rendered_value = last_rendered_value;
-    Number done_samples = 0.0;
     Number initial_ratio;
     Number delta;
 
@@ -412,30 +412,53 @@ void Envelope::render(
         );
     }
 
-    for (
-            ;
-            next_sample_index != end_index;
-            ++next_sample_index, done_samples += 1.0
-    ) {
-        if constexpr (need_shaping) {
-            Number const ratio = Math::apply_envelope_shape(
-                (Math::EnvelopeShape)shape, initial_ratio + done_samples * scale
-            );
-
-            rendered_value = initial_value + ratio * delta;
-        } else {
-            Number const ratio = initial_ratio + done_samples * scale;
+    Integer const begin_index = next_sample_index;
+    Number const start_value = initial_value;
 
-            rendered_value = initial_value + ratio * delta;
+    /*
+    The whole segment until the next stage boundary (or the end of the block)
+    is filled by a loop whose iterations only depend on the sample index, so
+    that it can be vectorized, then the last value is calculated separately.
+    */
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            Number x = 0.0;
+
+            for (Integer i = begin_index; i != end_index; ++i, x += 1.0) {
+                Number ratio = initial_ratio + x * scale;
+
+                if constexpr (need_shaping) {
+                    ratio = Math::apply_envelope_shape(
+                        (Math::EnvelopeShape)shape, ratio
+                    );
+                }
+
+                Number const value = start_value + ratio * delta;
+
+                if constexpr (rendering_mode == RenderingMode::OVERWRITE) {
+                    buffer[i] = value;
+                } else {
+                    buffer[i] *= value;
+                }
+            }
         }
+    );
 
-        if constexpr (rendering_mode == RenderingMode::OVERWRITE) {
-            buffer[next_sample_index] = rendered_value;
-        } else {
-            buffer[next_sample_index] *= rendered_value;
+    Number const done_samples = (Number)(end_index - begin_index);
+
+    if (done_samples > 0.0) {
+        Number ratio = initial_ratio + (done_samples - 1.0) * scale;
+
+        if constexpr (need_shaping) {
+            ratio = Math::apply_envelope_shape(
+                (Math::EnvelopeShape)shape, ratio
+            );
         }
+
+        rendered_value = initial_value + ratio * delta;
     }
 
+    next_sample_index = end_index;
     last_rendered_value = rendered_value;
     time += done_samples * sampling_period;
 }
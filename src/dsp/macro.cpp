@@ -56,14 +56,20 @@ Macro::Macro(std::string const& name, Number const input_default_value) noexcept
     distortion_change_indices{},
     randomness_change_indices{},
     distortion_curve_change_indices{},
-    is_updating(false)
+    locked_midi_channel(0),
+    is_updating(false),
+    is_locked(false)
 {
 }
 
 
 void Macro::update(Midi::Channel const midi_channel) noexcept
 {
-    if (is_updating) {
+    /*
+    Voices which are rendered in parallel only ever use the locked channel, so
+    they must not touch anything else here.
+    */
+    if ((is_locked && midi_channel == locked_midi_channel) || is_updating) {
         return;
     }
 
@@ -106,6 +112,45 @@ void Macro::update(Midi::Channel const midi_channel) noexcept
 }
 
 
+void Macro::update_and_lock(Midi::Channel const midi_channel) noexcept
+{
+    is_locked = false;
+    update(midi_channel);
+    locked_midi_channel = midi_channel;
+    is_locked = true;
+}
+
+
+void Macro::unlock() noexcept
+{
+    is_locked = false;
+}
+
+
+Integer Macro::get_dependencies(Macro** const dependencies) const noexcept
+{
+    Macro* const macros[PARAMS] = {
+        midpoint.get_macro(),
+        input.get_macro(),
+        min.get_macro(),
+        max.get_macro(),
+        scale.get_macro(),
+        distortion.get_macro(),
+        randomness.get_macro(),
+        distortion_curve.get_macro(),
+    };
+    Integer count = 0;
+
+    for (Integer i = 0; i != PARAMS; ++i) {
+        if (macros[i] != NULL) {
+            dependencies[count++] = macros[i];
+        }
+    }
+
+    return count;
+}
+
+
 bool Macro::update_change_indices(Midi::Channel const midi_channel) noexcept
 {
     bool is_dirty;
@@ -71,6 +71,24 @@ class Macro : public MidiController
 
         void update(Midi::Channel const midi_channel) noexcept;
 
+        /**
+         * \brief Update the macro for the given MIDI channel, then skip
+         *        further updates on that channel until \c unlock() is called.
+         *        Use this when nothing which could affect the macro on that
+         *        channel may change before unlocking it, and all the macros
+         *        that control this one have already been updated.
+         */
+        void update_and_lock(Midi::Channel const midi_channel) noexcept;
+
+        void unlock() noexcept;
+
+        /**
+         * \brief Collect the macros which control the parameters of this
+         *        macro into \c dependencies (which must have room for at
+         *        least \c PARAMS items), and return their number.
+         */
+        Integer get_dependencies(Macro** const dependencies) const noexcept;
+
         FloatParamB midpoint;
         FloatParamB input;
         FloatParamB min;
@@ -98,7 +116,9 @@ class Macro : public MidiController
         Integer distortion_change_indices[Midi::CHANNELS];
         Integer randomness_change_indices[Midi::CHANNELS];
         Integer distortion_curve_change_indices[Midi::CHANNELS];
+        Midi::Channel locked_midi_channel;
         bool is_updating;
+        bool is_locked;
 };
 
 }
@@ -92,6 +92,50 @@ T const& Math::RNG::random_choice(std::array<T, N> const& options) noexcept
 }
 
 
+uint64_t Math::RNG::make_stream_seed() noexcept
+{
+    uint64_t seed = 0;
+
+    for (int i = 0; i != 4; ++i) {
+        random();
+        seed = (seed << 16) | (uint64_t)x;
+    }
+
+    return seed;
+}
+
+
+Math::CounterBasedRNG::CounterBasedRNG(uint64_t const seed) noexcept
+    : seed(seed)
+{
+    reset();
+}
+
+
+void Math::CounterBasedRNG::reset() noexcept
+{
+    counter = 0;
+}
+
+
+Number Math::CounterBasedRNG::random() noexcept
+{
+    /*
+    https://en.wikipedia.org/wiki/Counter-based_random_number_generator
+
+    The hash is the finalizer of SplitMix64, applied to a Weyl sequence.
+    */
+
+    uint64_t z = seed + (++counter) * 0x9e3779b97f4a7c15;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    z = z ^ (z >> 31);
+
+    return (Number)(z >> 32) * SCALE;
+}
+
+
 Math::Math() noexcept
 {
     JS80P_ASSERT(Math::is_close(SQRT_OF_2, std::sqrt(2.0)));
@@ -605,6 +649,18 @@ void Math::sincos(Number const x, Number& sin, Number& cos) noexcept
 }
 
 
+void Math::sincos(Number const x, float& sin, float& cos) noexcept
+{
+    Number sin_double;
+    Number cos_double;
+
+    math.sincos_impl(x, sin_double, cos_double);
+
+    sin = (float)sin_double;
+    cos = (float)cos_double;
+}
+
+
 void Math::sincos_impl(Number const x, Number& sin, Number& cos) const noexcept
 {
     Number const index = x * SINE_SCALE;
@@ -899,9 +955,9 @@ Number Math::lookup(
 }
 
 
-template<bool is_index_positive>
+template<bool is_index_positive, typename TableType>
 Number Math::lookup_periodic(
-        Number const* const table,
+        TableType const* const table,
         int const table_size,
         Number const index
 ) noexcept {
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "js80p.hpp"
@@ -80,6 +81,11 @@ class Math
                     std::array<T, N> const& options
                 ) noexcept;
 
+                /**
+                 * \brief Generate a seed for a \c CounterBasedRNG stream.
+                 */
+                uint64_t make_stream_seed() noexcept;
+
             private:
                 static constexpr Number SCALE = 1.0 / 65536.0;
 
@@ -89,6 +95,29 @@ class Math
                 unsigned int c;
         };
 
+        /**
+         * \brief The nth number of a stream is a hash of the seed and n, so
+         *        streams with different seeds are independent of each other,
+         *        regardless of how many numbers have been taken from them and
+         *        in what order.
+         */
+        class CounterBasedRNG
+        {
+            public:
+                explicit CounterBasedRNG(uint64_t const seed) noexcept;
+
+                void reset() noexcept;
+
+                JS80P_INLINE Number random() noexcept;
+
+            private:
+                static constexpr Number SCALE = 1.0 / 4294967296.0;
+
+                uint64_t const seed;
+
+                uint64_t counter;
+        };
+
         static constexpr int DISTORTIONS = 4;
 
         static constexpr Number PI = (
@@ -239,6 +268,12 @@ class Math
          */
         static void sincos(Number const x, Number& sin, Number& cos) noexcept;
 
+        /**
+         * \brief Same as \c sincos(), but for storing the results in single
+         *        precision variables, e.g. when rendering \c float samples.
+         */
+        static void sincos(Number const x, float& sin, float& cos) noexcept;
+
         static constexpr Number exp(Number const x) noexcept;
         static constexpr Number pow_10(Number const x) noexcept;
         static constexpr Number pow_10_inv(Number const x) noexcept;
@@ -370,7 +405,7 @@ class Math
         /**
          * \brief Apply the given shaping function to an envelope value.
          */
-        static Number apply_envelope_shape(
+        static JS80P_INLINE Number apply_envelope_shape(
             EnvelopeShape const shape,
             Number const value
         ) noexcept;
@@ -381,7 +416,7 @@ class Math
          *        than or equal to \c max_index, then the last element of the
          *        table is returned.
          */
-        static Number lookup(
+        static JS80P_INLINE Number lookup(
             Number const* const table,
             int const max_index,
             Number const index
@@ -393,9 +428,9 @@ class Math
          *        is greater than or equal to the specified \c table_size, then
          *        it wraps around.
          */
-        template<bool is_index_positive = false>
+        template<bool is_index_positive = false, typename TableType = Number>
         static Number lookup_periodic(
-            Number const* const table,
+            TableType const* const table,
             int const table_size,
             Number const index
         ) noexcept;
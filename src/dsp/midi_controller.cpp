@@ -29,22 +29,22 @@ namespace JS80P
 
 MidiController::MidiController() noexcept
     : event_queues_rw{
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
-        Queue<SignalProducer::Event>{32},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
+        RingQueue<SignalProducer::Event>{EVENTS_PER_CHANNEL},
     },
     change_indices{},
     assignments(0),
@@ -61,7 +61,7 @@ void MidiController::change(
 ) noexcept {
     SignalProducer::Event event(EVT_CHANGE, time_offset, 0, new_value, 0.0);
 
-    event_queues_rw[channel].push(event);
+    push(channel, event);
     change(channel, new_value);
 }
 
@@ -73,12 +73,24 @@ void MidiController::change_all_channels(
     SignalProducer::Event event(EVT_CHANGE, time_offset, 0, new_value, 0.0);
 
     for (Midi::Channel channel = 0; channel != Midi::CHANNELS; ++channel) {
-        event_queues_rw[channel].push(event);
+        push(channel, event);
         change(channel, new_value);
     }
 }
 
 
+void MidiController::push(
+        Midi::Channel const channel,
+        SignalProducer::Event const& event
+) noexcept {
+    RingQueue<SignalProducer::Event>& event_queue = event_queues_rw[channel];
+
+    if (JS80P_UNLIKELY(!event_queue.push(event))) {
+        event_queue.back() = event;
+    }
+}
+
+
 Integer MidiController::get_change_index(
         Midi::Channel const channel
 ) const noexcept {
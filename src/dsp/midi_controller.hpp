@@ -37,6 +37,13 @@ class MidiController
     public:
         static constexpr SignalProducer::Event::Type EVT_CHANGE = 1;
 
+        /*
+        When more changes arrive on a channel during a single round than this,
+        then the last queued event is overwritten, so that parameters always
+        end up with the latest value.
+        */
+        static constexpr Integer EVENTS_PER_CHANNEL = 32;
+
         MidiController() noexcept;
 
         /**
@@ -76,13 +83,18 @@ class MidiController
         ) noexcept;
 
     private:
-        Queue<SignalProducer::Event> event_queues_rw[Midi::CHANNELS];
+        void push(
+            Midi::Channel const channel,
+            SignalProducer::Event const& event
+        ) noexcept;
+
+        RingQueue<SignalProducer::Event> event_queues_rw[Midi::CHANNELS];
         Integer change_indices[Midi::CHANNELS];
         Number values[Midi::CHANNELS];
         Integer assignments;
 
     public:
-        Queue<SignalProducer::Event> const* const event_queues;
+        RingQueue<SignalProducer::Event> const* const event_queues;
 };
 
 }
@@ -0,0 +1,731 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__MULTI_TAP_DELAY_CPP
+#define JS80P__DSP__MULTI_TAP_DELAY_CPP
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/multi_tap_delay.hpp"
+
+
+namespace JS80P
+{
+
+template<class InputSignalProducerClass, Integer taps>
+MultiTapDelay<InputSignalProducerClass, taps>::MultiTapDelay(
+        InputSignalProducerClass& input,
+        FloatParamS& panning,
+        FloatParamS* const times,
+        ToggleParam const* const tempo_sync
+) noexcept
+    : Filter<InputSignalProducerClass>(input, 0, CHANNELS),
+    tempo_sync(tempo_sync),
+    panning(panning),
+    times(times),
+    time_max(find_time_max(times)),
+    delay_buffer_oversize(
+        tempo_sync != NULL ? OVERSIZE_DELAY_BUFFER_FOR_TEMPO_SYNC : 1
+    ),
+    feedback_signal_producer(NULL),
+    delay_buffer_arena_region(NULL),
+    delay_buffer(NULL),
+    panning_buffer(NULL),
+    time_scale(0.0),
+    delay_buffer_size_float(0.0),
+    delay_buffer_size(0),
+    read_index(0),
+    write_index_input(0),
+    write_index_feedback(0),
+    clear_index(0),
+    silent_input_samples(0),
+    silent_feedback_samples(0),
+    previous_round(-1),
+    rendered_taps(0),
+    is_starting(true)
+{
+    static_assert(taps > 0, "A multi-tap delay needs at least one tap");
+
+    for (Integer t = 0; t != taps; ++t) {
+        time_buffers[t] = NULL;
+        panning_scale[t] = 1.0;
+        weight[t] = 0.0;
+        time_in_samples[t] = 0.0;
+
+        for (Integer k = 0; k != 4; ++k) {
+            panning_matrix[t][k] = 0.0;
+        }
+    }
+
+    reallocate_delay_buffer_if_needed();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+Seconds MultiTapDelay<InputSignalProducerClass, taps>::find_time_max(
+        FloatParamS const* const times
+) noexcept {
+    Seconds time_max = 0.0;
+
+    for (Integer t = 0; t != taps; ++t) {
+        time_max = std::max(time_max, (Seconds)times[t].get_max_value());
+    }
+
+    return time_max;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+MultiTapDelay<InputSignalProducerClass, taps>::~MultiTapDelay()
+{
+    free_delay_buffer();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::set_sample_rate(
+        Frequency const new_sample_rate
+) noexcept {
+    Filter<InputSignalProducerClass>::set_sample_rate(new_sample_rate);
+
+    reallocate_delay_buffer_if_needed();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    if (new_block_size == this->block_size) {
+        return;
+    }
+
+    Filter<InputSignalProducerClass>::set_block_size(new_block_size);
+
+    reallocate_delay_buffer_if_needed();
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::reset() noexcept
+{
+    Filter<InputSignalProducerClass>::reset();
+
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer_arena_region->clear();
+    } else {
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            std::fill_n(delay_buffer[c], delay_buffer_size, 0.0);
+        }
+    }
+
+    write_index_input = 0;
+    silent_input_samples = delay_buffer_size;
+
+    write_index_feedback = 0;
+    silent_feedback_samples = delay_buffer_size;
+
+    clear_index = this->block_size;
+    is_starting = true;
+    previous_round = -1;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::set_feedback_signal_producer(
+        SignalProducer& feedback_signal_producer
+) noexcept {
+    this->feedback_signal_producer = &feedback_signal_producer;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::use_delay_buffer_arena(
+        DelayBufferArena& arena
+) noexcept {
+    if (delay_buffer_arena_region != NULL) {
+        return;
+    }
+
+    delay_buffer_arena_region = arena.reserve(
+        CHANNELS,
+        calculate_delay_buffer_size(
+            DelayBufferArena::SAMPLE_RATE_MAX, DelayBufferArena::BLOCK_SIZE_MAX
+        )
+    );
+
+    if (delay_buffer_size <= delay_buffer_arena_region->capacity) {
+        /* See Delay::use_delay_buffer_arena() */
+        free_delay_buffer();
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size);
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::set_tap(
+        Integer const tap,
+        Number const panning_scale,
+        Number const weight
+) noexcept {
+    JS80P_ASSERT(0 <= tap && tap < taps);
+
+    this->panning_scale[tap] = panning_scale;
+    this->weight[tap] = weight;
+
+    rendered_taps = 0;
+
+    for (Integer t = 0; t != taps; ++t) {
+        if (this->weight[t] > SILENCE_WEIGHT) {
+            rendered_taps = t + 1;
+        }
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+Integer MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::calculate_delay_buffer_size(
+        Frequency const sample_rate,
+        Integer const block_size
+) const noexcept {
+    return block_size * 2 + std::max(
+        (Integer)(sample_rate * time_max) + 1, block_size
+    ) * delay_buffer_oversize;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::reallocate_delay_buffer_if_needed() noexcept {
+    Integer const new_delay_buffer_size = calculate_delay_buffer_size(
+        this->sample_rate, this->block_size
+    );
+
+    if (new_delay_buffer_size != delay_buffer_size) {
+        free_delay_buffer();
+        delay_buffer_size = new_delay_buffer_size;
+        delay_buffer_size_float = (Number)delay_buffer_size;
+        allocate_delay_buffer();
+        reset();
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::allocate_delay_buffer(
+) noexcept {
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer_size <= delay_buffer_arena_region->capacity
+    ) {
+        delay_buffer = delay_buffer_arena_region->buffer;
+        delay_buffer_arena_region->use(delay_buffer_size);
+
+        return;
+    }
+
+    delay_buffer = new Sample*[CHANNELS];
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        delay_buffer[c] = new Sample[delay_buffer_size];
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::free_delay_buffer(
+) noexcept {
+    if (delay_buffer == NULL) {
+        return;
+    }
+
+    if (
+            delay_buffer_arena_region != NULL
+            && delay_buffer == delay_buffer_arena_region->buffer
+    ) {
+        delay_buffer = NULL;
+
+        return;
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        delete[] delay_buffer[c];
+
+        delay_buffer[c] = NULL;
+    }
+
+    delete[] delay_buffer;
+
+    delay_buffer = NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+Sample const* const* MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::initialize_rendering(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    JS80P_ASSERT(this->input.get_channels() == CHANNELS);
+
+    Filter<InputSignalProducerClass>::initialize_rendering(round, sample_count);
+
+    read_index = write_index_input;
+
+    clear_delay_buffer(sample_count);
+    mix_feedback_into_delay_buffer(sample_count);
+    mix_input_into_delay_buffer(round, sample_count);
+
+    previous_round = round;
+
+    for (Integer t = 0; t != taps; ++t) {
+        time_buffers[t] = (
+            weight[t] > SILENCE_WEIGHT
+                ? FloatParamS::produce_if_not_constant(
+                    times[t], round, sample_count
+                )
+                : NULL
+        );
+    }
+
+    time_scale = (
+        tempo_sync != NULL && tempo_sync->get_value() == ToggleParam::ON
+            ? (
+                Math::SECONDS_IN_ONE_MINUTE / std::max(BPM_MIN, this->bpm)
+            ) * this->sample_rate
+            : this->sample_rate
+    );
+
+    initialize_panning(round, sample_count);
+
+    if (rendered_taps == 0 || is_delay_buffer_silent()) {
+        /*
+        The buffer may be shared with other signal producers which render into
+        it, so it cannot be assumed to stay silent between rounds.
+        */
+        this->render_silence(round, 0, sample_count, this->buffer);
+        this->mark_round_as_silent(round);
+
+        return this->buffer;
+    }
+
+    for (Integer t = 0; t != taps; ++t) {
+        time_in_samples[t] = times[t].get_value() * time_scale;
+    }
+
+    return NULL;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+Integer MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::advance_delay_buffer_index(
+        Integer const position,
+        Integer const increment
+) const noexcept {
+    Integer const new_position = position + increment;
+
+    return (
+        JS80P_UNLIKELY(new_position >= delay_buffer_size)
+            ? new_position % delay_buffer_size
+            : new_position
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::write_delay_buffer(
+        Sample const* const* const source_buffer,
+        Integer& delay_buffer_index,
+        Integer const sample_count
+) noexcept {
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer index = delay_buffer_index;
+
+    for (Integer i = 0; i != sample_count;) {
+        Integer const batch_size = std::min(
+            sample_count - i, delay_buffer_size - index
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            Sample* const delay_channel = delay_buffer[c] + index;
+
+            if (source_buffer == NULL) {
+                std::fill_n(delay_channel, batch_size, 0.0);
+            } else {
+                Sample const* const source_channel = source_buffer[c] + i;
+
+                for (Integer j = 0; j != batch_size; ++j) {
+                    delay_channel[j] += source_channel[j];
+                }
+            }
+        }
+
+        i += batch_size;
+        index += batch_size;
+
+        if (JS80P_UNLIKELY(index == delay_buffer_size)) {
+            index = 0;
+        }
+    }
+
+    delay_buffer_index = index;
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::clear_delay_buffer(
+        Integer const sample_count
+) noexcept {
+    write_delay_buffer(NULL, clear_index, sample_count);
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::mix_feedback_into_delay_buffer(
+        Integer const sample_count
+) noexcept {
+    if (JS80P_UNLIKELY(feedback_signal_producer == NULL)) {
+        is_starting = false;
+        return;
+    }
+
+    if (JS80P_UNLIKELY(is_starting)) {
+        is_starting = false;
+        write_index_feedback = advance_delay_buffer_index(
+            write_index_feedback, sample_count
+        );
+
+        if (silent_feedback_samples < delay_buffer_size) {
+            silent_feedback_samples += sample_count;
+        }
+
+        return;
+    }
+
+    Integer feedback_sample_count = 0;
+
+    Sample const* const* const feedback_signal_producer_buffer = (
+        feedback_signal_producer->get_last_rendered_block(
+            feedback_sample_count
+        )
+    );
+
+    if (
+            feedback_signal_producer->is_silent(
+                previous_round, feedback_sample_count
+            )
+    ) {
+        write_index_feedback = advance_delay_buffer_index(
+            write_index_feedback, feedback_sample_count
+        );
+
+        if (silent_feedback_samples < delay_buffer_size) {
+            silent_feedback_samples += feedback_sample_count;
+        }
+
+        return;
+    }
+
+    silent_feedback_samples = 0;
+
+    write_delay_buffer(
+        feedback_signal_producer_buffer,
+        write_index_feedback,
+        feedback_sample_count
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::mix_input_into_delay_buffer(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (this->input.is_silent(round, sample_count)) {
+        write_index_input = advance_delay_buffer_index(
+            write_index_input, sample_count
+        );
+
+        if (silent_input_samples < delay_buffer_size) {
+            silent_input_samples += sample_count;
+        }
+
+        return;
+    }
+
+    silent_input_samples = 0;
+
+    write_delay_buffer(this->input_buffer, write_index_input, sample_count);
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+bool MultiTapDelay<
+        InputSignalProducerClass,
+        taps
+>::is_delay_buffer_silent() const noexcept
+{
+    return (
+        silent_input_samples >= delay_buffer_size
+        && silent_feedback_samples >= delay_buffer_size
+    );
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::initialize_panning(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    panning_buffer = FloatParamS::produce_if_not_constant(
+        panning, round, sample_count
+    );
+
+    if (panning_buffer != NULL) {
+        return;
+    }
+
+    Number const panning_value = panning.get_value();
+
+    for (Integer t = 0; t != taps; ++t) {
+        calculate_panning_matrix(
+            panning_value * panning_scale[t], weight[t], panning_matrix[t]
+        );
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::calculate_panning_matrix(
+        Number const panning_value,
+        Number const weight,
+        Sample matrix[4]
+) const noexcept {
+    /* https://www.w3.org/TR/webaudio/#stereopanner-algorithm */
+    Number const x = (
+        (panning_value <= 0.0 ? panning_value + 1.0 : panning_value)
+        * Math::PI_HALF
+    );
+
+    Number sin_x;
+    Number cos_x;
+
+    Math::sincos(x, sin_x, cos_x);
+
+    if (panning_value > 0.0) {
+        matrix[0] = weight * cos_x;
+        matrix[1] = 0.0;
+        matrix[2] = weight * sin_x;
+        matrix[3] = weight;
+    } else {
+        matrix[0] = weight;
+        matrix[1] = weight * cos_x;
+        matrix[2] = 0.0;
+        matrix[3] = weight * sin_x;
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+void MultiTapDelay<InputSignalProducerClass, taps>::render(
+        Integer const round,
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample** const buffer
+) noexcept {
+    if (panning_buffer == NULL) {
+        render<true>(first_sample_index, end_sample_index, buffer);
+    } else {
+        render<false>(first_sample_index, end_sample_index, buffer);
+    }
+}
+
+
+template<class InputSignalProducerClass, Integer taps>
+template<bool is_panning_constant>
+void MultiTapDelay<InputSignalProducerClass, taps>::render(
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample** const buffer
+) noexcept {
+    Sample const* const delay_left = delay_buffer[0];
+    Sample const* const delay_right = delay_buffer[1];
+    Sample const* const panning_buffer = this->panning_buffer;
+    Number const read_index = (Number)this->read_index;
+    Number const time_scale = this->time_scale;
+    Number const delay_buffer_size_float = this->delay_buffer_size_float;
+    Integer const delay_buffer_size = this->delay_buffer_size;
+    Integer const rendered_taps = this->rendered_taps;
+
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            Sample* const out_left = buffer[0];
+            Sample* const out_right = buffer[1];
+
+            for (Integer i = first_sample_index; i != end_sample_index; ++i) {
+                out_left[i] = 0.0;
+                out_right[i] = 0.0;
+            }
+
+            for (Integer t = 0; t != rendered_taps; ++t) {
+                Number const weight = this->weight[t];
+
+                if (weight <= SILENCE_WEIGHT) {
+                    continue;
+                }
+
+                Sample const* const time_buffer = time_buffers[t];
+                Number const panning_scale = this->panning_scale[t];
+                Sample matrix[4] = {
+                    panning_matrix[t][0],
+                    panning_matrix[t][1],
+                    panning_matrix[t][2],
+                    panning_matrix[t][3],
+                };
+
+                if (time_buffer == NULL) {
+                    /*
+                    The read position advances one sample at a time, so the
+                    interpolation weight stays the same for the whole block.
+                    */
+                    Number position = (
+                        read_index
+                        + (Number)first_sample_index
+                        - time_in_samples[t]
+                    );
+
+                    if (position < 0.0) {
+                        position += delay_buffer_size_float;
+                    }
+
+                    Number const position_floor = std::floor(position);
+                    Sample const after_weight = position - position_floor;
+                    Integer before = (Integer)position_floor;
+
+                    if (before >= delay_buffer_size) {
+                        before -= delay_buffer_size;
+                    }
+
+                    for (
+                            Integer i = first_sample_index;
+                            i != end_sample_index;
+                            ++i
+                    ) {
+                        Integer const after = (
+                            before + 1 == delay_buffer_size ? 0 : before + 1
+                        );
+                        Sample const left = Math::combine(
+                            after_weight, delay_left[after], delay_left[before]
+                        );
+                        Sample const right = Math::combine(
+                            after_weight,
+                            delay_right[after],
+                            delay_right[before]
+                        );
+
+                        if constexpr (!is_panning_constant) {
+                            calculate_panning_matrix(
+                                panning_buffer[i] * panning_scale,
+                                weight,
+                                matrix
+                            );
+                        }
+
+                        out_left[i] += matrix[0] * left + matrix[1] * right;
+                        out_right[i] += matrix[2] * left + matrix[3] * right;
+
+                        before = after;
+                    }
+                } else {
+                    for (
+                            Integer i = first_sample_index;
+                            i != end_sample_index;
+                            ++i
+                    ) {
+                        Number position = (
+                            read_index + (Number)i - time_buffer[i] * time_scale
+                        );
+
+                        if (position < 0.0) {
+                            position += delay_buffer_size_float;
+                        }
+
+                        Number const position_floor = std::floor(position);
+                        Sample const after_weight = position - position_floor;
+                        Integer before = (Integer)position_floor;
+
+                        if (before >= delay_buffer_size) {
+                            before -= delay_buffer_size;
+                        }
+
+                        Integer const after = (
+                            before + 1 == delay_buffer_size ? 0 : before + 1
+                        );
+                        Sample const left = Math::combine(
+                            after_weight, delay_left[after], delay_left[before]
+                        );
+                        Sample const right = Math::combine(
+                            after_weight,
+                            delay_right[after],
+                            delay_right[before]
+                        );
+
+                        if constexpr (!is_panning_constant) {
+                            calculate_panning_matrix(
+                                panning_buffer[i] * panning_scale,
+                                weight,
+                                matrix
+                            );
+                        }
+
+                        out_left[i] += matrix[0] * left + matrix[1] * right;
+                        out_right[i] += matrix[2] * left + matrix[3] * right;
+                    }
+                }
+            }
+        }
+    );
+}
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__DSP__MULTI_TAP_DELAY_HPP
+#define JS80P__DSP__MULTI_TAP_DELAY_HPP
+
+#include "js80p.hpp"
+
+#include "dsp/cpu.hpp"
+#include "dsp/delay_buffer_arena.hpp"
+#include "dsp/filter.hpp"
+#include "dsp/math.hpp"
+#include "dsp/param.hpp"
+#include "dsp/signal_producer.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A stereo delay line with multiple taps which have their own delay
+ *        time, panning, and output weight, and which are mixed together.
+ *
+ * Each tap renders the same signal as a \c StereoPannedDelay whose \c Delay
+ * uses a shared delay buffer (see \c Delay::use_shared_delay_buffer() ), but
+ * the input and the feedback are written into the buffer only once, and the
+ * taps are read, panned, and mixed directly into the output, without
+ * rendering a separate buffer for each of them.
+ */
+template<class InputSignalProducerClass, Integer taps>
+class MultiTapDelay : public Filter<InputSignalProducerClass>
+{
+    friend class SignalProducer;
+
+    private:
+        /* See Delay::OVERSIZE_DELAY_BUFFER_FOR_TEMPO_SYNC */
+        static constexpr Integer OVERSIZE_DELAY_BUFFER_FOR_TEMPO_SYNC = 2;
+
+    public:
+        static constexpr Integer CHANNELS = 2;
+        static constexpr Integer TAPS = taps;
+
+        static constexpr Number BPM_MIN = (
+            Math::SECONDS_IN_ONE_MINUTE
+            / (Number)OVERSIZE_DELAY_BUFFER_FOR_TEMPO_SYNC
+        );
+
+        /**
+         * \warning The \c times array must contain a delay time parameter for
+         *          each tap, and it must outlive the \c MultiTapDelay.
+         */
+        MultiTapDelay(
+            InputSignalProducerClass& input,
+            FloatParamS& panning,
+            FloatParamS* const times,
+            ToggleParam const* const tempo_sync = NULL
+        ) noexcept;
+
+        virtual ~MultiTapDelay();
+
+        virtual void set_sample_rate(
+            Frequency const new_sample_rate
+        ) noexcept override;
+
+        virtual void set_block_size(
+            Integer const new_block_size
+        ) noexcept override;
+
+        virtual void reset() noexcept override;
+
+        /**
+         * \brief See \c Delay::set_feedback_signal_producer()
+         */
+        void set_feedback_signal_producer(
+            SignalProducer& feedback_signal_producer
+        ) noexcept;
+
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena()
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
+        /**
+         * \brief Configure a tap. A tap with zero weight is not rendered, and
+         *        its delay time parameter is not evaluated either.
+         */
+        void set_tap(
+            Integer const tap,
+            Number const panning_scale,
+            Number const weight
+        ) noexcept;
+
+        ToggleParam const* const tempo_sync;
+
+    protected:
+        Sample const* const* initialize_rendering(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept JS80P_OVERRIDE;
+
+        void render(
+            Integer const round,
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample** const buffer
+        ) noexcept JS80P_OVERRIDE;
+
+    private:
+        static constexpr Number SILENCE_WEIGHT = 0.000001;
+
+        static Seconds find_time_max(FloatParamS const* const times) noexcept;
+
+        Integer calculate_delay_buffer_size(
+            Frequency const sample_rate,
+            Integer const block_size
+        ) const noexcept;
+
+        void reallocate_delay_buffer_if_needed() noexcept;
+        void allocate_delay_buffer() noexcept;
+        void free_delay_buffer() noexcept;
+
+        void write_delay_buffer(
+            Sample const* const* const source_buffer,
+            Integer& delay_buffer_index,
+            Integer const sample_count
+        ) noexcept;
+
+        void clear_delay_buffer(Integer const sample_count) noexcept;
+        void mix_feedback_into_delay_buffer(
+            Integer const sample_count
+        ) noexcept;
+        void mix_input_into_delay_buffer(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        Integer advance_delay_buffer_index(
+            Integer const position,
+            Integer const increment
+        ) const noexcept;
+
+        bool is_delay_buffer_silent() const noexcept;
+
+        void initialize_panning(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        JS80P_INLINE void calculate_panning_matrix(
+            Number const panning_value,
+            Number const weight,
+            Sample matrix[4]
+        ) const noexcept;
+
+        template<bool is_panning_constant>
+        void render(
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample** const buffer
+        ) noexcept;
+
+        FloatParamS& panning;
+        FloatParamS* const times;
+        Seconds const time_max;
+        Integer const delay_buffer_oversize;
+
+        SignalProducer* feedback_signal_producer;
+        DelayBufferArena::Region* delay_buffer_arena_region;
+        Sample** delay_buffer;
+
+        Sample const* time_buffers[taps];
+        Sample const* panning_buffer;
+
+        /*
+        The contributions of the left and right channels of each tap to the
+        left output, then the same for the right output, with the weight of
+        the tap included.
+        */
+        Sample panning_matrix[taps][4];
+
+        Number panning_scale[taps];
+        Number weight[taps];
+        Number time_in_samples[taps];
+
+        Number time_scale;
+        Number delay_buffer_size_float;
+        Integer delay_buffer_size;
+        Integer read_index;
+        Integer write_index_input;
+        Integer write_index_feedback;
+        Integer clear_index;
+        Integer silent_input_samples;
+        Integer silent_feedback_samples;
+        Integer previous_round;
+        Integer rendered_taps;
+
+        bool is_starting;
+};
+
+}
+
+#endif
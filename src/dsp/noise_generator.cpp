@@ -42,7 +42,7 @@ NoiseGenerator<InputSignalProducerClass, LevelParamClass>::NoiseGenerator(
     high_pass_frequency(high_pass_frequency),
     low_pass_frequency(low_pass_frequency),
     level(level),
-    rng(rng),
+    rng(rng.make_stream_seed()),
     is_on_(false)
 {
     this->register_child(this->level);
@@ -263,6 +263,7 @@ void NoiseGenerator<InputSignalProducerClass, LevelParamClass>::advance_clock(
 ) noexcept {
     if (JS80P_UNLIKELY(this->has_events())) {
         this->current_time += (Seconds)sample_count * this->sampling_period;
+        this->current_sample += sample_count;
     }
 }
 
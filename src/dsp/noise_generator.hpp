@@ -37,10 +37,9 @@ namespace JS80P
  * \brief Generate pseudo-random noise that is filtered to fall between the
  *        given frequency range.
  *
- * \warning When multiple instances of \c NoiseGenerator are used, make sure to
- *          pass the same \c Math::RNG instance to all of them in order to avoid
- *          different noise sources generating phase-shifted versions of the
- *          same pattern.
+ * \note Each instance generates its own independent stream of random numbers
+ *       that is seeded from the given \c Math::RNG, so the output of an
+ *       instance doesn't depend on what the other instances have rendered.
  */
 template<class InputSignalProducerClass, class LevelParamClass = FloatParamB>
 class NoiseGenerator : public Filter<InputSignalProducerClass>
@@ -121,7 +120,7 @@ class NoiseGenerator : public Filter<InputSignalProducerClass>
             Sample** const buffer
         ) noexcept;
 
-        Math::RNG& rng;
+        Math::CounterBasedRNG rng;
         Sample const* level_buffer;
         Sample* r_n_m1;
         Sample* x_n_m1;
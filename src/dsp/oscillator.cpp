@@ -30,6 +30,94 @@
 namespace JS80P
 {
 
+CustomWaveform::CustomWaveform(
+        FloatParamB& harmonic_0,
+        FloatParamB& harmonic_1,
+        FloatParamB& harmonic_2,
+        FloatParamB& harmonic_3,
+        FloatParamB& harmonic_4,
+        FloatParamB& harmonic_5,
+        FloatParamB& harmonic_6,
+        FloatParamB& harmonic_7,
+        FloatParamB& harmonic_8,
+        FloatParamB& harmonic_9
+) noexcept
+    : last_update_round(-1)
+{
+    params[0] = &harmonic_0;
+    params[1] = &harmonic_1;
+    params[2] = &harmonic_2;
+    params[3] = &harmonic_3;
+    params[4] = &harmonic_4;
+    params[5] = &harmonic_5;
+    params[6] = &harmonic_6;
+    params[7] = &harmonic_7;
+    params[8] = &harmonic_8;
+    params[9] = &harmonic_9;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        coefficients[i] = 0.0;
+        change_indices[i] = -1;
+    }
+
+    wavetable = new Wavetable(coefficients, HARMONICS);
+}
+
+
+CustomWaveform::~CustomWaveform()
+{
+    delete wavetable;
+    wavetable = NULL;
+}
+
+
+void CustomWaveform::update(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    if (last_update_round == round) {
+        return;
+    }
+
+    last_update_round = round;
+
+    bool has_changed = false;
+
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        FloatParamB& param = *params[i];
+        Integer const param_change_idx = param.get_change_index();
+
+        if (change_indices[i] != param_change_idx) {
+            coefficients[i] = param.get_value();
+            change_indices[i] = param_change_idx;
+            has_changed = true;
+        }
+
+        FloatParamB::produce_if_not_constant(param, round, sample_count);
+    }
+
+    if (has_changed) {
+        wavetable->update_coefficients(coefficients);
+    }
+}
+
+
+void CustomWaveform::skip_round(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    for (Integer i = 0; i != HARMONICS; ++i) {
+        params[i]->skip_round(round, sample_count);
+    }
+}
+
+
+Wavetable const* CustomWaveform::get_wavetable() const noexcept
+{
+    return wavetable;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 Byte const Oscillator<
         ModulatorSignalProducerClass,
@@ -52,12 +140,6 @@ Byte const Oscillator<
 };
 
 
-template<class ModulatorSignalProducerClass, bool is_lfo>
-FloatParamB Oscillator<
-        ModulatorSignalProducerClass,
-        is_lfo
->::dummy_param("", 0.0, 1.0, 0.0);
-
 template<class ModulatorSignalProducerClass, bool is_lfo>
 ToggleParam Oscillator<
         ModulatorSignalProducerClass,
@@ -74,6 +156,20 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::WaveformParam::WaveformParam(
 }
 
 
+template<class ModulatorSignalProducerClass, bool is_lfo>
+void Oscillator<
+        ModulatorSignalProducerClass,
+        is_lfo
+>::WaveformParam::prepare_wavetable(Number const ratio) const noexcept
+{
+    Byte const index = WAVEFORM_TO_WAVETABLE_INDEX[ratio_to_value(ratio)];
+
+    if (index < StandardWaveforms::WAVEFORMS) {
+        StandardWaveforms::prepare((Integer)index);
+    }
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         WaveformParam& waveform
@@ -114,18 +210,9 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         Constants::FINE_DETUNE_DEFAULT
     ),
     fine_detune_x4(dummy_toggle),
-    harmonic_0(dummy_param),
-    harmonic_1(dummy_param),
-    harmonic_2(dummy_param),
-    harmonic_3(dummy_param),
-    harmonic_4(dummy_param),
-    harmonic_5(dummy_param),
-    harmonic_6(dummy_param),
-    harmonic_7(dummy_param),
-    harmonic_8(dummy_param),
-    harmonic_9(dummy_param),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(NULL)
 {
     initialize_instance();
 }
@@ -137,10 +224,6 @@ void Oscillator<
         is_lfo
 >::initialize_instance() noexcept
 {
-    Number const custom_waveform_coefficients[CUSTOM_WAVEFORM_HARMONICS] = {
-        0.0, 0.0, 0.0, 0.0, 0.0,
-        0.0, 0.0, 0.0, 0.0, 0.0,
-    };
     pulse_width_buffer = NULL;
     computed_amplitude_buffer = NULL;
     computed_frequency_buffer = NULL;
@@ -165,51 +248,21 @@ void Oscillator<
     register_child(detune);
     register_child(fine_detune);
 
-    custom_waveform_params[0] = &harmonic_0;
-    custom_waveform_params[1] = &harmonic_1;
-    custom_waveform_params[2] = &harmonic_2;
-    custom_waveform_params[3] = &harmonic_3;
-    custom_waveform_params[4] = &harmonic_4;
-    custom_waveform_params[5] = &harmonic_5;
-    custom_waveform_params[6] = &harmonic_6;
-    custom_waveform_params[7] = &harmonic_7;
-    custom_waveform_params[8] = &harmonic_8;
-    custom_waveform_params[9] = &harmonic_9;
-
-    for (int i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
-        custom_waveform_change_indices[i] = -1;
-    }
-
-    custom_waveform = new Wavetable(
-        custom_waveform_coefficients, CUSTOM_WAVEFORM_HARMONICS
+    /*
+    Standard waveforms other than the sine are only built when they are first
+    selected, see select_wavetable().
+    */
+    std::fill_n(
+        wavetables, StandardWaveforms::WAVEFORMS, (Wavetable const*)NULL
     );
 
     wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SINE]] = StandardWaveforms::sine();
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SAWTOOTH]] = (
-        StandardWaveforms::sawtooth()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SOFT_SAWTOOTH]] = (
-        StandardWaveforms::soft_sawtooth()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[INVERSE_SAWTOOTH]] = (
-        StandardWaveforms::inverse_sawtooth()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SOFT_INVERSE_SAWTOOTH]] = (
-        StandardWaveforms::soft_inverse_sawtooth()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[TRIANGLE]] = (
-        StandardWaveforms::triangle()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SOFT_TRIANGLE]] = (
-        StandardWaveforms::soft_triangle()
+    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[CUSTOM]] = (
+        custom_waveform == NULL
+            ? StandardWaveforms::silence()
+            : custom_waveform->get_wavetable()
     );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SQUARE]] = (
-        StandardWaveforms::square()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SOFT_SQUARE]] = (
-        StandardWaveforms::soft_square()
-    );
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[CUSTOM]] = custom_waveform;
+    wavetable = wavetables[WAVEFORM_TO_WAVETABLE_INDEX[SINE]];
 
     allocate_buffers(block_size);
 }
@@ -258,18 +311,9 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         Constants::FINE_DETUNE_DEFAULT
     ),
     fine_detune_x4(dummy_toggle),
-    harmonic_0(dummy_param),
-    harmonic_1(dummy_param),
-    harmonic_2(dummy_param),
-    harmonic_3(dummy_param),
-    harmonic_4(dummy_param),
-    harmonic_5(dummy_param),
-    harmonic_6(dummy_param),
-    harmonic_7(dummy_param),
-    harmonic_8(dummy_param),
-    harmonic_9(dummy_param),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(NULL)
 {
     initialize_instance();
 }
@@ -306,18 +350,9 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         Constants::FINE_DETUNE_DEFAULT
     ),
     fine_detune_x4(dummy_toggle),
-    harmonic_0(dummy_param),
-    harmonic_1(dummy_param),
-    harmonic_2(dummy_param),
-    harmonic_3(dummy_param),
-    harmonic_4(dummy_param),
-    harmonic_5(dummy_param),
-    harmonic_6(dummy_param),
-    harmonic_7(dummy_param),
-    harmonic_8(dummy_param),
-    harmonic_9(dummy_param),
     tempo_sync(tempo_sync),
-    center(center)
+    center(center),
+    custom_waveform(NULL)
 {
     initialize_instance();
 }
@@ -332,16 +367,7 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         FloatParamS& detune_leader,
         FloatParamS& fine_detune_leader,
         ToggleParam& fine_detune_x4_leader,
-        FloatParamB& harmonic_0_leader,
-        FloatParamB& harmonic_1_leader,
-        FloatParamB& harmonic_2_leader,
-        FloatParamB& harmonic_3_leader,
-        FloatParamB& harmonic_4_leader,
-        FloatParamB& harmonic_5_leader,
-        FloatParamB& harmonic_6_leader,
-        FloatParamB& harmonic_7_leader,
-        FloatParamB& harmonic_8_leader,
-        FloatParamB& harmonic_9_leader,
+        CustomWaveform& custom_waveform,
         Byte const& voice_status
 ) noexcept
     : SignalProducer(1, NUMBER_OF_CHILDREN, NUMBER_OF_EVENTS),
@@ -355,18 +381,9 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     detune(detune_leader, voice_status),
     fine_detune(fine_detune_leader, voice_status),
     fine_detune_x4(fine_detune_x4_leader),
-    harmonic_0(harmonic_0_leader),
-    harmonic_1(harmonic_1_leader),
-    harmonic_2(harmonic_2_leader),
-    harmonic_3(harmonic_3_leader),
-    harmonic_4(harmonic_4_leader),
-    harmonic_5(harmonic_5_leader),
-    harmonic_6(harmonic_6_leader),
-    harmonic_7(harmonic_7_leader),
-    harmonic_8(harmonic_8_leader),
-    harmonic_9(harmonic_9_leader),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(&custom_waveform)
 {
     initialize_instance();
 }
@@ -380,16 +397,7 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
         FloatParamS& detune_leader,
         FloatParamS& fine_detune_leader,
         ToggleParam& fine_detune_x4_leader,
-        FloatParamB& harmonic_0_leader,
-        FloatParamB& harmonic_1_leader,
-        FloatParamB& harmonic_2_leader,
-        FloatParamB& harmonic_3_leader,
-        FloatParamB& harmonic_4_leader,
-        FloatParamB& harmonic_5_leader,
-        FloatParamB& harmonic_6_leader,
-        FloatParamB& harmonic_7_leader,
-        FloatParamB& harmonic_8_leader,
-        FloatParamB& harmonic_9_leader,
+        CustomWaveform& custom_waveform,
         Byte const& voice_status,
         ModulatorSignalProducerClass& modulator,
         FloatParamS& amplitude_modulation_level_leader,
@@ -431,18 +439,9 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
     detune(detune_leader),
     fine_detune(fine_detune_leader, voice_status),
     fine_detune_x4(fine_detune_x4_leader),
-    harmonic_0(harmonic_0_leader),
-    harmonic_1(harmonic_1_leader),
-    harmonic_2(harmonic_2_leader),
-    harmonic_3(harmonic_3_leader),
-    harmonic_4(harmonic_4_leader),
-    harmonic_5(harmonic_5_leader),
-    harmonic_6(harmonic_6_leader),
-    harmonic_7(harmonic_7_leader),
-    harmonic_8(harmonic_8_leader),
-    harmonic_9(harmonic_9_leader),
     tempo_sync(dummy_toggle),
-    center(dummy_toggle)
+    center(dummy_toggle),
+    custom_waveform(&custom_waveform)
 {
     initialize_instance();
 }
@@ -451,9 +450,6 @@ Oscillator<ModulatorSignalProducerClass, is_lfo>::Oscillator(
 template<class ModulatorSignalProducerClass, bool is_lfo>
 Oscillator<ModulatorSignalProducerClass, is_lfo>::~Oscillator()
 {
-    delete custom_waveform;
-    custom_waveform = NULL;
-    wavetables[WAVEFORM_TO_WAVETABLE_INDEX[CUSTOM]] = NULL;
     free_buffers();
 }
 
@@ -462,7 +458,7 @@ template<class ModulatorSignalProducerClass, bool is_lfo>
 void Oscillator<ModulatorSignalProducerClass, is_lfo>::allocate_buffers(
         Integer const size
 ) noexcept {
-    computed_frequency_buffer = new Frequency[size];
+    computed_frequency_buffer = new Sample[size];
     computed_amplitude_buffer = new Sample[size];
     computed_phase_buffer = new Sample[size];
 }
@@ -552,16 +548,9 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::skip_round(
     detune.skip_round(round, sample_count);
     fine_detune.skip_round(round, sample_count);
 
-    harmonic_0.skip_round(round, sample_count);
-    harmonic_1.skip_round(round, sample_count);
-    harmonic_2.skip_round(round, sample_count);
-    harmonic_3.skip_round(round, sample_count);
-    harmonic_4.skip_round(round, sample_count);
-    harmonic_5.skip_round(round, sample_count);
-    harmonic_6.skip_round(round, sample_count);
-    harmonic_7.skip_round(round, sample_count);
-    harmonic_8.skip_round(round, sample_count);
-    harmonic_9.skip_round(round, sample_count);
+    if (custom_waveform != NULL) {
+        custom_waveform->skip_round(round, sample_count);
+    }
 
     Sample* const buffer = this->buffer[0];
 
@@ -612,7 +601,7 @@ void Oscillator<
 ) noexcept {
     Byte const waveform = this->waveform.get_value();
 
-    wavetable = wavetables[WAVEFORM_TO_WAVETABLE_INDEX[waveform]];
+    wavetable = select_wavetable(waveform);
 
     compute_amplitude_buffer(
         amplitude_buffer,
@@ -703,34 +692,11 @@ Sample const* const* Oscillator<
 
     if constexpr (is_lfo) {
         apply_toggle_params(bpm);
-    } else if (waveform == CUSTOM) {
-        bool has_changed = false;
-
-        for (Integer i = 0; i != CUSTOM_WAVEFORM_HARMONICS; ++i) {
-            FloatParamB& custom_waveform_param = *custom_waveform_params[i];
-            Integer const param_change_idx = (
-                custom_waveform_param.get_change_index()
-            );
-
-            if (custom_waveform_change_indices[i] != param_change_idx) {
-                custom_waveform_coefficients[i] = (
-                    custom_waveform_param.get_value()
-                );
-                custom_waveform_change_indices[i] = param_change_idx;
-                has_changed = true;
-            }
-
-            FloatParamB::produce_if_not_constant(
-                custom_waveform_param, round, sample_count
-            );
-        }
-
-        if (has_changed) {
-            custom_waveform->update_coefficients(custom_waveform_coefficients);
-        }
+    } else if (waveform == CUSTOM && custom_waveform != NULL) {
+        custom_waveform->update(round, sample_count);
     }
 
-    wavetable = wavetables[WAVEFORM_TO_WAVETABLE_INDEX[waveform]];
+    wavetable = select_wavetable(waveform);
 
     is_pulse = waveform >= PULSE && waveform <= SOFT_BIPOLAR_PULSE;
 
@@ -808,6 +774,34 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::apply_toggle_params(
 }
 
 
+template<class ModulatorSignalProducerClass, bool is_lfo>
+Wavetable const* Oscillator<
+        ModulatorSignalProducerClass,
+        is_lfo
+>::select_wavetable(Byte const waveform) noexcept {
+    Byte const index = WAVEFORM_TO_WAVETABLE_INDEX[waveform];
+    Wavetable const* const selected = wavetables[index];
+
+    if (JS80P_LIKELY(selected != NULL)) {
+        return selected;
+    }
+
+    Wavetable const* const standard = StandardWaveforms::get((Integer)index);
+
+    if (standard == NULL) {
+        /*
+        Keep playing the previously selected wavetable until the new one is
+        built in the background.
+        */
+        return wavetable;
+    }
+
+    wavetables[index] = standard;
+
+    return standard;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 void Oscillator<ModulatorSignalProducerClass, is_lfo>::compute_amplitude_buffer(
         Sample const* const amplitude_buffer,
@@ -910,7 +904,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::compute_frequency_buffer(
                 frequency_value, detune_value, fine_detune_value
             );
         } else {
-            Frequency* const computed_frequency_buffer = (
+            Sample* const computed_frequency_buffer = (
                 this->computed_frequency_buffer
             );
 
@@ -927,7 +921,7 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::compute_frequency_buffer(
         constexpr Byte FINE_DETUNE = 4;
         constexpr Byte ALL = FREQUENCY | DETUNE | FINE_DETUNE;
 
-        Frequency* const computed_frequency_buffer = (
+        Sample* const computed_frequency_buffer = (
             this->computed_frequency_buffer
         );
 
@@ -1642,6 +1636,49 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render(
         initialize_first_round(frequency[first_sample_index]);
     }
 
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            render_samples<
+                interpolation, single_partial, has_subharmonic, is_pulse
+            >(
+                pulse_width,
+                amplitude,
+                frequency,
+                phase,
+                subharmonic_amplitude,
+                wavetable_state,
+                first_sample_index,
+                end_sample_index,
+                buffer
+            );
+        }
+    );
+}
+
+
+template<class ModulatorSignalProducerClass, bool is_lfo>
+template<
+        Wavetable::Interpolation interpolation,
+        bool single_partial,
+        bool has_subharmonic,
+        bool is_pulse,
+        class PulseWidthBufferClass,
+        class AmplitudeBufferClass,
+        class FrequencyBufferClass,
+        class PhaseBufferClass,
+        class SubharmonicAmplitudeBufferClass
+>
+void Oscillator<ModulatorSignalProducerClass, is_lfo>::render_samples(
+        PulseWidthBufferClass const& pulse_width,
+        AmplitudeBufferClass const& amplitude,
+        FrequencyBufferClass const& frequency,
+        PhaseBufferClass const& phase,
+        SubharmonicAmplitudeBufferClass const& subharmonic_amplitude,
+        WavetableState& wavetable_state,
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample* const buffer
+) noexcept {
     Number const frequency_scale = this->frequency_scale;
 
     if constexpr (is_lfo && is_pulse) {
@@ -1677,6 +1714,57 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render(
             }
         }
     } else {
+        if constexpr (
+                !is_lfo
+                && std::is_same<FrequencyBufferClass, ParamValueWrapper>::value
+        ) {
+            Frequency const frequency_value = frequency[first_sample_index];
+            Frequency const abs_frequency = std::fabs(frequency_value);
+
+            if (
+                    JS80P_LIKELY(
+                        abs_frequency >= Wavetable::MIN_FREQUENCY
+                        && abs_frequency <= wavetable_state.nyquist_frequency
+                    )
+            ) {
+                if (
+                        wavetable->select_tables<single_partial>(
+                            wavetable_state, abs_frequency
+                        )
+                ) {
+                    render_with_precomputed_phases<
+                        interpolation, true, has_subharmonic, is_pulse
+                    >(
+                        pulse_width,
+                        amplitude,
+                        frequency_value,
+                        phase,
+                        subharmonic_amplitude,
+                        wavetable_state,
+                        first_sample_index,
+                        end_sample_index,
+                        buffer
+                    );
+                } else {
+                    render_with_precomputed_phases<
+                        interpolation, false, has_subharmonic, is_pulse
+                    >(
+                        pulse_width,
+                        amplitude,
+                        frequency_value,
+                        phase,
+                        subharmonic_amplitude,
+                        wavetable_state,
+                        first_sample_index,
+                        end_sample_index,
+                        buffer
+                    );
+                }
+
+                return;
+            }
+        }
+
         for (Integer i = first_sample_index; i != end_sample_index; ++i) {
             buffer[i] = render_sample<
                 single_partial, has_subharmonic, is_pulse, true, interpolation
@@ -1695,6 +1783,92 @@ void Oscillator<ModulatorSignalProducerClass, is_lfo>::render(
 }
 
 
+template<class ModulatorSignalProducerClass, bool is_lfo>
+template<
+        Wavetable::Interpolation interpolation,
+        bool table_interpolation,
+        bool has_subharmonic,
+        bool is_pulse,
+        class PulseWidthBufferClass,
+        class AmplitudeBufferClass,
+        class PhaseBufferClass,
+        class SubharmonicAmplitudeBufferClass
+>
+void Oscillator<
+        ModulatorSignalProducerClass,
+        is_lfo
+>::render_with_precomputed_phases(
+        PulseWidthBufferClass const& pulse_width,
+        AmplitudeBufferClass const& amplitude,
+        Frequency const frequency,
+        PhaseBufferClass const& phase,
+        SubharmonicAmplitudeBufferClass const& subharmonic_amplitude,
+        WavetableState& wavetable_state,
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample* const buffer
+) const noexcept {
+    /*
+    With a constant frequency, the same tables are used for the whole block, and
+    the phase of each sample can be calculated without walking through all the
+    previous samples, so the only loop-carried dependency of Wavetable::lookup()
+    is eliminated, and the CPU can overlap the table lookups of consecutive
+    samples. (This only concerns a single oscillator, voices are still rendered
+    one after the other.)
+    */
+    Frequency const abs_frequency = std::fabs(frequency);
+    Number const increment = wavetable_state.scale * (Number)frequency;
+    Number sample_index = wavetable_state.sample_index;
+    Number sample_indices[PRECOMPUTED_PHASES];
+
+    for (Integer i = first_sample_index; i != end_sample_index; ) {
+        Integer const batch_size = std::min(
+            PRECOMPUTED_PHASES, end_sample_index - i
+        );
+
+        for (Integer j = 0; j != batch_size; ++j) {
+            sample_indices[j] = (
+                sample_index + (Number)j * increment + (Number)phase[i + j]
+            );
+        }
+
+        for (Integer j = 0; j != batch_size; ++j) {
+            Sample sample;
+            Sample subharmonic_sample;
+
+            wavetable->interpolate<
+                interpolation,
+                table_interpolation,
+                has_subharmonic,
+                is_pulse,
+                true
+            >(
+                wavetable_state,
+                abs_frequency,
+                sample_indices[j],
+                pulse_width[i + j],
+                sample,
+                subharmonic_sample
+            );
+
+            if constexpr (has_subharmonic) {
+                buffer[i + j] = (
+                    amplitude[i + j] * sample
+                    + subharmonic_amplitude[i + j] * subharmonic_sample
+                );
+            } else {
+                buffer[i + j] = amplitude[i + j] * sample;
+            }
+        }
+
+        sample_index += (Number)batch_size * increment;
+        i += batch_size;
+    }
+
+    wavetable_state.sample_index = sample_index;
+}
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 template<
         bool single_partial,
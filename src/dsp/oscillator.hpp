@@ -24,6 +24,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.hpp"
 #include "dsp/param.hpp"
 #include "dsp/signal_producer.hpp"
 #include "dsp/wavetable.hpp"
@@ -32,6 +33,66 @@
 namespace JS80P
 {
 
+/**
+ * \brief A wavetable which is built from the values of a set of harmonic
+ *        parameters, and which is shared by all the oscillators which use
+ *        those parameters.
+ */
+class CustomWaveform
+{
+    public:
+        static constexpr Integer HARMONICS = 10;
+
+        CustomWaveform(
+            FloatParamB& harmonic_0,
+            FloatParamB& harmonic_1,
+            FloatParamB& harmonic_2,
+            FloatParamB& harmonic_3,
+            FloatParamB& harmonic_4,
+            FloatParamB& harmonic_5,
+            FloatParamB& harmonic_6,
+            FloatParamB& harmonic_7,
+            FloatParamB& harmonic_8,
+            FloatParamB& harmonic_9
+        ) noexcept;
+
+        ~CustomWaveform();
+
+        CustomWaveform(CustomWaveform const& custom_waveform) = delete;
+        CustomWaveform(CustomWaveform&& custom_waveform) = delete;
+
+        CustomWaveform& operator=(
+            CustomWaveform const& custom_waveform
+        ) = delete;
+
+        CustomWaveform& operator=(CustomWaveform&& custom_waveform) = delete;
+
+        /**
+         * \brief Rebuild the wavetable if any of the harmonics have changed.
+         *
+         * \note Only the first call in each round does any work, so that the
+         *       wavetable is rebuilt at most once per round, regardless of the
+         *       number of oscillators that are using it. When voices are
+         *       rendered in parallel, this must be called before they start.
+         */
+        void update(Integer const round, Integer const sample_count) noexcept;
+
+        void skip_round(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
+        Wavetable const* get_wavetable() const noexcept;
+
+    private:
+        FloatParamB* params[HARMONICS];
+        Number coefficients[HARMONICS];
+        Integer change_indices[HARMONICS];
+        Wavetable* wavetable;
+        Integer last_update_round;
+};
+
+
 template<class ModulatorSignalProducerClass, bool is_lfo>
 class Oscillator;
 
@@ -51,7 +112,6 @@ class Oscillator : public SignalProducer
 
         static constexpr bool HAS_SUBHARMONIC = !(IS_MODULATED || is_lfo);
 
-        static FloatParamB dummy_param;
         static ToggleParam dummy_toggle;
 
     public:
@@ -95,6 +155,15 @@ class Oscillator : public SignalProducer
                     std::string const& name,
                     Byte const max_value = CUSTOM
                 ) noexcept;
+
+                /**
+                 * \brief Make sure that the wavetable of the waveform which
+                 *        would be selected by the given ratio is ready, see
+                 *        \c StandardWaveforms::prepare().
+                 *
+                 * \warning Not real-time safe.
+                 */
+                void prepare_wavetable(Number const ratio) const noexcept;
         };
 
         static constexpr Event::Type EVT_START = 1;
@@ -128,16 +197,7 @@ class Oscillator : public SignalProducer
             FloatParamS& detune_leader,
             FloatParamS& fine_detune_leader,
             ToggleParam& fine_detune_x4_leader,
-            FloatParamB& harmonic_0_leader,
-            FloatParamB& harmonic_1_leader,
-            FloatParamB& harmonic_2_leader,
-            FloatParamB& harmonic_3_leader,
-            FloatParamB& harmonic_4_leader,
-            FloatParamB& harmonic_5_leader,
-            FloatParamB& harmonic_6_leader,
-            FloatParamB& harmonic_7_leader,
-            FloatParamB& harmonic_8_leader,
-            FloatParamB& harmonic_9_leader,
+            CustomWaveform& custom_waveform,
             Byte const& voice_status
         ) noexcept;
 
@@ -148,16 +208,7 @@ class Oscillator : public SignalProducer
             FloatParamS& detune_leader,
             FloatParamS& fine_detune_leader,
             ToggleParam& fine_detune_x4_leader,
-            FloatParamB& harmonic_0_leader,
-            FloatParamB& harmonic_1_leader,
-            FloatParamB& harmonic_2_leader,
-            FloatParamB& harmonic_3_leader,
-            FloatParamB& harmonic_4_leader,
-            FloatParamB& harmonic_5_leader,
-            FloatParamB& harmonic_6_leader,
-            FloatParamB& harmonic_7_leader,
-            FloatParamB& harmonic_8_leader,
-            FloatParamB& harmonic_9_leader,
+            CustomWaveform& custom_waveform,
             Byte const& voice_status,
             ModulatorSignalProducerClass& modulator,
             FloatParamS& amplitude_modulation_level_leader,
@@ -213,17 +264,6 @@ class Oscillator : public SignalProducer
 
         ToggleParam& fine_detune_x4;
 
-        FloatParamB& harmonic_0;
-        FloatParamB& harmonic_1;
-        FloatParamB& harmonic_2;
-        FloatParamB& harmonic_3;
-        FloatParamB& harmonic_4;
-        FloatParamB& harmonic_5;
-        FloatParamB& harmonic_6;
-        FloatParamB& harmonic_7;
-        FloatParamB& harmonic_8;
-        FloatParamB& harmonic_9;
-
     protected:
         Sample const* const* initialize_rendering(
             Integer const round,
@@ -247,7 +287,12 @@ class Oscillator : public SignalProducer
         static constexpr Integer NUMBER_OF_CHILDREN = 8;
         static constexpr Integer NUMBER_OF_EVENTS = 4;
 
-        static constexpr Integer CUSTOM_WAVEFORM_HARMONICS = 10;
+        /*
+        When the frequency is constant, the phases of this many samples are
+        calculated in advance, so that the table lookups don't depend on each
+        other, see render_with_precomputed_phases().
+        */
+        static constexpr Integer PRECOMPUTED_PHASES = 64;
 
         static Byte const WAVEFORM_TO_WAVETABLE_INDEX[];
 
@@ -257,6 +302,8 @@ class Oscillator : public SignalProducer
 
         void apply_toggle_params(Number const bpm) noexcept;
 
+        Wavetable const* select_wavetable(Byte const waveform) noexcept;
+
         void compute_amplitude_buffer(
             Sample const* const amplitude_buffer,
             Sample const amplitude_value,
@@ -351,6 +398,51 @@ class Oscillator : public SignalProducer
             Sample* const buffer
         ) noexcept;
 
+        template<
+            Wavetable::Interpolation interpolation,
+            bool single_partial,
+            bool has_subharmonic,
+            bool is_pulse,
+            class PulseWidthBufferClass,
+            class AmplitudeBufferClass,
+            class FrequencyBufferClass,
+            class PhaseBufferClass,
+            class SubharmonicAmplitudeBufferClass
+        >
+        JS80P_INLINE void render_samples(
+            PulseWidthBufferClass const& pulse_width,
+            AmplitudeBufferClass const& amplitude,
+            FrequencyBufferClass const& frequency,
+            PhaseBufferClass const& phase,
+            SubharmonicAmplitudeBufferClass const& subharmonic_amplitude,
+            WavetableState& wavetable_state,
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample* const buffer
+        ) noexcept;
+
+        template<
+            Wavetable::Interpolation interpolation,
+            bool table_interpolation,
+            bool has_subharmonic,
+            bool is_pulse,
+            class PulseWidthBufferClass,
+            class AmplitudeBufferClass,
+            class PhaseBufferClass,
+            class SubharmonicAmplitudeBufferClass
+        >
+        JS80P_INLINE void render_with_precomputed_phases(
+            PulseWidthBufferClass const& pulse_width,
+            AmplitudeBufferClass const& amplitude,
+            Frequency const frequency,
+            PhaseBufferClass const& phase,
+            SubharmonicAmplitudeBufferClass const& subharmonic_amplitude,
+            WavetableState& wavetable_state,
+            Integer const first_sample_index,
+            Integer const end_sample_index,
+            Sample* const buffer
+        ) const noexcept;
+
         template<
             bool single_partial,
             bool has_subharmonic,
@@ -358,7 +450,7 @@ class Oscillator : public SignalProducer
             bool need_pulse_scaling,
             Wavetable::Interpolation interpolation
         >
-        Sample render_sample(
+        JS80P_INLINE Sample render_sample(
             WavetableState& wavetable_state,
             Number const pulse_width,
             Sample const amplitude,
@@ -374,15 +466,12 @@ class Oscillator : public SignalProducer
         WavetableState wavetable_state;
         Wavetable const* wavetables[10];
         Wavetable const* wavetable;
-        Wavetable* custom_waveform;
+        CustomWaveform* const custom_waveform;
         Sample const* pulse_width_buffer;
         Sample* computed_amplitude_buffer;
-        Frequency* computed_frequency_buffer;
+        Sample* computed_frequency_buffer;
         Sample* computed_phase_buffer;
         Sample const* subharmonic_amplitude_buffer;
-        FloatParamB* custom_waveform_params[CUSTOM_WAVEFORM_HARMONICS];
-        Number custom_waveform_coefficients[CUSTOM_WAVEFORM_HARMONICS];
-        Integer custom_waveform_change_indices[CUSTOM_WAVEFORM_HARMONICS];
         Number pulse_width_value;
         Number computed_amplitude_value;
         Sample subharmonic_amplitude_value;
@@ -63,6 +63,14 @@ Sample ParamValueBufferWrapper::operator[](Integer const index) const noexcept
 constexpr Byte dummy_voice_status = Constants::VOICE_STATUS_NORMAL;
 
 
+template<ParamEvaluation evaluation>
+thread_local Integer FloatParam<evaluation>::rendering_thread = 0;
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::is_rendering_in_parallel = false;
+
+
 template<typename NumberType, ParamEvaluation evaluation>
 Param<NumberType, evaluation>::Param(
         std::string const& name,
@@ -305,7 +313,13 @@ template<typename NumberType, ParamEvaluation evaluation>
 void Param<NumberType, evaluation>::set_midi_channel(
         Midi::Channel const midi_channel
 ) noexcept {
-    midi_channel_rw = midi_channel;
+    /*
+    Voices which are rendered in parallel keep telling the shared envelope
+    params the same channel, so these must be read-only operations.
+    */
+    if (midi_channel_rw != midi_channel) {
+        midi_channel_rw = midi_channel;
+    }
 }
 
 
@@ -478,6 +492,40 @@ Sample const* FloatParam<evaluation>::produce_if_not_constant(
 }
 
 
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::produce_active_params(
+        FloatParam<evaluation>** const active_params,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    FloatParam<evaluation>** link = active_params;
+
+    while (*link != NULL) {
+        FloatParam<evaluation>& param = **link;
+
+        produce_if_not_constant< FloatParam<evaluation> >(
+            param, round, sample_count
+        );
+
+        if (param.may_change()) {
+            link = &param.next_active_param;
+        } else {
+            /*
+            Producing the parameter may have activated others, which were put
+            in front of it if it was at the head of the list.
+            */
+            while (*link != &param) {
+                link = &(*link)->next_active_param;
+            }
+
+            *link = param.next_active_param;
+            param.next_active_param = NULL;
+            param.is_active = false;
+        }
+    }
+}
+
+
 template<ParamEvaluation evaluation>
 FloatParam<evaluation>::FloatParam(
         std::string const& name,
@@ -582,8 +630,16 @@ void FloatParam<evaluation>::initialize_instance() noexcept
     lfo = NULL;
     envelope = NULL;
 
+    std::fill_n(rendering_thread_buffers, MAX_RENDERING_THREADS, (Sample*)NULL);
+    rendering_threads = 1;
+
     constantness_round = -1;
     constantness = false;
+    has_followers = false;
+
+    active_params = NULL;
+    next_active_param = NULL;
+    is_active = false;
 
     latest_event_type = EVT_SET_VALUE;
 }
@@ -647,6 +703,8 @@ FloatParam<evaluation>::FloatParam(
     )
 {
     initialize_instance();
+
+    leader.has_followers = true;
 }
 
 
@@ -658,6 +716,94 @@ FloatParam<evaluation>::~FloatParam()
 
         delete envelope_state;
     }
+
+    free_rendering_thread_buffers();
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_block_size(
+        Integer const new_block_size
+) noexcept {
+    if (new_block_size != this->block_size) {
+        Param<Number, evaluation>::set_block_size(new_block_size);
+
+        free_rendering_thread_buffers();
+        allocate_rendering_thread_buffers();
+    }
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_rendering_threads(
+        Integer const threads
+) noexcept {
+    JS80P_ASSERT(threads >= 1 && threads <= MAX_RENDERING_THREADS);
+
+    free_rendering_thread_buffers();
+    rendering_threads = threads;
+    allocate_rendering_thread_buffers();
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_rendering_thread(Integer const thread) noexcept
+{
+    JS80P_ASSERT(thread >= 0 && thread < MAX_RENDERING_THREADS);
+
+    rendering_thread = thread;
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_rendering_in_parallel(
+        bool const is_parallel
+) noexcept {
+    is_rendering_in_parallel = is_parallel;
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::allocate_rendering_thread_buffers() noexcept
+{
+    /*
+    Only the followers of a leader are rendered simultaneously on different
+    threads, the leader itself is always rendered by thread 0 into its own
+    buffer.
+    */
+    if (!has_followers) {
+        return;
+    }
+
+    for (Integer t = 1; t < rendering_threads; ++t) {
+        rendering_thread_buffers[t] = new Sample[this->block_size];
+        std::fill_n(rendering_thread_buffers[t], this->block_size, 0.0);
+    }
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::free_rendering_thread_buffers() noexcept
+{
+    for (Integer t = 1; t != MAX_RENDERING_THREADS; ++t) {
+        delete[] rendering_thread_buffers[t];
+        rendering_thread_buffers[t] = NULL;
+    }
+}
+
+
+template<ParamEvaluation evaluation>
+Sample** FloatParam<evaluation>::get_buffer() noexcept
+{
+    Integer const thread = rendering_thread;
+
+    if (thread == 0 || leader == NULL) {
+        return SignalProducer::get_buffer();
+    }
+
+    JS80P_ASSERT(leader->rendering_thread_buffers[thread] != NULL);
+
+    return &leader->rendering_thread_buffers[thread];
 }
 
 
@@ -762,7 +908,7 @@ bool FloatParam<evaluation>::is_affected_by_different_midi_channel_than_leader(
     expected to be less than 3-5.
     */
 
-    Queue<SignalProducer::Event>::SizeType i;
+    RingQueue<SignalProducer::Event>::SizeType i;
 
     for (i = 0; i != this->events.length(); ++i) {
         SignalProducer::Event const& event = this->events[i];
@@ -804,6 +950,51 @@ bool FloatParam<evaluation>::is_logarithmic() const noexcept
 }
 
 
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::set_active_params_list(
+        FloatParam<evaluation>** const active_params
+) noexcept {
+    this->active_params = active_params;
+
+    /* Let the first round decide whether there's anything to do. */
+    activate();
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::activate() noexcept
+{
+    if (is_active || active_params == NULL) {
+        return;
+    }
+
+    next_active_param = *active_params;
+    *active_params = this;
+    is_active = true;
+}
+
+
+template<ParamEvaluation evaluation>
+bool FloatParam<evaluation>::may_change() const noexcept
+{
+    return (
+        this->has_events()
+        || is_following_leader()
+        || get_lfo() != NULL
+        || get_envelope() != NULL
+        || get_midi_controller() != NULL
+        || get_macro() != NULL
+    );
+}
+
+
+template<ParamEvaluation evaluation>
+void FloatParam<evaluation>::handle_scheduled_event() noexcept
+{
+    activate();
+}
+
+
 template<ParamEvaluation evaluation>
 void FloatParam<evaluation>::set_value(Number const new_value) noexcept
 {
@@ -974,15 +1165,27 @@ void FloatParam<evaluation>::ratios_to_values(
         return;
     }
 
-    if (is_logarithmic()) {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            buffer[i] = ratio_to_value_log(buffer[i]);
-        }
-    } else {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            buffer[i] = ratio_to_value_raw(buffer[i]);
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            if (is_logarithmic()) {
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    buffer[i] = ratio_to_value_log(buffer[i]);
+                }
+            } else {
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    buffer[i] = ratio_to_value_raw(buffer[i]);
+                }
+            }
         }
-    }
+    );
 }
 
 
@@ -993,19 +1196,35 @@ void FloatParam<evaluation>::ratios_to_values(
         Integer const first_sample_index,
         Integer const end_sample_index
 ) const noexcept {
-    if (is_ratio_same_as_value) {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            target_buffer[i] = source_buffer[i];
-        }
-    } else if (is_logarithmic()) {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            target_buffer[i] = ratio_to_value_log(source_buffer[i]);
-        }
-    } else {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            target_buffer[i] = ratio_to_value_raw(source_buffer[i]);
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            if (is_ratio_same_as_value) {
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    target_buffer[i] = source_buffer[i];
+                }
+            } else if (is_logarithmic()) {
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    target_buffer[i] = ratio_to_value_log(source_buffer[i]);
+                }
+            } else {
+                for (
+                        Integer i = first_sample_index;
+                        i != end_sample_index;
+                        ++i
+                ) {
+                    target_buffer[i] = ratio_to_value_raw(source_buffer[i]);
+                }
+            }
         }
-    }
+    );
 }
 
 
@@ -1046,7 +1265,27 @@ bool FloatParam<evaluation>::is_constant_in_next_round(
     }
 
     constantness_round = round;
-    constantness = is_constant_until(sample_count);
+
+    /*
+    All the followers of a leader share the leader's buffer, so they also share
+    its decision: the leader is evaluated only once per round, no matter how
+    many voices ask.
+
+    When voices are rendered in parallel, the leader's decision has already
+    been made before starting the voices (see
+    Synth::Bus::render_shared_leaders()). If it hasn't, then the leader is not
+    rendered in this round, so evaluating it without memoizing gives the same
+    result without writing to the leader from multiple threads.
+    */
+    if (is_following_leader()) {
+        constantness = (
+            is_rendering_in_parallel && leader->constantness_round != round
+                ? leader->is_constant_until(sample_count)
+                : leader->is_constant_in_next_round(round, sample_count)
+        );
+    } else {
+        constantness = is_constant_until(sample_count);
+    }
 
     return constantness;
 }
@@ -1138,6 +1377,7 @@ void FloatParam<evaluation>::skip_round(
         leader->skip_round(round, sample_count);
     } else if (this->cached_round != round && !this->events.is_empty()) {
         this->current_time += (Seconds)sample_count * this->sampling_period;
+        this->current_sample += sample_count;
         this->cached_round = round;
 
         this->constantness_round = round;
@@ -1933,6 +2173,10 @@ void FloatParam<evaluation>::set_midi_controller(
     >(
         *this, midi_controller
     );
+
+    if (midi_controller != NULL) {
+        activate();
+    }
 }
 
 
@@ -1953,6 +2197,9 @@ void FloatParam<evaluation>::set_macro(Macro* const macro) noexcept
     Param<Number, evaluation>::template set_macro< FloatParam<evaluation> >(
         *this, macro
     );
+    if (macro != NULL) {
+        activate();
+    }
 }
 
 
@@ -1989,6 +2236,7 @@ void FloatParam<evaluation>::set_envelope(Envelope* const envelope) noexcept
 
     if (envelope != NULL) {
         envelope->update();
+        activate();
     }
 
     this->cancel_events();
@@ -2577,6 +2825,10 @@ void FloatParam<evaluation>::set_lfo(LFO* const lfo) noexcept
     this->cancel_events();
 
     clear_envelope_state();
+
+    if (lfo != NULL) {
+        activate();
+    }
 }
 
 
@@ -2730,10 +2982,10 @@ template<bool is_logarithmic_>
 void FloatParam<evaluation>::process_midi_controller_events(
         MidiController const& midi_controller
 ) noexcept {
-    Queue<SignalProducer::Event> const& ctl_events = (
+    RingQueue<SignalProducer::Event> const& ctl_events = (
         midi_controller.event_queues[this->midi_channel]
     );
-    Queue<SignalProducer::Event>::SizeType const number_of_ctl_events = (
+    RingQueue<SignalProducer::Event>::SizeType const number_of_ctl_events = (
         ctl_events.length()
     );
 
@@ -2750,7 +3002,7 @@ void FloatParam<evaluation>::process_midi_controller_events(
     this->cancel_events_at(ctl_events[0].time_offset);
 
     if (should_round) {
-        Queue<SignalProducer::Event>::SizeType i;
+        RingQueue<SignalProducer::Event>::SizeType i;
 
         for (i = 0; i != number_of_ctl_events; ++i) {
             Seconds const time_offset = ctl_events[i].time_offset;
@@ -2767,13 +3019,12 @@ void FloatParam<evaluation>::process_midi_controller_events(
             }
         }
     } else {
-        Queue<SignalProducer::Event>::SizeType const last_ctl_event_index = (
-            number_of_ctl_events - 1
-        );
+        RingQueue<SignalProducer::Event>::SizeType const
+            last_ctl_event_index = number_of_ctl_events - 1;
 
         Seconds previous_time_offset = 0.0;
         Number previous_ratio = value_to_ratio(this->get_raw_value());
-        Queue<SignalProducer::Event>::SizeType i;
+        RingQueue<SignalProducer::Event>::SizeType i;
 
         for (i = 0; i != number_of_ctl_events; ++i) {
             Seconds time_offset = ctl_events[i].time_offset;
@@ -2836,7 +3087,7 @@ bool FloatParam<evaluation>::is_sync_ctl_value_event_scheduled(
     expected to be less than 3-5.
     */
 
-    Queue<SignalProducer::Event>::SizeType i;
+    RingQueue<SignalProducer::Event>::SizeType i;
 
     for (i = 0; i != this->events.length(); ++i) {
         SignalProducer::Event const& event = this->events[i];
@@ -3054,38 +3305,73 @@ void FloatParam<evaluation>::render_linear_ramp(
         Integer const end_sample_index,
         Sample* const buffer
 ) noexcept {
-    Sample sample;
+    if (end_sample_index == first_sample_index) {
+        return;
+    }
 
-    if (linear_ramp_state.is_logarithmic) {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            buffer[i] = sample = ratio_to_value_log(
-                linear_ramp_state.advance()
+    /*
+    The ramp is rendered in two segments: the samples before the target is
+    reached are filled with linear interpolation between the ratios, then
+    converted to values (which is a no-op for linear ramps), and the rest of
+    the block is filled with the target value.
+    */
+    Integer ramp_end_index;
+
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            ramp_end_index = linear_ramp_state.render(
+                first_sample_index, end_sample_index, buffer
             );
+
+            if (linear_ramp_state.is_logarithmic) {
+                for (Integer i = first_sample_index; i != ramp_end_index; ++i) {
+                    buffer[i] = ratio_to_value_log(buffer[i]);
+                }
+            } else if (JS80P_UNLIKELY(linear_ramp_state.is_curved)) {
+                Number const init_value = linear_ramp_state.curve_initial_value;
+                Number const delta = linear_ramp_state.curve_delta;
+                Math::EnvelopeShape shape = linear_ramp_state.curve_shape;
+
+                for (Integer i = first_sample_index; i != ramp_end_index; ++i) {
+                    buffer[i] = (
+                        init_value
+                        + delta * Math::apply_envelope_shape(shape, buffer[i])
+                    );
+                }
+            }
         }
+    );
 
-    } else if (JS80P_UNLIKELY(linear_ramp_state.is_curved)) {
-        Number const init_value = linear_ramp_state.curve_initial_value;
-        Number const delta = linear_ramp_state.curve_delta;
-        Math::EnvelopeShape shape = linear_ramp_state.curve_shape;
+    if (ramp_end_index != end_sample_index) {
+        std::fill_n(
+            &buffer[ramp_end_index],
+            end_sample_index - ramp_end_index,
+            (Sample)linear_ramp_ratio_to_value(linear_ramp_state.target_value)
+        );
+    }
 
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            buffer[i] = sample = (
-                init_value
-                + delta * Math::apply_envelope_shape(
-                    shape, linear_ramp_state.advance()
-                )
-            );
-        }
+    this->store_new_value(buffer[end_sample_index - 1]);
+}
 
-    } else {
-        for (Integer i = first_sample_index; i != end_sample_index; ++i) {
-            buffer[i] = sample = linear_ramp_state.advance();
-        }
+
+template<ParamEvaluation evaluation>
+Number FloatParam<evaluation>::linear_ramp_ratio_to_value(
+        Number const ratio
+) const noexcept {
+    if (linear_ramp_state.is_logarithmic) {
+        return ratio_to_value_log(ratio);
     }
 
-    if (end_sample_index != first_sample_index) {
-        this->store_new_value(sample);
+    if (linear_ramp_state.is_curved) {
+        return (
+            linear_ramp_state.curve_initial_value
+            + linear_ramp_state.curve_delta * Math::apply_envelope_shape(
+                linear_ramp_state.curve_shape, ratio
+            )
+        );
     }
+
+    return ratio;
 }
 
 
@@ -3107,7 +3393,7 @@ void FloatParam<evaluation>::render_with_envelope(
     }
 
     Sample* const buffer_ = buffer[0];
-    Sample ratio = value_to_ratio(this->get_raw_value());
+    Number ratio = value_to_ratio(this->get_raw_value());
 
     envelope_state->is_constant = (
         Envelope::render<Envelope::RenderingMode::OVERWRITE>(
@@ -3223,6 +3509,52 @@ Number FloatParam<evaluation>::LinearRampState::advance() noexcept
 }
 
 
+template<ParamEvaluation evaluation>
+Integer FloatParam<evaluation>::LinearRampState::render(
+        Integer const first_sample_index,
+        Integer const end_sample_index,
+        Sample* const buffer
+) noexcept {
+    if (is_done) {
+        return first_sample_index;
+    }
+
+    /*
+    advance() yields ramp values while done_samples is below the duration, but
+    the first sample is always a ramp sample, even if the ramp is about to end.
+    */
+    Number const remaining_samples = std::ceil(
+        duration_in_samples - done_samples
+    );
+    Integer const end_index = (
+        remaining_samples < (Number)(end_sample_index - first_sample_index)
+            ? (
+                first_sample_index
+                + std::max((Integer)1, (Integer)remaining_samples)
+            )
+            : end_sample_index
+    );
+    Number const initial_value = this->initial_value;
+    Number const done_samples = this->done_samples;
+    Number const speed = this->speed;
+    Number const delta = this->delta;
+    Number x = 0.0;
+
+    for (Integer i = first_sample_index; i != end_index; ++i, x += 1.0) {
+        buffer[i] = initial_value + ((done_samples + x) * speed) * delta;
+    }
+
+    this->done_samples = done_samples + x;
+
+    if (this->done_samples >= duration_in_samples) {
+        this->done_samples = duration_in_samples;
+        is_done = true;
+    }
+
+    return end_index;
+}
+
+
 template<ParamEvaluation evaluation>
 Number FloatParam<evaluation>::LinearRampState::get_value_at(
         Seconds const time_offset
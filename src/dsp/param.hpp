@@ -26,6 +26,7 @@
 #include "js80p.hpp"
 #include "midi.hpp"
 
+#include "dsp/cpu.hpp"
 #include "dsp/math.hpp"
 #include "dsp/midi_controller.hpp"
 #include "dsp/signal_producer.hpp"
@@ -295,7 +296,7 @@ class LFOEnvelopeState
         Integer active_snapshot_id;
         Integer scheduled_snapshot_id;
         Seconds time;
-        Sample value;
+        Number value;
         EnvelopeStage stage;
         Byte active_snapshot_envelope_index;
         Byte scheduled_snapshot_envelope_index;
@@ -352,6 +353,25 @@ class FloatParam : public Param<Number, evaluation>
 
         static constexpr Integer INVALID_ENVELOPE_SNAPSHOT_ID = -1;
 
+        static constexpr Integer MAX_RENDERING_THREADS = 16;
+
+        /**
+         * \brief Select which set of buffers the followers of leaders should
+         *        use when they are rendered on the calling thread. Thread 0
+         *        uses the buffers of the leaders themselves.
+         *        See \c set_rendering_threads()
+         */
+        static void set_rendering_thread(Integer const thread) noexcept;
+
+        /**
+         * \brief Tell whether followers are being rendered on multiple threads
+         *        simultaneously, in which case they must not modify the state
+         *        of their leaders.
+         *
+         * \warning Must not be called while the followers are being rendered.
+         */
+        static void set_rendering_in_parallel(bool const is_parallel) noexcept;
+
         /**
          * \brief Orchestrate rendering signals and handling events.
          *        See \c SignalProducer::process()
@@ -386,6 +406,18 @@ class FloatParam : public Param<Number, evaluation>
             Integer const sample_count
         ) noexcept;
 
+        /**
+         * \brief Call \c produce_if_not_constant() for each parameter on the
+         *        list that was given to \c set_active_params_list() , and drop
+         *        those which will stay constant until they receive new events
+         *        or a controller.
+         */
+        static void produce_active_params(
+            FloatParam<evaluation>** const active_params,
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         explicit FloatParam(
             std::string const& name = "",
             Number const min_value = -1.0,
@@ -429,7 +461,8 @@ class FloatParam : public Param<Number, evaluation>
          *          order to avoid getting overwritten by other polyphonic
          *          voices. All \c FloatParam instances with the same leader use
          *          the leader's buffer, even when they are running with
-         *          envelopes or polyphonic LFOs.
+         *          envelopes or polyphonic LFOs. (Unless they are rendered on
+         *          different threads, see \c set_rendering_threads() .)
          */
         FloatParam(FloatParam<evaluation>& leader) noexcept;
 
@@ -440,8 +473,30 @@ class FloatParam : public Param<Number, evaluation>
 
         ~FloatParam() override;
 
+        virtual void set_block_size(
+            Integer const new_block_size
+        ) noexcept override;
+
+        /**
+         * \brief Allocate a separate buffer for each additional thread that
+         *        may render the followers of this leader simultaneously.
+         *
+         * \warning Not real-time safe.
+         */
+        void set_rendering_threads(Integer const threads) noexcept;
+
         bool is_logarithmic() const noexcept;
 
+        /**
+         * \brief Make the parameter put itself on the given intrusive list when
+         *        it receives events or a controller, so that the owner of the
+         *        list doesn't need to visit all its parameters in every round
+         *        in order to keep them up to date.
+         */
+        void set_active_params_list(
+            FloatParam<evaluation>** const active_params
+        ) noexcept;
+
         void set_value(Number const new_value) noexcept;
         Number get_value() const noexcept;
         void set_ratio(Number const ratio) noexcept;
@@ -566,6 +621,8 @@ class FloatParam : public Param<Number, evaluation>
             SignalProducer::Event const& event
         ) noexcept JS80P_OVERRIDE;
 
+        virtual void handle_scheduled_event() noexcept override;
+
         bool should_update_envelope(Envelope const& envelope) const noexcept;
 
     private:
@@ -589,7 +646,23 @@ class FloatParam : public Param<Number, evaluation>
                     Number const curve_delta = 0.0
                 ) noexcept;
 
-                Number advance() noexcept;
+                JS80P_INLINE Number advance() noexcept;
+
+                /**
+                 * \brief Same as calling \c advance() for each sample from
+                 *        \c first_sample_index until either the ramp or the
+                 *        \c end_sample_index is reached, using a loop that
+                 *        can be vectorized.
+                 *
+                 * \return The index of the first sample which was not
+                 *         rendered, i.e. where the ramp has reached its target.
+                 */
+                JS80P_INLINE Integer render(
+                    Integer const first_sample_index,
+                    Integer const end_sample_index,
+                    Sample* const buffer
+                ) noexcept;
+
                 Number get_value_at(Seconds const time_offset) const noexcept;
                 Number get_remaining_samples() const noexcept;
 
@@ -650,8 +723,13 @@ class FloatParam : public Param<Number, evaluation>
         void initialize_instance() noexcept;
 
         Number round_value(Number const value) const noexcept;
-        Number ratio_to_value_log(Number const ratio) const noexcept;
-        Number ratio_to_value_raw(Number const ratio) const noexcept;
+        JS80P_INLINE Number ratio_to_value_log(
+            Number const ratio
+        ) const noexcept;
+
+        JS80P_INLINE Number ratio_to_value_raw(
+            Number const ratio
+        ) const noexcept;
         Number value_to_ratio_raw(Number const value) const noexcept;
 
         void handle_cancel_event(SignalProducer::Event const& event) noexcept;
@@ -737,6 +815,9 @@ class FloatParam : public Param<Number, evaluation>
         bool is_affected_by_different_midi_channel_than_leader() const noexcept;
         bool is_following_leader() const noexcept;
 
+        void activate() noexcept;
+        bool may_change() const noexcept;
+
         Sample const* const* process_lfo(
             LFO& lfo,
             Integer const round,
@@ -801,6 +882,8 @@ class FloatParam : public Param<Number, evaluation>
             Sample* const buffer
         ) noexcept;
 
+        Number linear_ramp_ratio_to_value(Number const ratio) const noexcept;
+
         void render_with_envelope(
             Integer const round,
             Integer const first_sample_index,
@@ -858,6 +941,14 @@ class FloatParam : public Param<Number, evaluation>
             char const* const event
         ) const noexcept;
 
+        Sample** get_buffer() noexcept;
+
+        void allocate_rendering_thread_buffers() noexcept;
+        void free_rendering_thread_buffers() noexcept;
+
+        static thread_local Integer rendering_thread;
+        static bool is_rendering_in_parallel;
+
         FloatParam<evaluation>* const leader;
         Envelope* const* const envelopes;
         EnvelopeState* const envelope_state;
@@ -878,9 +969,15 @@ class FloatParam : public Param<Number, evaluation>
         LFO* lfo;
         Sample const* const* lfo_buffer;
         Envelope* envelope;
+        Sample* rendering_thread_buffers[MAX_RENDERING_THREADS];
+        Integer rendering_threads;
         Integer constantness_round;
+        FloatParam<evaluation>** active_params;
+        FloatParam<evaluation>* next_active_param;
         SignalProducer::Event::Type latest_event_type;
         bool constantness;
+        bool has_followers;
+        bool is_active;
 };
 
 
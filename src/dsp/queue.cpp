@@ -1,6 +1,6 @@
 /*
  * This file is part of JS80P, a synthesizer plugin.
- * Copyright (C) 2023, 2024  Attila M. Magyar
+ * Copyright (C) 2023, 2024, 2026  Attila M. Magyar
  *
  * JS80P is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -143,6 +143,168 @@ void Queue<Item>::drop(typename Queue<Item>::SizeType const index) noexcept
     reset_if_empty();
 }
 
+
+template<class Item>
+RingQueue<Item>::RingQueue(SizeType const capacity) noexcept
+    : items(capacity),
+    capacity(capacity),
+    next_pop(0),
+    size(0),
+    high_water_mark(0),
+    overflows(0)
+{
+}
+
+
+template<class Item>
+bool RingQueue<Item>::is_empty() const noexcept
+{
+    return size == 0;
+}
+
+
+template<class Item>
+bool RingQueue<Item>::is_full() const noexcept
+{
+    return size == capacity;
+}
+
+
+template<class Item>
+bool RingQueue<Item>::push(Item const& item) noexcept
+{
+    if (JS80P_UNLIKELY(is_full())) {
+        ++overflows;
+
+        return false;
+    }
+
+    items[wrap(next_pop + size)] = item;
+    ++size;
+
+    if (size > high_water_mark) {
+        high_water_mark = size;
+    }
+
+    return true;
+}
+
+
+template<class Item>
+Item& RingQueue<Item>::pop() noexcept
+{
+    Item& item = items[next_pop];
+
+    next_pop = wrap(next_pop + 1);
+    --size;
+
+    return item;
+}
+
+
+template<class Item>
+Item const& RingQueue<Item>::front() const noexcept
+{
+    return items[next_pop];
+}
+
+
+template<class Item>
+Item& RingQueue<Item>::front() noexcept
+{
+    return items[next_pop];
+}
+
+
+template<class Item>
+Item const& RingQueue<Item>::back() const noexcept
+{
+    return items[wrap(next_pop + size - 1)];
+}
+
+
+template<class Item>
+Item& RingQueue<Item>::back() noexcept
+{
+    return items[wrap(next_pop + size - 1)];
+}
+
+
+template<class Item>
+typename RingQueue<Item>::SizeType RingQueue<Item>::length() const noexcept
+{
+    return size;
+}
+
+
+template<class Item>
+Item const& RingQueue<Item>::operator[](
+        typename RingQueue<Item>::SizeType const index
+) const noexcept {
+    return items[wrap(next_pop + index)];
+}
+
+
+template<class Item>
+Item& RingQueue<Item>::operator[](
+        typename RingQueue<Item>::SizeType const index
+) noexcept {
+    return items[wrap(next_pop + index)];
+}
+
+
+template<class Item>
+void RingQueue<Item>::drop(
+        typename RingQueue<Item>::SizeType const index
+) noexcept {
+    size = index;
+
+    if (size == 0) {
+        next_pop = 0;
+    }
+}
+
+
+template<class Item>
+typename RingQueue<Item>::SizeType RingQueue<Item>::get_capacity(
+) const noexcept {
+    return capacity;
+}
+
+
+template<class Item>
+typename RingQueue<Item>::SizeType RingQueue<Item>::get_high_water_mark(
+) const noexcept {
+    return high_water_mark;
+}
+
+
+template<class Item>
+typename RingQueue<Item>::SizeType RingQueue<Item>::get_overflows(
+) const noexcept {
+    return overflows;
+}
+
+
+template<class Item>
+void RingQueue<Item>::reset_statistics() noexcept
+{
+    high_water_mark = size;
+    overflows = 0;
+}
+
+
+template<class Item>
+typename RingQueue<Item>::SizeType RingQueue<Item>::wrap(
+        typename RingQueue<Item>::SizeType const index
+) const noexcept {
+    /*
+    Indices passed in here are always less than 2 * capacity, so a conditional
+    subtraction is enough, no need for a division.
+    */
+    return index >= capacity ? index - capacity : index;
+}
+
 }
 
 #endif
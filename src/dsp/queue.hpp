@@ -1,6 +1,6 @@
 /*
  * This file is part of JS80P, a synthesizer plugin.
- * Copyright (C) 2023, 2024  Attila M. Magyar
+ * Copyright (C) 2023, 2024, 2026  Attila M. Magyar
  *
  * JS80P is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -21,6 +21,8 @@
 
 #include <vector>
 
+#include "js80p.hpp"
+
 
 namespace JS80P
 {
@@ -39,7 +41,7 @@ class Queue
         /*
         One shouldn't (re)allocate memory in the audio thread - using a
         dynamically growing std::vector here is cheating, but it should
-        settle after a while.
+        settle after a while. (Event queues use RingQueue instead.)
         */
         static constexpr SizeType DEFAULT_CAPACITY = 0;
 
@@ -69,6 +71,68 @@ class Queue
         SizeType size;
 };
 
+
+/**
+ * \brief A FIFO container with the same interface as \c Queue, but its
+ *        capacity is fixed and all its memory is allocated by the
+ *        constructor. Pushing into a full queue leaves the queue unchanged
+ *        and only increments the overflow counter.
+ */
+template<class Item>
+class RingQueue
+{
+    public:
+        typedef typename std::vector<Item>::size_type SizeType;
+
+        explicit RingQueue(SizeType const capacity) noexcept;
+
+        bool is_empty() const noexcept;
+        bool is_full() const noexcept;
+
+        /**
+         * \brief Append the item to the end of the queue, or drop it and
+         *        return \c false if the queue is full.
+         */
+        bool push(Item const& item) noexcept;
+
+        Item& pop() noexcept;
+        Item const& front() const noexcept;
+        Item& front() noexcept;
+        Item const& back() const noexcept;
+        Item& back() noexcept;
+        SizeType length() const noexcept;
+        Item const& operator[](SizeType const index) const noexcept;
+        Item& operator[](SizeType const index) noexcept;
+        void drop(SizeType const index) noexcept;
+
+        SizeType get_capacity() const noexcept;
+
+        /**
+         * \brief The largest length that the queue has reached since it was
+         *        created or since the last \c reset_statistics() call.
+         */
+        SizeType get_high_water_mark() const noexcept;
+
+        /**
+         * \brief The number of items that were dropped by \c push() since
+         *        the queue was created or since the last
+         *        \c reset_statistics() call.
+         */
+        SizeType get_overflows() const noexcept;
+
+        void reset_statistics() noexcept;
+
+    private:
+        SizeType wrap(SizeType const index) const noexcept;
+
+        std::vector<Item> items;
+        SizeType const capacity;
+        SizeType next_pop;
+        SizeType size;
+        SizeType high_water_mark;
+        SizeType overflows;
+};
+
 }
 
 #endif
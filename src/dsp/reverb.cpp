@@ -19,6 +19,8 @@
 #ifndef JS80P__DSP__REVERB_CPP
 #define JS80P__DSP__REVERB_CPP
 
+#include <algorithm>
+
 #include "dsp/reverb.hpp"
 
 #include "dsp/math.hpp"
@@ -49,8 +51,8 @@ Reverb<InputSignalProducerClass>::Reverb(
 ) : SideChainCompressableEffect<InputSignalProducerClass>(
         name,
         input,
-        15 + COMB_FILTERS,
-        &mixer
+        14,
+        &comb_filters
     ),
     type(name+ "TYP"),
     room_size(
@@ -111,8 +113,6 @@ Reverb<InputSignalProducerClass>::Reverb(
     distortion_level(name + "DST", 0.0, 1.0, 0.0),
     log_scale_frequencies(name + "LOG", ToggleParam::OFF),
     log_scale_high_pass_q(name + "LHQ", ToggleParam::OFF),
-    mixer(CombFilter::CHANNELS),
-    distortion_type("", Distortion::TYPE_DELAY_FEEDBACK),
     high_pass_filter_gain(
         "",
         Constants::BIQUAD_FILTER_GAIN_MIN,
@@ -121,156 +121,24 @@ Reverb<InputSignalProducerClass>::Reverb(
     ),
     high_pass_filter(
         input,
-        CombFilter::CHANNELS,
+        CombFilters::CHANNELS,
         high_pass_frequency,
         high_pass_q,
         high_pass_filter_gain
     ),
-    comb_filters{
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][0].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][1].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][2].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][3].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][4].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][5].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][6].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][7].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][8].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-        {
-            high_pass_filter,
-            StereoPannedDelayMode::NORMAL,
-            width,
-            room_reflectivity,
-            TUNINGS[0][9].delay_time,
-            DELAY_TIME_MAX,
-            high_shelf_filter_shared_buffers,
-            damping_frequency,
-            damping_gain,
-            distortion_level,
-            distortion_type
-
-        },
-    },
+    comb_filters(
+        high_pass_filter,
+        width,
+        room_reflectivity,
+        room_size,
+        DELAY_TIME_MAX,
+        high_shelf_filter_shared_buffers,
+        damping_frequency,
+        damping_gain,
+        distortion_level
+    ),
     previous_type(255)
 {
-    this->register_child(mixer);
-
     this->register_child(type);
     this->register_child(room_size);
     this->register_child(room_reflectivity);
@@ -283,21 +151,10 @@ Reverb<InputSignalProducerClass>::Reverb(
     this->register_child(log_scale_frequencies);
     this->register_child(log_scale_high_pass_q);
 
-    this->register_child(distortion_type);
-
     this->register_child(high_pass_filter_gain);
 
     this->register_child(high_pass_filter);
-
-    for (size_t i = 0; i != COMB_FILTERS; ++i) {
-        comb_filters[i].delay.set_feedback_signal_producer(
-            comb_filters[i].high_shelf_filter
-        );
-        comb_filters[i].delay.set_time_scale_param(room_size);
-
-        mixer.add(comb_filters[i]);
-        this->register_child(comb_filters[i]);
-    }
+    this->register_child(comb_filters);
 }
 
 
@@ -310,6 +167,14 @@ void Reverb<InputSignalProducerClass>::reset() noexcept
 }
 
 
+template<class InputSignalProducerClass>
+void Reverb<InputSignalProducerClass>::use_delay_buffer_arena(
+        DelayBufferArena& arena
+) noexcept {
+    comb_filters.use_delay_buffer_arena(arena);
+}
+
+
 template<class InputSignalProducerClass>
 Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -335,28 +200,42 @@ Sample const* const* Reverb<InputSignalProducerClass>::initialize_rendering(
         update_tunings(type);
     }
 
-    SignalProducer::produce< Mixer<CombFilter> >(mixer, round, sample_count);
+    SignalProducer::produce<CombFilters>(comb_filters, round, sample_count);
 
     return NULL;
 }
 
 
+template<class InputSignalProducerClass>
+Seconds Reverb<InputSignalProducerClass>::get_tail_length() const noexcept
+{
+    Tuning const* const tunings = TUNINGS[type.get_value()];
+    Seconds delay_time_max = 0.0;
+
+    for (size_t i = 0; i != COMB_FILTERS; ++i) {
+        delay_time_max = std::max(delay_time_max, tunings[i].delay_time);
+    }
+
+    return this->calculate_feedback_tail_length(
+        delay_time_max * room_size.get_value(),
+        room_reflectivity.get_value()
+    );
+}
+
+
 template<class InputSignalProducerClass>
 void Reverb<InputSignalProducerClass>::update_tunings(Byte const type) noexcept
 {
     Tuning const* const tunings = TUNINGS[type];
 
-    mixer.reset();
+    comb_filters.reset();
 
     for (size_t i = 0; i != COMB_FILTERS; ++i) {
         Tuning const& tuning = tunings[i];
-        CombFilter& comb_filter = comb_filters[i];
-
-        comb_filter.reset();
-        comb_filter.delay.time.set_value(tuning.delay_time);
-        comb_filter.set_panning_scale(tuning.panning_scale);
 
-        mixer.set_weight(i, tuning.weight);
+        comb_filters.set_lane(
+            (Integer)i, tuning.delay_time, tuning.panning_scale, tuning.weight
+        );
     }
 }
 
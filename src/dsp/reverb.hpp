@@ -24,9 +24,7 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.hpp"
-#include "dsp/delay.hpp"
-#include "dsp/distortion.hpp"
-#include "dsp/mixer.hpp"
+#include "dsp/comb_filter_bank.hpp"
 #include "dsp/param.hpp"
 #include "dsp/side_chain_compressable_effect.hpp"
 #include "dsp/signal_producer.hpp"
@@ -51,11 +49,11 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
         moving the shelving filter in front of the delay lines and then realized
         that their feedback lines need to be independent from each other and
         therefore cannot all go through the same filter instance: 2.
+
+        (The comb filters are lanes of a single CombFilterBank instead, which
+        keeps a separate filter state for each of them.)
         */
-        typedef DistortedHighShelfStereoPannedDelay<
-            HighPassedInput,
-            DelayCapabilities::DC_SCALABLE
-        > CombFilter;
+        typedef CombFilterBank<HighPassedInput, 10> CombFilters;
 
         class TypeParam : public ByteParam
         {
@@ -82,6 +80,11 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
 
         virtual void reset() noexcept override;
 
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena()
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
         TypeParam type;
         FloatParamS room_size;
         FloatParamS room_reflectivity;
@@ -100,6 +103,8 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
             Integer const sample_count
         ) noexcept JS80P_OVERRIDE;
 
+        virtual Seconds get_tail_length() const noexcept override;
+
     private:
         class Tuning
         {
@@ -117,7 +122,7 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
                 Number const panning_scale;
         };
 
-        static constexpr size_t COMB_FILTERS = 10;
+        static constexpr size_t COMB_FILTERS = CombFilters::LANES;
 
         static constexpr Number ROOM_SIZE_MAX = 3.0;
         static constexpr Seconds DELAY_TIME_MAX = 0.150 * ROOM_SIZE_MAX;
@@ -271,13 +276,10 @@ class Reverb : public SideChainCompressableEffect<InputSignalProducerClass>
 
         void update_tunings(Byte const type) noexcept;
 
-        Mixer<CombFilter> mixer;
-
-        Distortion::TypeParam distortion_type;
         FloatParamS high_pass_filter_gain;
 
         HighPassedInput high_pass_filter;
-        CombFilter comb_filters[COMB_FILTERS];
+        CombFilters comb_filters;
         Byte previous_type;
 };
 
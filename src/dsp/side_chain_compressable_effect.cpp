@@ -108,7 +108,22 @@ Sample const* const* SideChainCompressableEffect<
     );
 
     if (buffer != NULL) {
-        fast_bypass();
+        /*
+        The gain ramp and the peak tracker are not rendered by anything else,
+        so they are kept running on the silent input while sleeping, in order
+        to let the effect wake up in the same compression state in which an
+        effect which has never slept would be.
+        */
+        if (
+                !this->is_sleeping
+                || Math::is_close(
+                    side_chain_compression_ratio.get_value(), NO_OP_RATIO
+                )
+        ) {
+            fast_bypass();
+        } else {
+            update_gain(round, sample_count);
+        }
 
         return buffer;
     }
@@ -123,6 +138,18 @@ Sample const* const* SideChainCompressableEffect<
         return NULL;
     }
 
+    update_gain(round, sample_count);
+
+    return NULL;
+}
+
+
+template<class InputSignalProducerClass>
+void SideChainCompressableEffect<InputSignalProducerClass>::update_gain(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    Number const ratio_value = side_chain_compression_ratio.get_value();
     Byte const new_mode = side_chain_compression_mode.get_value();
 
     if (new_mode != previous_mode) {
@@ -181,8 +208,6 @@ Sample const* const* SideChainCompressableEffect<
     );
 
     is_silent_ = gain_buffer == NULL && gain.get_value() < 0.000003;
-
-    return NULL;
 }
 
 
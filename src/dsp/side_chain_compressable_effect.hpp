@@ -96,6 +96,11 @@ class SideChainCompressableEffect : public Effect<InputSignalProducerClass>
         void clear_state() noexcept;
         void fast_bypass() noexcept;
 
+        void update_gain(
+            Integer const round,
+            Integer const sample_count
+        ) noexcept;
+
         void compress(
             Sample const peak,
             Number const target_peak_db,
@@ -41,6 +41,7 @@ Sample const* const* SignalProducer::produce(
     }
 
     Seconds const start_time = signal_producer.current_time;
+    Integer const start_sample = signal_producer.current_sample;
     Integer const count = (
         signal_producer.sample_count_or_block_size(sample_count)
     );
@@ -76,18 +77,23 @@ Sample const* const* SignalProducer::produce(
                 + (Seconds)current_sample_index
                 * signal_producer.sampling_period
             );
+            signal_producer.current_sample = (
+                start_sample + current_sample_index
+            );
         }
     } else {
         signal_producer.render(round, 0, count, buffer);
         signal_producer.current_time += (
             (Seconds)count * signal_producer.sampling_period
         );
+        signal_producer.current_sample += count;
     }
 
     signal_producer.finalize_rendering(round, count);
 
     if (signal_producer.events.is_empty()) {
         signal_producer.current_time = 0.0;
+        signal_producer.current_sample = 0;
     }
 
     return buffer;
@@ -130,7 +136,11 @@ SignalProducer::SignalProducer(
         SignalProducer* const buffer_owner
 ) noexcept
     : channels(0 <= channels ? channels : 0),
-    events((Queue<Event>::SizeType)number_of_events),
+    events(
+        (RingQueue<Event>::SizeType)(
+            std::max((Integer)0, number_of_events) + EVENT_QUEUE_HEADROOM
+        )
+    ),
     buffer(NULL),
     last_sample_count(0),
     block_size(DEFAULT_BLOCK_SIZE),
@@ -139,8 +149,10 @@ SignalProducer::SignalProducer(
     nyquist_frequency(DEFAULT_SAMPLE_RATE * 0.5),
     bpm(DEFAULT_BPM),
     current_time(0.0),
+    current_sample(0),
     cached_round(-1),
     cached_buffer(NULL),
+    coalesced_events(0),
     has_external_buffer(buffer_owner != NULL),
     buffer_owner(has_external_buffer ? buffer_owner : this),
     cached_silence_round(-1),
@@ -386,17 +398,63 @@ void SignalProducer::schedule(
         Byte const byte_param_1,
         Byte const byte_param_2
 ) noexcept {
-    events.push(
-        Event(
-            type,
-            current_time + time_offset,
-            int_param,
-            number_param_1,
-            number_param_2,
-            byte_param_1,
-            byte_param_2
-        )
+    Event event(
+        type,
+        current_time + time_offset,
+        int_param,
+        number_param_1,
+        number_param_2,
+        byte_param_1,
+        byte_param_2
+    );
+
+    /*
+    The conversion to a sample position is done only once, here, so that
+    produce() can split the rendering at event boundaries without going back
+    and forth between seconds and samples at every stop.
+    */
+    event.sample_position = (
+        current_sample + (Integer)std::ceil(time_offset * sample_rate)
     );
+
+    if (JS80P_UNLIKELY(events.is_full())) {
+        coalesce_events();
+    }
+
+    events.push(std::move(event));
+
+    handle_scheduled_event();
+}
+
+
+void SignalProducer::handle_scheduled_event() noexcept
+{
+}
+
+
+void SignalProducer::coalesce_events() noexcept
+{
+    /*
+    An EVT_CANCEL marks the point from which the events that follow it
+    replace whatever was scheduled before, so the events which precede the
+    first such marker only affect the time until the marker takes effect.
+    Dropping those keeps the state that the producer is supposed to end up
+    in, unlike dropping the new event would (e.g. a voice would be stuck
+    with the pitch of an earlier note, or it would never stop).
+    */
+    RingQueue<Event>::SizeType const length = events.length();
+
+    for (RingQueue<Event>::SizeType i = 1; i != length; ++i) {
+        if (events[i].type == EVT_CANCEL) {
+            for (RingQueue<Event>::SizeType j = 0; j != i; ++j) {
+                events.pop();
+            }
+
+            coalesced_events += (Integer)i;
+
+            return;
+        }
+    }
 }
 
 
@@ -421,7 +479,7 @@ void SignalProducer::cancel_events_at(Seconds const time_offset) noexcept
 
     Seconds const time = time_offset + current_time;
 
-    for (Queue<Event>::SizeType i = 0, l = events.length(); i != l; ++i) {
+    for (RingQueue<Event>::SizeType i = 0, l = events.length(); i != l; ++i) {
         if (events[i].time_offset >= time) {
             events.drop(i);
             break;
@@ -442,7 +500,7 @@ void SignalProducer::cancel_events_after(Seconds const time_offset) noexcept
 
     Seconds const time = time_offset + current_time;
 
-    for (Queue<Event>::SizeType i = 0, l = events.length(); i != l; ++i) {
+    for (RingQueue<Event>::SizeType i = 0, l = events.length(); i != l; ++i) {
         if (events[i].time_offset > time) {
             events.drop(i);
             break;
@@ -471,6 +529,37 @@ Seconds SignalProducer::get_last_event_time_offset() const noexcept
 }
 
 
+Integer SignalProducer::get_event_queue_capacity() const noexcept
+{
+    return (Integer)events.get_capacity();
+}
+
+
+Integer SignalProducer::get_event_queue_high_water_mark() const noexcept
+{
+    return (Integer)events.get_high_water_mark();
+}
+
+
+Integer SignalProducer::get_dropped_events() const noexcept
+{
+    return (Integer)events.get_overflows();
+}
+
+
+Integer SignalProducer::get_coalesced_events() const noexcept
+{
+    return coalesced_events;
+}
+
+
+void SignalProducer::reset_event_queue_statistics() noexcept
+{
+    events.reset_statistics();
+    coalesced_events = 0;
+}
+
+
 Sample const* const* SignalProducer::initialize_rendering(
         Integer const round,
         Integer const sample_count
@@ -521,21 +610,11 @@ bool SignalProducer::has_upcoming_events(
 ) const noexcept {
     return (
         !events.is_empty()
-        && is_time_offset_before_sample_count(
-            events.front().time_offset, sample_count
-        )
+        && events.front().sample_position <= current_sample + sample_count
     );
 }
 
 
-bool SignalProducer::is_time_offset_before_sample_count(
-            Seconds const time_offset,
-            Integer const sample_count
-) const noexcept {
-    return time_offset <= sample_count_to_time_offset(sample_count);
-}
-
-
 Integer SignalProducer::sample_count_or_block_size(
         Integer const sample_count
 ) const noexcept {
@@ -557,8 +636,15 @@ Sample** SignalProducer::get_buffer() const noexcept
 }
 
 
+SignalProducer::Event::Event() noexcept
+    : Event(0)
+{
+}
+
+
 SignalProducer::Event::Event(Type const type) noexcept
     : time_offset(0.0),
+    sample_position(0),
     int_param(0),
     number_param_1(0.0),
     number_param_2(0.0),
@@ -579,6 +665,7 @@ SignalProducer::Event::Event(
         Byte const byte_param_2
 ) noexcept
     : time_offset(time_offset),
+    sample_position(0),
     int_param(int_param),
     number_param_1(number_param_1),
     number_param_2(number_param_2),
@@ -596,15 +683,15 @@ void SignalProducer::handle_events(
         Integer const sample_count,
         Integer& next_stop
 ) noexcept {
-    Seconds const handle_until = signal_producer.current_time;
+    Integer const handle_until = signal_producer.current_sample;
 
     while (!signal_producer.events.is_empty()) {
         Event const& next_event = signal_producer.events.front();
 
-        if (next_event.time_offset > handle_until) {
-            next_stop = current_sample_index + (Integer)std::ceil(
-                (next_event.time_offset - handle_until)
-                * signal_producer.sample_rate
+        if (next_event.sample_position > handle_until) {
+            next_stop = (
+                current_sample_index
+                + (next_event.sample_position - handle_until)
             );
 
             if (next_stop > sample_count) {
@@ -35,11 +35,20 @@ namespace JS80P
 class SignalProducer
 {
     public:
+        /**
+         * \brief An event scheduled for the producer. \c time_offset is the
+         *        exact time of the event (including the sub-sample fraction),
+         *        \c sample_position is the index of the first sample on the
+         *        producer's event clock at or after that time, so that
+         *        splitting the rendering at event boundaries needs only
+         *        integer arithmetic.
+         */
         class Event
         {
             public:
                 typedef Byte Type;
 
+                Event() noexcept;
                 explicit Event(Type const type) noexcept;
 
                 Event(Event const& event) noexcept = default;
@@ -59,6 +68,7 @@ class SignalProducer
                 Event& operator=(Event&& event) noexcept = default;
 
                 Seconds time_offset;
+                Integer sample_position;
                 Integer int_param;
                 Number number_param_1;
                 Number number_param_2;
@@ -68,6 +78,15 @@ class SignalProducer
         };
 
         static constexpr Integer DEFAULT_BLOCK_SIZE = 256;
+
+        /*
+        Extra slots for the event queue on top of the number of events that
+        the producer expects to have pending; see coalesce_events() for what
+        happens when the queue is full.
+        */
+        static constexpr Integer EVENT_QUEUE_HEADROOM = (
+            JS80P_EVENT_QUEUE_HEADROOM
+        );
         static constexpr Frequency DEFAULT_SAMPLE_RATE = 44100.0;
 
         static constexpr Number SILENCE_THRESHOLD_DB = -150.0;
@@ -186,6 +205,30 @@ class SignalProducer
         bool has_events_after(Seconds const time_offset) const noexcept;
         Seconds get_last_event_time_offset() const noexcept;
 
+        Integer get_event_queue_capacity() const noexcept;
+
+        /**
+         * \brief The largest number of events that were pending at the same
+         *        time since the producer was created or since the last
+         *        \c reset_event_queue_statistics() call.
+         */
+        Integer get_event_queue_high_water_mark() const noexcept;
+
+        /**
+         * \brief The number of new events that were dropped because the
+         *        event queue was full, and no older events could be
+         *        coalesced to make room for them.
+         */
+        Integer get_dropped_events() const noexcept;
+
+        /**
+         * \brief The number of older events that were discarded in order to
+         *        make room for new ones when the event queue was full.
+         */
+        Integer get_coalesced_events() const noexcept;
+
+        void reset_event_queue_statistics() noexcept;
+
     protected:
         /**
          * \brief Implement preparations for sample rendering in this method,
@@ -234,6 +277,16 @@ class SignalProducer
          */
         void handle_event(Event const& event) noexcept;
 
+        /**
+         * \brief Called by \c schedule() (and by the methods which cancel
+         *        events) after the event is added to the queue, so that the
+         *        producer can make sure that it will be rendered.
+         *
+         * \note This is a virtual method so that it is also called when the
+         *       event is scheduled through a \c SignalProducer reference.
+         */
+        virtual void handle_scheduled_event() noexcept;
+
         Sample** reallocate_buffer(Sample** const old_buffer) const noexcept;
         Sample** allocate_buffer() const noexcept;
         Sample** free_buffer(Sample** const old_buffer) const noexcept;
@@ -255,11 +308,6 @@ class SignalProducer
 
         bool has_upcoming_events(Integer const sample_count) const noexcept;
 
-        bool is_time_offset_before_sample_count(
-            Seconds const time_offset,
-            Integer const sample_count
-        ) const noexcept;
-
         Integer sample_count_or_block_size(
             Integer const sample_count = -1
         ) const noexcept;
@@ -270,7 +318,7 @@ class SignalProducer
 
         Integer const channels;
 
-        Queue<Event> events;
+        RingQueue<Event> events;
         Sample** buffer;
         Integer last_sample_count;
         Integer block_size;
@@ -279,12 +327,15 @@ class SignalProducer
         Frequency nyquist_frequency;
         Number bpm;
         Seconds current_time;
+        Integer current_sample;
         Integer cached_round;
         Sample const* const* cached_buffer;
 
     private:
         typedef std::vector<SignalProducer*> Children;
 
+        void coalesce_events() noexcept;
+
         template<class SignalProducerClass>
         static void handle_events(
             SignalProducerClass& signal_producer,
@@ -293,6 +344,7 @@ class SignalProducer
             Integer& next_stop
         ) noexcept;
 
+        Integer coalesced_events;
         bool const has_external_buffer;
         SignalProducer* const buffer_owner;
 
@@ -551,7 +551,8 @@ Tape<InputSignalProducerClass, required_bypass_toggle_value>::Tape(
     delay(low_pass_filter, NULL, TapeParams::DELAY_TIME_MAX, CHANNELS),
     transition_duration(0.0),
     previous_bypass_toggle_value(params.bypass_toggle.get_value()),
-    needs_ff_rescheduling(true)
+    needs_ff_rescheduling(true),
+    idle_samples(0)
 {
     this->register_child(pre_dist_high_shelf_filter);
     this->register_child(distortion);
@@ -610,6 +611,7 @@ void Tape<
 
     transition_duration = 0.0;
     needs_ff_rescheduling = true;
+    idle_samples = 0;
 
     params.state = TapeParams::State::TAPE_STATE_INIT;
 
@@ -624,6 +626,26 @@ void Tape<
 }
 
 
+template<class InputSignalProducerClass, Byte required_bypass_toggle_value>
+void Tape<
+        InputSignalProducerClass,
+        required_bypass_toggle_value
+>::use_delay_buffer_arena(DelayBufferArena& arena) noexcept
+{
+    delay.use_delay_buffer_arena(arena, true);
+}
+
+
+template<class InputSignalProducerClass, Byte required_bypass_toggle_value>
+void Tape<
+        InputSignalProducerClass,
+        required_bypass_toggle_value
+>::commit_delay_buffer_now() const noexcept
+{
+    delay.commit_delay_buffer_now();
+}
+
+
 template<class InputSignalProducerClass, Byte required_bypass_toggle_value>
 Sample const* const* Tape<
         InputSignalProducerClass,
@@ -641,6 +663,14 @@ Sample const* const* Tape<
     Byte const toggle = params.bypass_toggle.get_value();
 
     if (JS80P_UNLIKELY(toggle != previous_bypass_toggle_value)) {
+        /*
+        Releasing the delay buffer first also spares clearing it, since its
+        memory is going to be given back anyway.
+        */
+        if (toggle != required_bypass_toggle_value) {
+            delay.release_delay_buffer();
+        }
+
         this->reset();
 
         previous_bypass_toggle_value = toggle;
@@ -699,9 +729,17 @@ Sample const* const* Tape<
     }
 
     if (result != NULL) {
+        release_delay_buffer_when_idle(sample_count);
+
         return result;
     }
 
+    idle_samples = 0;
+
+    if (JS80P_UNLIKELY(!delay.acquire_delay_buffer())) {
+        return this->input_buffer;
+    }
+
     volume_buffer = FloatParamS::produce_if_not_constant(
         params.volume, round, sample_count
     );
@@ -712,6 +750,24 @@ Sample const* const* Tape<
 }
 
 
+template<class InputSignalProducerClass, Byte required_bypass_toggle_value>
+void Tape<
+        InputSignalProducerClass,
+        required_bypass_toggle_value
+>::release_delay_buffer_when_idle(Integer const sample_count) noexcept
+{
+    /*
+    Tweaking a knob through its neutral position shouldn't make the tape wait
+    for its memory to be committed again.
+    */
+    if (idle_samples < this->sample_rate * DELAY_BUFFER_RELEASE_DELAY) {
+        idle_samples += sample_count;
+    } else {
+        delay.release_delay_buffer();
+    }
+}
+
+
 template<class InputSignalProducerClass, Byte required_bypass_toggle_value>
 Sample const* const* Tape<
         InputSignalProducerClass,
@@ -176,6 +176,24 @@ class Tape : public Filter<InputSignalProducerClass>
 
         virtual void reset() noexcept override;
 
+        /**
+         * \brief See \c Delay::use_delay_buffer_arena(). The delay buffer of
+         *        the tape is an on-demand region, which is committed only
+         *        while the tape is engaged, and it is given back after the
+         *        tape has been idle for a while. Until the background thread
+         *        of the arena commits it, the tape lets its input through.
+         */
+        void use_delay_buffer_arena(DelayBufferArena& arena) noexcept;
+
+        /**
+         * \brief Commit the delay buffer on the calling thread, when the
+         *        tape is about to be engaged, so that it doesn't have to
+         *        wait for the background thread of the arena.
+         *
+         * \warning Not real-time safe.
+         */
+        void commit_delay_buffer_now() const noexcept;
+
     protected:
         Sample const* const* initialize_rendering(
             Integer const round,
@@ -198,6 +216,8 @@ class Tape : public Filter<InputSignalProducerClass>
         static constexpr Seconds START_TIME_MIN = 0.05;
         static constexpr Seconds STOP_START_DELAY = 0.1;
 
+        static constexpr Seconds DELAY_BUFFER_RELEASE_DELAY = 5.0;
+
         Sample const* const* initialize_init_rendering(
             Integer const round,
             Integer const sample_count
@@ -259,6 +279,10 @@ class Tape : public Filter<InputSignalProducerClass>
 
         bool is_bypassable() const noexcept;
 
+        void release_delay_buffer_when_idle(
+            Integer const sample_count
+        ) noexcept;
+
         void schedule_stop(Seconds const duration) noexcept;
         void schedule_start() noexcept;
         void schedule_fast_forward_start(Seconds const duration) noexcept;
@@ -277,6 +301,7 @@ class Tape : public Filter<InputSignalProducerClass>
         Seconds transition_duration;
         Byte previous_bypass_toggle_value;
         bool needs_ff_rescheduling;
+        Integer idle_samples;
 };
 
 }
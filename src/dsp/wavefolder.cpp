@@ -40,7 +40,7 @@ bool Wavefolder<InputSignalProducerClass>::is_initialized = false;
 
 
 template<class InputSignalProducerClass>
-Sample Wavefolder<
+Number Wavefolder<
         InputSignalProducerClass
 >::F0_table[Wavefolder<InputSignalProducerClass>::TABLE_SIZE] = {};
 
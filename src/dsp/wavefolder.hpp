@@ -121,7 +121,7 @@ class Wavefolder : public Filter<InputSignalProducerClass>
         );
 
         // static Sample f_table[TABLE_SIZE];
-        static Sample F0_table[TABLE_SIZE];
+        static Number F0_table[TABLE_SIZE];
         static bool is_initialized;
 
         static void initialize_class() noexcept;
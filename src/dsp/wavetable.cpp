@@ -19,7 +19,11 @@
 #ifndef JS80P__DSP__WAVETABLE_CPP
 #define JS80P__DSP__WAVETABLE_CPP
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
 
 #include "dsp/wavetable.hpp"
 
@@ -85,80 +89,330 @@ Number Wavetable::scale_phase_offset(Number const phase_offset) noexcept
 }
 
 
+Integer Wavetable::next_level_partials(
+        Integer const level_partials,
+        Integer const partials
+) noexcept {
+    Integer const next = (
+        level_partials < EXACT_LEVELS
+            ? level_partials + 1
+            : std::max(
+                level_partials + 1,
+                (Integer)std::round((Number)level_partials * LEVEL_RATIO)
+            )
+    );
+
+    return std::min(next, partials);
+}
+
+
+Integer Wavetable::count_levels(Integer const partials) noexcept
+{
+    Integer levels = 1;
+
+    for (
+            Integer count = 1;
+            count != partials;
+            count = next_level_partials(count, partials)
+    ) {
+        ++levels;
+    }
+
+    return levels;
+}
+
+
+Integer Wavetable::count_samples(Integer const partials) noexcept
+{
+    return count_levels(partials) * SIZE;
+}
+
+
 Wavetable::Wavetable(
         Number const coefficients[],
         Integer const coefficients_length
-) noexcept : partials(coefficients_length)
+) noexcept
+    : partials(coefficients_length),
+    levels(count_levels(coefficients_length)),
+    owns_samples(true)
 {
-    samples = new Sample*[partials];
+    samples = new float[levels * SIZE];
+
+    initialize_levels();
+    update_coefficients(coefficients);
+    normalize();
+}
 
-    for (Integer i = 0; i != partials; ++i) {
-        samples[i] = new Sample[SIZE];
-    }
 
+Wavetable::Wavetable(
+        Number const coefficients[],
+        Integer const coefficients_length,
+        float* const samples
+) noexcept
+    : partials(coefficients_length),
+    levels(count_levels(coefficients_length)),
+    owns_samples(false),
+    samples(samples)
+{
+    initialize_levels();
     update_coefficients(coefficients);
     normalize();
 }
 
 
+Wavetable::Wavetable(
+        Integer const coefficients_length,
+        float const* const samples
+) noexcept
+    : partials(coefficients_length),
+    levels(count_levels(coefficients_length)),
+    owns_samples(false),
+    samples((float*)samples)
+{
+    initialize_levels();
+}
+
+
+void Wavetable::initialize_levels() noexcept
+{
+    level_partials = new Integer[levels];
+    partials_to_level = new Integer[partials + 1];
+    level_width_inv = new Sample[levels];
+
+    partials_to_level[0] = 0;
+
+    for (Integer level = 0, count = 1; level != levels; ++level) {
+        Integer const next_count = next_level_partials(count, partials);
+
+        level_partials[level] = count;
+        level_width_inv[level] = (
+            next_count > count
+                ? (Sample)(1.0 / (Number)(next_count - count))
+                : 0.0
+        );
+
+        for (Integer i = count; i != next_count; ++i) {
+            partials_to_level[i] = level;
+        }
+
+        count = next_count;
+    }
+
+    partials_to_level[partials] = levels - 1;
+}
+
+
 void Wavetable::update_coefficients(Number const coefficients[]) noexcept
 {
-    Integer frequency = 1;
+    /*
+    The table of each level contains the sum of the partials up to the
+    partial count of that level. Only a single period is synthesized, and it
+    is copied to both halves of the table.
+    */
+
+    Integer const direct_levels = count_direct_levels();
+
+    update_levels_directly(coefficients, direct_levels);
+
+    if (direct_levels != levels) {
+        update_levels_with_fft(coefficients, direct_levels);
+    }
+}
+
 
+Integer Wavetable::count_direct_levels() const noexcept
+{
     /*
-    samples[0]: 0 partials above fundamental
-    samples[1]: 1 partial above fundamental
-    ...
-    samples[n]: n partials above fundamental
+    The gap between the partial counts of consecutive levels never shrinks,
+    so the levels which are cheaper to accumulate directly form a prefix.
     */
 
-    Sample* samples = this->samples[0];
+    Integer level = 1;
 
-    for (Integer j = 0; j != SIZE; ++j) {
-        samples[j] = (
-            coefficients[0] * sines[(j * frequency) & TABLE_INDEX_MASK]
-        );
+    for (; level != levels; ++level) {
+        Integer const gap = level_partials[level] - level_partials[level - 1];
+
+        if (gap > FFT_MIN_LEVEL_GAP) {
+            break;
+        }
     }
 
-    for (Integer i = 1, prev_i = 0; i != partials; ++i, ++prev_i) {
-        ++frequency;
+    return level;
+}
 
-        Sample const* const prev_samples = samples;
-        samples = this->samples[i];
 
-        for (Integer j = 0; j != SIZE; ++j) {
-            samples[j] = (
-                prev_samples[j]
-                + coefficients[i] * sines[(j * frequency) & TABLE_INDEX_MASK]
-            );
+void Wavetable::update_levels_directly(
+        Number const coefficients[],
+        Integer const direct_levels
+) noexcept {
+    /*
+    Each level is built from the table of the previous level by adding the
+    partials that are missing from it. The sums are calculated in double
+    precision, only the results are rounded when they are stored.
+    */
+
+    float const* previous_table = NULL;
+    Integer partial = 0;
+
+    for (Integer level = 0; level != direct_levels; ++level) {
+        Integer const level_end = level_partials[level];
+        float* const table = samples + level * SIZE;
+
+        for (Integer j = 0; j != PERIOD_SIZE; ++j) {
+            Number sum = previous_table == NULL ? 0.0 : previous_table[j];
+
+            for (Integer p = partial; p != level_end; ++p) {
+                sum += (
+                    coefficients[p] * sines[(j * (p + 1)) & PERIOD_INDEX_MASK]
+                );
+            }
+
+            table[j] = table[j + PERIOD_SIZE] = (float)sum;
         }
+
+        partial = level_end;
+        previous_table = table;
     }
 }
 
 
-void Wavetable::normalize() noexcept
+void Wavetable::update_levels_with_fft(
+        Number const coefficients[],
+        Integer const first_level
+) noexcept {
+    /*
+    Since the tables are real valued, two levels can be synthesized with a
+    single complex transform: the spectrum of the first one is placed so that
+    it produces the real part of the result, and the spectrum of the second
+    one is placed so that it produces the imaginary part. A sine partial
+    with the coefficient c at bin k corresponds to -i * c / 2 at bin k and to
+    i * c / 2 at bin N - k.
+    */
+
+    Number* const buffer = new Number[PERIOD_SIZE * 2];
+    Number* const re = buffer;
+    Number* const im = buffer + PERIOD_SIZE;
+
+    for (Integer level = first_level; level < levels; level += 2) {
+        bool const is_pair = level + 1 != levels;
+
+        std::fill_n(buffer, PERIOD_SIZE * 2, 0.0);
+
+        for (Integer partial = 1; partial <= level_partials[level]; ++partial) {
+            Number const half_coefficient = 0.5 * coefficients[partial - 1];
+
+            im[partial] -= half_coefficient;
+            im[PERIOD_SIZE - partial] += half_coefficient;
+        }
+
+        if (is_pair) {
+            Integer const partials = level_partials[level + 1];
+
+            for (Integer partial = 1; partial <= partials; ++partial) {
+                Number const half_coefficient = (
+                    0.5 * coefficients[partial - 1]
+                );
+
+                re[partial] += half_coefficient;
+                re[PERIOD_SIZE - partial] -= half_coefficient;
+            }
+        }
+
+        inverse_fft(re, im);
+
+        store_period(level, re);
+
+        if (is_pair) {
+            store_period(level + 1, im);
+        }
+    }
+
+    delete[] buffer;
+}
+
+
+void Wavetable::inverse_fft(Number* const re, Number* const im) noexcept
 {
-    Sample max = 0.0;
+    /*
+    Iterative, in-place, radix-2 Cooley-Tukey transform of PERIOD_SIZE
+    complex numbers, without normalization. The twiddle factors are taken
+    from the sines table which holds exactly one period of PERIOD_SIZE
+    samples.
+    */
 
-    for (Integer i = 0; i != partials; ++i) {
-        Sample const* samples = this->samples[i];
+    constexpr Integer quarter = PERIOD_SIZE / 4;
 
-        for (Integer j = 0; j != SIZE; ++j) {
-            Sample const sample = std::fabs(samples[j]);
+    for (Integer i = 1, j = 0; i != PERIOD_SIZE; ++i) {
+        Integer bit = PERIOD_SIZE >> 1;
 
-            if (sample > max) {
-                max = sample;
+        for (; (j & bit) != 0; bit >>= 1) {
+            j ^= bit;
+        }
+
+        j ^= bit;
+
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (Integer length = 2; length <= PERIOD_SIZE; length <<= 1) {
+        Integer const half_length = length >> 1;
+        Integer const twiddle_step = PERIOD_SIZE / length;
+
+        for (Integer start = 0; start != PERIOD_SIZE; start += length) {
+            for (Integer k = 0; k != half_length; ++k) {
+                Integer const twiddle_index = k * twiddle_step;
+                Number const w_re = sines[twiddle_index + quarter];
+                Number const w_im = sines[twiddle_index];
+                Integer const a = start + k;
+                Integer const b = a + half_length;
+                Number const b_re = re[b] * w_re - im[b] * w_im;
+                Number const b_im = re[b] * w_im + im[b] * w_re;
+
+                re[b] = re[a] - b_re;
+                im[b] = im[a] - b_im;
+                re[a] += b_re;
+                im[a] += b_im;
             }
         }
     }
+}
 
-    for (Integer i = 0; i != partials; ++i) {
-        Sample* const samples = this->samples[i];
 
-        for (Integer j = 0; j != SIZE; ++j) {
-            samples[j] /= max;
+void Wavetable::store_period(
+        Integer const level,
+        Number const* const period
+) noexcept {
+    float* const table = samples + level * SIZE;
+
+    for (Integer j = 0; j != PERIOD_SIZE; ++j) {
+        table[j] = table[j + PERIOD_SIZE] = (float)period[j];
+    }
+}
+
+
+void Wavetable::normalize() noexcept
+{
+    Integer const size = levels * SIZE;
+    float max = 0.0f;
+
+    for (Integer i = 0; i != size; ++i) {
+        float const sample = std::fabs(samples[i]);
+
+        if (sample > max) {
+            max = sample;
         }
     }
+
+    if (max == 0.0f) {
+        return;
+    }
+
+    for (Integer i = 0; i != size; ++i) {
+        samples[i] /= max;
+    }
 }
 
 
@@ -182,16 +436,27 @@ bool Wavetable::has_single_partial() const noexcept
 
 Wavetable::~Wavetable()
 {
-    for (Integer i = 0; i != partials; ++i) {
-        delete[] samples[i];
-    }
+    delete[] level_partials;
+    delete[] partials_to_level;
+    delete[] level_width_inv;
 
-    delete[] samples;
+    if (owns_samples) {
+        delete[] samples;
+    }
 
+    level_partials = NULL;
+    partials_to_level = NULL;
+    level_width_inv = NULL;
     samples = NULL;
 }
 
 
+float const* Wavetable::get_table(Integer const level) const noexcept
+{
+    return samples + level * SIZE;
+}
+
+
 template<
         Wavetable::Interpolation interpolation,
         bool single_partial,
@@ -209,15 +474,23 @@ void Wavetable::lookup(
 ) const noexcept {
     Frequency const abs_frequency = std::fabs(frequency);
 
-    if (JS80P_UNLIKELY(abs_frequency < 0.0000001)) {
+    if (JS80P_UNLIKELY(abs_frequency < MIN_FREQUENCY)) {
         sample = 1.0;
 
+        if constexpr (with_subharmonic) {
+            subharmonic_sample = 0.0;
+        }
+
         return;
     }
 
     if (JS80P_UNLIKELY(abs_frequency > state.nyquist_frequency)) {
         sample = 0.0;
 
+        if constexpr (with_subharmonic) {
+            subharmonic_sample = 0.0;
+        }
+
         return;
     }
 
@@ -225,9 +498,18 @@ void Wavetable::lookup(
 
     state.sample_index += state.scale * (Number)frequency;
 
-    if constexpr (single_partial) {
-        state.table_indices[0] = 0;
-
+    if (select_tables<single_partial>(state, abs_frequency)) {
+        interpolate<
+            interpolation, true, with_subharmonic, is_pulse, need_pulse_scaling
+        >(
+            state,
+            abs_frequency,
+            sample_index + phase_offset,
+            pulse_width,
+            sample,
+            subharmonic_sample
+        );
+    } else {
         interpolate<
             interpolation, false, with_subharmonic, is_pulse, need_pulse_scaling
         >(
@@ -238,55 +520,44 @@ void Wavetable::lookup(
             sample,
             subharmonic_sample
         );
+    }
+}
+
+
+template<bool single_partial>
+bool Wavetable::select_tables(
+        WavetableState& state,
+        Frequency const abs_frequency
+) const noexcept {
+    if constexpr (single_partial) {
+        state.table_indices[0] = 0;
+
+        return false;
     } else {
         Sample const max_partials = (
             (Sample)(state.nyquist_frequency / abs_frequency)
         );
         Integer const max_partials_int = (Integer)max_partials;
-        Integer const partials = this->partials;
-        Integer const more_partials_index = (
-            std::max((Integer)0, std::min(partials, max_partials_int) - 1)
+        Integer const level = (
+            partials_to_level[
+                std::max((Integer)1, std::min(partials, max_partials_int))
+            ]
         );
 
-        if (more_partials_index == 0 || max_partials_int > partials) {
-            state.table_indices[0] = more_partials_index;
+        if (level == 0 || max_partials_int >= partials) {
+            state.table_indices[0] = level;
 
-            interpolate<
-                interpolation,
-                false,
-                with_subharmonic,
-                is_pulse,
-                need_pulse_scaling
-            >(
-                state,
-                abs_frequency,
-                sample_index + phase_offset,
-                pulse_width,
-                sample,
-                subharmonic_sample
-            );
-
-            return;
+            return false;
         }
 
-        Integer const fewer_partials_index = (
-            std::max((Integer)0, more_partials_index - 1)
+        state.table_indices[0] = level - 1;
+        state.table_indices[1] = level;
+        state.more_partials_weight = (
+            (max_partials - (Sample)level_partials[level])
+            * level_width_inv[level]
         );
 
-        state.table_indices[0] = fewer_partials_index;
-        state.table_indices[1] = more_partials_index;
-        state.more_partials_weight = max_partials - std::floor(max_partials);
-
-        interpolate<
-            interpolation, true, with_subharmonic, is_pulse, need_pulse_scaling
-        >(
-            state,
-            abs_frequency,
-            sample_index + phase_offset,
-            pulse_width,
-            sample,
-            subharmonic_sample
-        );
+        return true;
     }
 }
 
@@ -410,10 +681,10 @@ void Wavetable::interpolate_sample_linear(
     Integer const sample_1_index = (Integer)sample_index & mask;
     Integer const sample_2_index = (sample_1_index + 1) & mask;
 
-    Sample const* const table_1 = samples[state.table_indices[0]];
+    float const* const table_1 = get_table(state.table_indices[0]);
 
     if constexpr (table_interpolation) {
-        Sample const* const table_2 = samples[state.table_indices[1]];
+        float const* const table_2 = get_table(state.table_indices[1]);
 
         sample = Math::combine(
             state.more_partials_weight,
@@ -488,7 +759,7 @@ void Wavetable::interpolate_sample_lagrange(
     Integer const sample_2_index = (sample_1_index + 1) & mask;
     Integer const sample_3_index = (sample_1_index + 2) & mask;
 
-    Sample const* const table_1 = samples[state.table_indices[0]];
+    float const* const table_1 = get_table(state.table_indices[0]);
 
     /* Formula and notation from http://dlmf.nist.gov/3.3#ii */
 
@@ -504,7 +775,7 @@ void Wavetable::interpolate_sample_lagrange(
     Sample const a_3 = 0.5 * (t_sqr + t);
 
     if constexpr (table_interpolation) {
-        Sample const* const table_2 = samples[state.table_indices[1]];
+        float const* const table_2 = get_table(state.table_indices[1]);
 
         Sample const f_2_1 = table_2[sample_1_index];
         Sample const f_2_2 = table_2[sample_2_index];
@@ -550,7 +821,7 @@ constexpr Integer Wavetable::get_index_mask() noexcept
 }
 
 
-StandardWaveforms const StandardWaveforms::standard_waveforms;
+StandardWaveforms StandardWaveforms::standard_waveforms;
 
 
 Wavetable const* StandardWaveforms::sine() noexcept
@@ -559,134 +830,394 @@ Wavetable const* StandardWaveforms::sine() noexcept
 }
 
 
-Wavetable const* StandardWaveforms::sawtooth() noexcept
+Wavetable const* StandardWaveforms::silence() noexcept
 {
-    return standard_waveforms.sawtooth_wt;
+    return standard_waveforms.silence_wt;
 }
 
 
-Wavetable const* StandardWaveforms::soft_sawtooth() noexcept
+Wavetable const* StandardWaveforms::get(Integer const waveform) noexcept
 {
-    return standard_waveforms.soft_sawtooth_wt;
+    return standard_waveforms.get_wavetable(waveform);
 }
 
 
-Wavetable const* StandardWaveforms::inverse_sawtooth() noexcept
+void StandardWaveforms::prepare(Integer const waveform) noexcept
 {
-    return standard_waveforms.inverse_sawtooth_wt;
+    standard_waveforms.prepare_wavetable(waveform);
 }
 
 
-Wavetable const* StandardWaveforms::soft_inverse_sawtooth() noexcept
+void StandardWaveforms::start_builder() noexcept
 {
-    return standard_waveforms.soft_inverse_sawtooth_wt;
+    standard_waveforms.start_building_in_background();
 }
 
 
-Wavetable const* StandardWaveforms::triangle() noexcept
+void StandardWaveforms::stop_builder() noexcept
 {
-    return standard_waveforms.triangle_wt;
+    standard_waveforms.stop_building_in_background();
 }
 
 
-Wavetable const* StandardWaveforms::soft_triangle() noexcept
+Integer StandardWaveforms::count_partials(Integer const waveform) noexcept
 {
-    return standard_waveforms.soft_triangle_wt;
+    switch (waveform) {
+        case SAWTOOTH:
+        case INVERSE_SAWTOOTH:
+        case TRIANGLE:
+        case SQUARE:
+            return Wavetable::PARTIALS;
+
+        case SOFT_SAWTOOTH:
+        case SOFT_INVERSE_SAWTOOTH:
+        case SOFT_TRIANGLE:
+        case SOFT_SQUARE:
+            return Wavetable::SOFT_PARTIALS;
+
+        default:
+            return 1;
+    }
 }
 
 
-Wavetable const* StandardWaveforms::square() noexcept
-{
-    return standard_waveforms.square_wt;
+void StandardWaveforms::compute_coefficients(
+        Integer const waveform,
+        Number* const coefficients
+) noexcept {
+    Integer const partials = count_partials(waveform);
+    bool const is_soft = partials == Wavetable::SOFT_PARTIALS;
+
+    for (Integer i = 0; i != partials; ++i) {
+        Number const plus_or_minus_one = ((i & 1) == 1 ? -1.0 : 1.0);
+        Number const i_pi = (Number)(i + 1) * Math::PI;
+        Number const two_over_i_pi = 2.0 / i_pi;
+        Number const softener = is_soft ? 5.0 / (Number)(i + 5.0) : 1.0;
+        Number coefficient;
+
+        switch (waveform) {
+            case SAWTOOTH:
+            case SOFT_SAWTOOTH:
+                coefficient = plus_or_minus_one * two_over_i_pi;
+                break;
+
+            case INVERSE_SAWTOOTH:
+            case SOFT_INVERSE_SAWTOOTH:
+                coefficient = -plus_or_minus_one * two_over_i_pi;
+                break;
+
+            case TRIANGLE:
+            case SOFT_TRIANGLE:
+                coefficient = 8.0 * std::sin(i_pi / 2.0) / (i_pi * i_pi);
+                break;
+
+            case SQUARE:
+            case SOFT_SQUARE:
+                coefficient = (1.0 + plus_or_minus_one) * two_over_i_pi;
+                break;
+
+            default:
+                coefficient = 1.0;
+                break;
+        }
+
+        coefficients[i] = softener * coefficient;
+    }
 }
 
 
-Wavetable const* StandardWaveforms::soft_square() noexcept
+StandardWaveforms::StandardWaveforms() noexcept
+    : StandardWaveforms(TableCache::get_default_directory())
 {
-    return standard_waveforms.soft_square_wt;
 }
 
 
-StandardWaveforms::StandardWaveforms() noexcept
+StandardWaveforms::StandardWaveforms(
+        std::string const& cache_directory
+) noexcept
+    : cache_directory(cache_directory)
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+    , builder(NULL),
+    builder_users(0),
+    is_builder_running(false),
+    is_builder_stopping(false),
+    has_requests(false)
+#endif
 {
     Wavetable::initialize();
 
-    Number sine_coefficients[] = {1.0};
-    Number sawtooth_coefficients[Wavetable::PARTIALS];
-    Number soft_sawtooth_coefficients[Wavetable::SOFT_PARTIALS];
-    Number inverse_sawtooth_coefficients[Wavetable::PARTIALS];
-    Number soft_inverse_sawtooth_coefficients[Wavetable::SOFT_PARTIALS];
-    Number triangle_coefficients[Wavetable::PARTIALS];
-    Number soft_triangle_coefficients[Wavetable::SOFT_PARTIALS];
-    Number square_coefficients[Wavetable::PARTIALS];
-    Number soft_square_coefficients[Wavetable::SOFT_PARTIALS];
-
-    for (Integer i = 0; i != Wavetable::PARTIALS; ++i) {
-        Number const plus_or_minus_one = ((i & 1) == 1 ? -1.0 : 1.0);
-        Number const i_pi = (Number)(i + 1) * Math::PI;
-        Number const two_over_i_pi = 2.0 / i_pi;
+    Number const sine_coefficients[] = {1.0};
+    Number const silence_coefficients[] = {0.0};
 
-        sawtooth_coefficients[i] = plus_or_minus_one * two_over_i_pi;
-        inverse_sawtooth_coefficients[i] = -sawtooth_coefficients[i];
-        triangle_coefficients[i] = (
-            8.0 * std::sin(i_pi / 2.0) / (i_pi * i_pi)
-        );
-        square_coefficients[i] = (1.0 + plus_or_minus_one) * two_over_i_pi;
+    sine_wt = new Wavetable(sine_coefficients, 1);
+    silence_wt = new Wavetable(silence_coefficients, 1);
+
+    for (Integer i = 0; i != WAVEFORMS; ++i) {
+        wavetables[i] = NULL;
+        states[i] = NOT_REQUESTED;
+        table_caches[i] = NULL;
+        samples[i] = NULL;
+    }
+
+    wavetables[SINE] = sine_wt;
+    states[SINE] = READY;
+}
+
+
+StandardWaveforms::~StandardWaveforms()
+{
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+    if (builder != NULL) {
+        builder_users = 1;
+        stop_building_in_background();
     }
+#endif
+
+    for (Integer i = 0; i != WAVEFORMS; ++i) {
+        Wavetable const* const wavetable = wavetables[i].load();
+
+        if (wavetable != sine_wt) {
+            delete wavetable;
+        }
+
+        delete[] samples[i];
+        delete table_caches[i];
 
-    for (Integer i = 0; i != Wavetable::SOFT_PARTIALS; ++i) {
-        Number const softener = 5.0 / (Number)(i + 5.0);
-        soft_sawtooth_coefficients[i] = softener * sawtooth_coefficients[i];
-        soft_inverse_sawtooth_coefficients[i] = -soft_sawtooth_coefficients[i];
-        soft_triangle_coefficients[i] = softener * triangle_coefficients[i];
-        soft_square_coefficients[i] = softener * square_coefficients[i];
+        wavetables[i] = NULL;
+        samples[i] = NULL;
+        table_caches[i] = NULL;
     }
 
-    sine_wt = new Wavetable(sine_coefficients, 1);
-    sawtooth_wt = new Wavetable(sawtooth_coefficients, Wavetable::PARTIALS);
-    soft_sawtooth_wt = new Wavetable(
-        soft_sawtooth_coefficients, Wavetable::SOFT_PARTIALS
-    );
-    inverse_sawtooth_wt = new Wavetable(
-        inverse_sawtooth_coefficients, Wavetable::PARTIALS
+    delete sine_wt;
+    delete silence_wt;
+
+    sine_wt = NULL;
+    silence_wt = NULL;
+}
+
+
+Wavetable const* StandardWaveforms::get_wavetable(
+        Integer const waveform
+) noexcept {
+    Wavetable const* const wavetable = (
+        wavetables[waveform].load(std::memory_order_acquire)
     );
-    soft_inverse_sawtooth_wt = new Wavetable(
-        soft_inverse_sawtooth_coefficients, Wavetable::SOFT_PARTIALS
+
+    if (JS80P_LIKELY(wavetable != NULL)) {
+        return wavetable;
+    }
+
+    int expected = NOT_REQUESTED;
+
+    if (states[waveform].compare_exchange_strong(expected, REQUESTED)) {
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+        has_requests.store(true, std::memory_order_release);
+#endif
+    }
+
+    return NULL;
+}
+
+
+void StandardWaveforms::prepare_wavetable(Integer const waveform) noexcept
+{
+    if (claim(waveform, NOT_REQUESTED) || claim(waveform, REQUESTED)) {
+        build(waveform);
+
+        return;
+    }
+
+    /* Another thread is already building the wavetable. */
+    while (states[waveform].load(std::memory_order_acquire) != READY) {
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+        std::this_thread::yield();
+#endif
+    }
+}
+
+
+bool StandardWaveforms::are_all_ready() const noexcept
+{
+    for (Integer i = 0; i != WAVEFORMS; ++i) {
+        if (states[i].load(std::memory_order_acquire) != READY) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool StandardWaveforms::claim(
+        Integer const waveform,
+        State const state
+) noexcept {
+    int expected = state;
+
+    return states[waveform].compare_exchange_strong(expected, BUILDING);
+}
+
+
+void StandardWaveforms::build(Integer const waveform) noexcept
+{
+    Integer const partials = count_partials(waveform);
+    Number coefficients[Wavetable::PARTIALS];
+
+    compute_coefficients(waveform, coefficients);
+
+    /*
+    The name of the cache file contains a hash of the coefficients, so that
+    tables which were built from different coefficients are never mixed up.
+    (FNV-1a.)
+    */
+    unsigned char const* const bytes = (unsigned char const*)coefficients;
+    Integer const size = partials * (Integer)sizeof(Number);
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (Integer i = 0; i != size; ++i) {
+        hash = (hash ^ (uint64_t)bytes[i]) * 0x100000001b3;
+    }
+
+    char name[32];
+
+    snprintf(
+        name,
+        sizeof(name),
+        "wavetable-v%d-%016llx",
+        VERSION,
+        (unsigned long long)hash
     );
-    triangle_wt = new Wavetable(triangle_coefficients, Wavetable::PARTIALS);
-    soft_triangle_wt = new Wavetable(
-        soft_triangle_coefficients, Wavetable::SOFT_PARTIALS
+
+    Integer const samples_count = Wavetable::count_samples(partials);
+    TableCache* const table_cache = new TableCache(
+        cache_directory, name, (size_t)samples_count * sizeof(float)
     );
-    square_wt = new Wavetable(square_coefficients, Wavetable::PARTIALS);
-    soft_square_wt = new Wavetable(
-        soft_square_coefficients, Wavetable::SOFT_PARTIALS
+    float const* const cached_samples = (
+        (float const*)table_cache->get_data()
     );
+    Wavetable const* wavetable;
+
+    if (cached_samples != NULL) {
+        wavetable = new Wavetable(partials, cached_samples);
+    } else {
+        samples[waveform] = new float[samples_count];
+        wavetable = new Wavetable(
+            coefficients, partials, samples[waveform]
+        );
+        table_cache->store(samples[waveform]);
+    }
+
+    table_caches[waveform] = table_cache;
+    wavetables[waveform].store(wavetable, std::memory_order_release);
+    states[waveform].store(READY, std::memory_order_release);
 }
 
 
-StandardWaveforms::~StandardWaveforms()
+#ifdef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+
+void StandardWaveforms::start_building_in_background() noexcept
 {
-    delete sine_wt;
-    delete sawtooth_wt;
-    delete soft_sawtooth_wt;
-    delete inverse_sawtooth_wt;
-    delete soft_inverse_sawtooth_wt;
-    delete triangle_wt;
-    delete soft_triangle_wt;
-    delete square_wt;
-    delete soft_square_wt;
+    for (Integer i = 0; i != WAVEFORMS; ++i) {
+        prepare_wavetable(i);
+    }
+}
 
-    sine_wt = NULL;
-    sawtooth_wt = NULL;
-    soft_sawtooth_wt = NULL;
-    inverse_sawtooth_wt = NULL;
-    soft_inverse_sawtooth_wt = NULL;
-    triangle_wt = NULL;
-    soft_triangle_wt = NULL;
-    square_wt = NULL;
-    soft_square_wt = NULL;
+
+void StandardWaveforms::stop_building_in_background() noexcept
+{
+}
+
+#else
+
+void StandardWaveforms::start_building_in_background() noexcept
+{
+    std::lock_guard<std::mutex> lock(builder_mutex);
+
+    ++builder_users;
+
+    if (builder != NULL) {
+        return;
+    }
+
+    is_builder_stopping.store(false, std::memory_order_release);
+    is_builder_running.store(true, std::memory_order_release);
+    builder = new std::thread(&build_requested_wavetables, this);
+}
+
+
+void StandardWaveforms::stop_building_in_background() noexcept
+{
+    std::thread* stopped_builder = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(builder_mutex);
+
+        if (builder_users == 0 || --builder_users != 0) {
+            return;
+        }
+
+        is_builder_running.store(false, std::memory_order_release);
+        is_builder_stopping.store(true, std::memory_order_release);
+
+        stopped_builder = builder;
+        builder = NULL;
+    }
+
+    builder_condition.notify_one();
+    stopped_builder->join();
+
+    delete stopped_builder;
 }
 
+
+void StandardWaveforms::build_requested_wavetables(
+        StandardWaveforms* const standard_waveforms
+) noexcept {
+    while (!standard_waveforms->is_builder_stopping.load(
+            std::memory_order_acquire
+    )) {
+        standard_waveforms->has_requests.store(
+            false, std::memory_order_release
+        );
+
+        for (Integer i = 0; i != WAVEFORMS; ++i) {
+            if (standard_waveforms->claim(i, REQUESTED)) {
+                standard_waveforms->build(i);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(standard_waveforms->builder_mutex);
+
+        auto const has_work = [standard_waveforms]() {
+            return (
+                standard_waveforms->has_requests.load(
+                    std::memory_order_acquire
+                )
+                || standard_waveforms->is_builder_stopping.load(
+                    std::memory_order_acquire
+                )
+            );
+        };
+
+        /*
+        The audio thread doesn't notify the builder about requests, so that it
+        never has to touch the mutex, so the builder polls them until there is
+        nothing left to build.
+        */
+        if (standard_waveforms->are_all_ready()) {
+            standard_waveforms->builder_condition.wait(lock, has_work);
+        } else {
+            standard_waveforms->builder_condition.wait_for(
+                lock,
+                std::chrono::milliseconds(BUILDER_POLL_MILLISECONDS),
+                has_work
+            );
+        }
+    }
+}
+
+#endif
+
 }
 
 #endif
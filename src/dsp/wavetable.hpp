@@ -19,10 +19,26 @@
 #ifndef JS80P__DSP__WAVETABLE_HPP
 #define JS80P__DSP__WAVETABLE_HPP
 
+#include <atomic>
 #include <string>
 #include <type_traits>
 
 #include "js80p.hpp"
+#include "table_cache.hpp"
+
+
+/*
+MinGW-w64 toolchains which use the win32 threading model don't provide
+std::thread before GCC 13, so all the wavetables are built in advance when the
+first Synth starts the builder there.
+*/
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_HAS_GTHREADS)
+  #define JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+#else
+  #include <condition_variable>
+  #include <mutex>
+  #include <thread>
+#endif
 
 
 namespace JS80P
@@ -65,6 +81,12 @@ class Wavetable
         static constexpr Integer PARTIALS = 384;
         static constexpr Integer SOFT_PARTIALS = PARTIALS / 2;
 
+        /*
+        Below this frequency, lookup() returns a constant 1.0, and above the
+        Nyquist frequency, it returns silence.
+        */
+        static constexpr Frequency MIN_FREQUENCY = 0.0000001;
+
         static void initialize() noexcept;
 
         static void reset_state(
@@ -77,11 +99,40 @@ class Wavetable
 
         static Number scale_phase_offset(Number const phase_offset) noexcept;
 
+        /**
+         * \brief The number of samples that the tables of all the levels of a
+         *        wavetable with the given number of partials take.
+         */
+        static Integer count_samples(Integer const partials) noexcept;
+
         Wavetable(
             Number const coefficients[],
             Integer const coefficients_length
         ) noexcept;
 
+        /**
+         * \brief Build the tables into \c samples which is owned by the caller,
+         *        and must be able to hold \c count_samples() items.
+         */
+        Wavetable(
+            Number const coefficients[],
+            Integer const coefficients_length,
+            float* const samples
+        ) noexcept;
+
+        /**
+         * \brief Use tables which were built earlier by a wavetable with the
+         *        same number of partials (e.g. loaded from a \c TableCache ).
+         *
+         * \warning The memory is owned by the caller and may be read-only, so
+         *          \c update_coefficients() and \c normalize() must not be
+         *          called on such a wavetable.
+         */
+        Wavetable(
+            Integer const coefficients_length,
+            float const* const samples
+        ) noexcept;
+
         ~Wavetable();
 
         Wavetable(Wavetable const& wavetable) = delete;
@@ -97,7 +148,7 @@ class Wavetable
             bool is_pulse,
             bool need_pulse_scaling
         >
-        void lookup(
+        JS80P_INLINE void lookup(
             WavetableState& state,
             Number const pulse_width,
             Frequency const frequency,
@@ -106,6 +157,50 @@ class Wavetable
             Sample& subharmonic_sample
         ) const noexcept;
 
+        /**
+         * \brief Select the table (or the two neighbouring tables) to be used
+         *        for the given absolute frequency, the same way as
+         *        \c lookup() does.
+         *
+         * \return Whether the two selected tables need to be crossfaded.
+         */
+        template<bool single_partial>
+        JS80P_INLINE bool select_tables(
+            WavetableState& state,
+            Frequency const abs_frequency
+        ) const noexcept;
+
+        /**
+         * \brief Interpolate the tables which were selected by
+         *        \c select_tables() at the given sample index, without
+         *        advancing the state.
+         */
+        template<
+            Interpolation interpolation,
+            bool table_interpolation,
+            bool with_subharmonic,
+            bool is_pulse,
+            bool need_pulse_scaling
+        >
+        JS80P_INLINE void interpolate(
+            WavetableState const& state,
+            Frequency const frequency,
+            Number const sample_index,
+            Number const pulse_width,
+            Sample& sample,
+            Sample& subharmonic_sample
+        ) const noexcept;
+
+        /**
+         * \brief Rebuild the tables of all the levels from the given
+         *        coefficients.
+         *
+         * \warning Levels which are too far apart from the previous level are
+         *          synthesized with an inverse FFT which needs a temporary
+         *          buffer, so this is not real-time safe for wavetables with
+         *          many partials. (Tables with only a few partials, like the
+         *          custom waveform, are never affected.)
+         */
         void update_coefficients(Number const coefficients[]) noexcept;
         void normalize() noexcept;
 
@@ -144,36 +239,51 @@ class Wavetable
             1.0 / (2.0 * (Frequency)PERIOD_SIZE_FLOAT)
         );
 
+        /*
+        Instead of keeping a table for every number of partials, tables are
+        only kept for a subset of the partial counts, like the levels of a
+        mipmap: every partial count up to EXACT_LEVELS, and then roughly
+        4 levels per octave (each level has about 2^(1/4) times as many
+        partials as the previous one).
+
+        When the frequency would allow a number of partials that falls between
+        two levels, then the lower level and the one below it are crossfaded,
+        so that partials fade in and out gradually as the frequency changes,
+        but the output never contains partials above the Nyquist frequency.
+        */
+        static constexpr Integer EXACT_LEVELS = 8;
+        static constexpr Number LEVEL_RATIO = 1.189207115002721;
+
         static Number subharmonic[SIZE];
         static Number sines[SIZE];
         static bool is_initialized;
 
+        static Integer next_level_partials(
+            Integer const level_partials,
+            Integer const partials
+        ) noexcept;
+
+        static Integer count_levels(Integer const partials) noexcept;
+
+        /*
+        A level which adds more partials to the previous level than this
+        is cheaper to synthesize from scratch with an inverse FFT than to
+        accumulate its additional partials one by one.
+        */
+        static constexpr Integer FFT_MIN_LEVEL_GAP = 16;
+
+        static void inverse_fft(Number* const re, Number* const im) noexcept;
+
         template<bool with_subharmonic>
         static constexpr Integer get_index_mask() noexcept;
 
-        template<
-            Interpolation interpolation,
-            bool table_interpolation,
-            bool with_subharmonic,
-            bool is_pulse,
-            bool need_pulse_scaling
-        >
-        void interpolate(
-            WavetableState const& state,
-            Frequency const frequency,
-            Number const sample_index,
-            Number const pulse_width,
-            Sample& sample,
-            Sample& subharmonic_sample
-        ) const noexcept;
-
         template<
             bool table_interpolation,
             bool with_subharmonic,
             bool is_pulse,
             bool need_pulse_scaling
         >
-        void interpolate_sample_linear(
+        JS80P_INLINE void interpolate_sample_linear(
             WavetableState const& state,
             Number const sample_index,
             Number const pulse_width,
@@ -182,7 +292,7 @@ class Wavetable
         ) const noexcept;
 
         template<bool table_interpolation, bool with_subharmonic>
-        void interpolate_sample_linear(
+        JS80P_INLINE void interpolate_sample_linear(
             WavetableState const& state,
             Number const sample_index,
             Sample& sample,
@@ -195,7 +305,7 @@ class Wavetable
             bool is_pulse,
             bool need_pulse_scaling
         >
-        void interpolate_sample_lagrange(
+        JS80P_INLINE void interpolate_sample_lagrange(
             WavetableState const& state,
             Number const sample_index,
             Number const pulse_width,
@@ -204,7 +314,7 @@ class Wavetable
         ) const noexcept;
 
         template<bool table_interpolation, bool with_subharmonic>
-        void interpolate_sample_lagrange(
+        JS80P_INLINE void interpolate_sample_lagrange(
             WavetableState const& state,
             Number const sample_index,
             Sample& sample,
@@ -218,26 +328,127 @@ class Wavetable
             Number const pulse_width
         ) const noexcept;
 
+        void initialize_levels() noexcept;
+
+        Integer count_direct_levels() const noexcept;
+
+        void update_levels_directly(
+            Number const coefficients[],
+            Integer const direct_levels
+        ) noexcept;
+
+        void update_levels_with_fft(
+            Number const coefficients[],
+            Integer const first_level
+        ) noexcept;
+
+        void store_period(
+            Integer const level,
+            Number const* const period
+        ) noexcept;
+
+        JS80P_INLINE float const* get_table(Integer const level) const noexcept;
+
         Integer const partials;
+        Integer const levels;
+        bool const owns_samples;
 
-        Sample** samples;
+        Integer* level_partials;
+        Integer* partials_to_level;
+        Sample* level_width_inv;
+
+        /*
+        The tables of all the levels are stored in a single block of memory. The
+        samples are stored in single precision, because the difference is
+        inaudible, but the tables take half as much space in the CPU caches.
+        */
+        float* samples;
 };
 
 
+/**
+ * \brief The band-limited wavetables of the standard waveforms, built or
+ *        loaded from the \c TableCache only when an oscillator first needs
+ *        them.
+ *
+ * \note While at least one \c Synth is alive, the requested tables are built
+ *       by a background thread, so that selecting a waveform never blocks the
+ *       audio thread. Where threads are not available, all the tables are
+ *       built when the builder would be started. Tables are never built by
+ *       \c get(), so without a builder (e.g. in tests), they need to be
+ *       prepared in advance. Code paths which run outside the audio thread and
+ *       know which waveforms are about to be selected should \c prepare()
+ *       them, so that the rendered sound does not depend on how quickly the
+ *       builder gets to them.
+ */
 class StandardWaveforms
 {
     public:
+        /*
+        Waveform indices match the standard waveforms of Oscillator.
+        */
+        static constexpr Integer SINE = 0;
+        static constexpr Integer SAWTOOTH = 1;
+        static constexpr Integer SOFT_SAWTOOTH = 2;
+        static constexpr Integer INVERSE_SAWTOOTH = 3;
+        static constexpr Integer SOFT_INVERSE_SAWTOOTH = 4;
+        static constexpr Integer TRIANGLE = 5;
+        static constexpr Integer SOFT_TRIANGLE = 6;
+        static constexpr Integer SQUARE = 7;
+        static constexpr Integer SOFT_SQUARE = 8;
+
+        static constexpr Integer WAVEFORMS = 9;
+
+        /*
+        Increment this whenever the code which computes the samples of the
+        wavetables changes, so that stale tables in the TableCache are not
+        used.
+        */
+        static constexpr int VERSION = 1;
+
         static Wavetable const* sine() noexcept;
-        static Wavetable const* sawtooth() noexcept;
-        static Wavetable const* soft_sawtooth() noexcept;
-        static Wavetable const* inverse_sawtooth() noexcept;
-        static Wavetable const* soft_inverse_sawtooth() noexcept;
-        static Wavetable const* triangle() noexcept;
-        static Wavetable const* soft_triangle() noexcept;
-        static Wavetable const* square() noexcept;
-        static Wavetable const* soft_square() noexcept;
+        static Wavetable const* silence() noexcept;
+
+        /**
+         * \brief Return the wavetable of the given waveform if it is ready,
+         *        otherwise request it and return \c NULL, in which case the
+         *        caller should fall back to another wavetable for now, and ask
+         *        again in the next round.
+         *
+         * \note Real-time safe: the request is an atomic flag which the
+         *       builder polls.
+         */
+        static Wavetable const* get(Integer const waveform) noexcept;
+
+        /**
+         * \brief Make sure that the wavetable of the given waveform is ready
+         *        by the time this method returns, building it on the calling
+         *        thread if necessary, so that the audio thread never has to
+         *        wait for the background builder for it.
+         *
+         * \warning Not real-time safe.
+         */
+        static void prepare(Integer const waveform) noexcept;
+
+        /**
+         * \brief Reference counted start and stop of the background thread
+         *        which builds the requested wavetables. (Without threads,
+         *        starting the builder prepares all the wavetables.)
+         *
+         * \warning Not real-time safe.
+         */
+        static void start_builder() noexcept;
+        static void stop_builder() noexcept;
 
         StandardWaveforms() noexcept;
+
+        /**
+         * \brief Load the tables from the \c TableCache in the given directory
+         *        if possible, or build them and try to store them there. (An
+         *        empty string disables caching.)
+         */
+        explicit StandardWaveforms(std::string const& cache_directory) noexcept;
+
         ~StandardWaveforms();
 
         StandardWaveforms(
@@ -256,18 +467,64 @@ class StandardWaveforms
             StandardWaveforms&& standard_waveforms
         ) = delete;
 
+        Wavetable const* get_wavetable(Integer const waveform) noexcept;
+        void prepare_wavetable(Integer const waveform) noexcept;
+
+        void start_building_in_background() noexcept;
+        void stop_building_in_background() noexcept;
+
     private:
-        static StandardWaveforms const standard_waveforms;
+        enum State {
+            NOT_REQUESTED = 0,
+            REQUESTED = 1,
+            BUILDING = 2,
+            READY = 3,
+        };
+
+        static constexpr int BUILDER_POLL_MILLISECONDS = 100;
+
+        static StandardWaveforms standard_waveforms;
+
+        static Integer count_partials(Integer const waveform) noexcept;
+
+        static void compute_coefficients(
+            Integer const waveform,
+            Number* const coefficients
+        ) noexcept;
+
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+        static void build_requested_wavetables(
+            StandardWaveforms* const standard_waveforms
+        ) noexcept;
+#endif
+
+        bool are_all_ready() const noexcept;
+        bool claim(Integer const waveform, State const state) noexcept;
+        void build(Integer const waveform) noexcept;
+
+        std::string const cache_directory;
 
         Wavetable const* sine_wt;
-        Wavetable const* sawtooth_wt;
-        Wavetable const* soft_sawtooth_wt;
-        Wavetable const* inverse_sawtooth_wt;
-        Wavetable const* soft_inverse_sawtooth_wt;
-        Wavetable const* triangle_wt;
-        Wavetable const* soft_triangle_wt;
-        Wavetable const* square_wt;
-        Wavetable const* soft_square_wt;
+        Wavetable const* silence_wt;
+
+        std::atomic<Wavetable const*> wavetables[WAVEFORMS];
+        std::atomic<int> states[WAVEFORMS];
+        TableCache* table_caches[WAVEFORMS];
+        float* samples[WAVEFORMS];
+
+#ifndef JS80P_STANDARD_WAVEFORMS_SINGLE_THREADED
+        /*
+        Only the threads which start and stop the builder use the mutex and
+        the condition variable, the audio thread only sets has_requests.
+        */
+        std::mutex builder_mutex;
+        std::condition_variable builder_condition;
+        std::thread* builder;
+        Integer builder_users;
+        std::atomic<bool> is_builder_running;
+        std::atomic<bool> is_builder_stopping;
+        std::atomic<bool> has_requests;
+#endif
 };
 
 }
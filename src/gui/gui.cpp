@@ -2088,7 +2088,7 @@ GUI::GUI(
 
     vst_logo_image = dummy_widget->load_image(this->platform_data, "VSTLOGO");
 
-    background = new Background(*this);
+    background = new Background(*this, synth);
 
     this->parent_window = new ExternallyCreatedWindow(
         this->platform_data, parent_window
@@ -277,6 +277,50 @@ void TabBody::refresh_controlled_knob_param_editors()
 }
 
 
+void TabBody::refresh_changed_params(bool const* const changed_params)
+{
+    for (
+            GUI::KnobParamEditors::iterator it = knob_param_editors.begin();
+            it != knob_param_editors.end();
+            ++it
+    ) {
+        KnobParamEditor* const editor = *it;
+
+        if (editor->is_affected_by(changed_params)) {
+            editor->refresh();
+        }
+    }
+
+    for (
+            GUI::ToggleSwitchParamEditors::iterator it = (
+                toggle_switch_param_editors.begin()
+            );
+            it != toggle_switch_param_editors.end();
+            ++it
+    ) {
+        ToggleSwitchParamEditor* const editor = *it;
+
+        if (changed_params[editor->param_id]) {
+            editor->refresh();
+        }
+    }
+
+    for (
+            GUI::DiscreteParamEditors::iterator it = (
+                discrete_param_editors.begin()
+            );
+            it != discrete_param_editors.end();
+            ++it
+    ) {
+        DiscreteParamEditor* const editor = *it;
+
+        if (editor->is_affected_by(changed_params)) {
+            editor->refresh();
+        }
+    }
+}
+
+
 void TabBody::refresh_all_params()
 {
     for (
@@ -391,12 +435,14 @@ void TabBody::show_param_editors()
 }
 
 
-Background::Background(GUI& gui)
+Background::Background(GUI& gui, Synth& synth)
     : Widget("JS80P", 0, 0, GUI::WIDTH, GUI::HEIGHT, Type::BACKGROUND),
+    synth(synth),
     body(NULL),
-    next_full_refresh(FULL_REFRESH_TICKS)
+    next_synth_state_update(SYNTH_STATE_UPDATE_TICKS)
 {
     set_gui(gui);
+    std::fill_n(changed_params, Synth::ParamId::PARAM_ID_COUNT, false);
 }
 
 
@@ -422,6 +468,14 @@ void Background::replace_body(TabBody* const new_body)
 
     body = new_body;
     body->show();
+
+    if (old_body != NULL) {
+        /*
+        Change notifications are only applied to the visible tab, so the newly
+        shown one may be out of date.
+        */
+        body->refresh_all_params();
+    }
 }
 
 
@@ -453,14 +507,36 @@ void Background::refresh()
         return;
     }
 
-    --next_full_refresh;
-
-    if (next_full_refresh == 0) {
-        next_full_refresh = FULL_REFRESH_TICKS;
+    if (collect_changed_params()) {
+        next_synth_state_update = SYNTH_STATE_UPDATE_TICKS;
         body->refresh_all_params();
-    } else {
-        body->refresh_controlled_knob_param_editors();
+
+        return;
+    }
+
+    body->refresh_changed_params(changed_params);
+    body->refresh_controlled_knob_param_editors();
+
+    --next_synth_state_update;
+
+    if (next_synth_state_update == 0) {
+        next_synth_state_update = SYNTH_STATE_UPDATE_TICKS;
+        gui->update_synth_state();
+    }
+}
+
+
+bool Background::collect_changed_params()
+{
+    Synth::ParamId param_id;
+
+    std::fill_n(changed_params, Synth::ParamId::PARAM_ID_COUNT, false);
+
+    while (synth.pop_changed_param(param_id)) {
+        changed_params[param_id] = true;
     }
+
+    return synth.have_param_changes_been_dropped();
 }
 
 
@@ -1206,6 +1282,21 @@ bool KnobParamEditor::has_controller() const
 }
 
 
+bool KnobParamEditor::is_affected_by(bool const* const changed_params) const
+{
+    Synth::ParamId const sync_param_id = knob->get_sync_param_id();
+
+    return (
+        changed_params[param_id]
+        || (can_scale_x4 && changed_params[scale_x4_toggle_param_id])
+        || (
+            sync_param_id != Synth::ParamId::INVALID_PARAM_ID
+            && changed_params[sync_param_id]
+        )
+    );
+}
+
+
 void KnobParamEditor::refresh()
 {
     if (knob->is_editing()) {
@@ -1510,6 +1601,12 @@ void KnobParamEditor::Knob::set_sync_param_id(Synth::ParamId const param_id)
 }
 
 
+Synth::ParamId KnobParamEditor::Knob::get_sync_param_id() const
+{
+    return sync_param_id;
+}
+
+
 void KnobParamEditor::Knob::update(Number const ratio)
 {
     this->ratio = (
@@ -2184,6 +2281,13 @@ void DiscreteParamEditor::set_up(
 }
 
 
+bool DiscreteParamEditor::is_affected_by(
+        bool const* const changed_params
+) const {
+    return changed_params[param_id];
+}
+
+
 void DiscreteParamEditor::refresh()
 {
     if (is_editing()) {
@@ -2380,6 +2484,15 @@ TuningSelector::TuningSelector(
 }
 
 
+bool TuningSelector::is_affected_by(bool const* const changed_params) const
+{
+    return (
+        DiscreteParamEditor::is_affected_by(changed_params)
+        || gui->is_mts_esp_connected() != is_mts_esp_connected
+    );
+}
+
+
 void TuningSelector::refresh()
 {
     if (is_editing()) {
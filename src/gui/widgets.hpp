@@ -178,6 +178,7 @@ class TabBody : public TransparentWidget
         void stop_editing();
 
         void refresh_controlled_knob_param_editors();
+        void refresh_changed_params(bool const* const changed_params);
         void refresh_all_params();
 
         void set_tab_selector(TabSelector& tab_selector);
@@ -199,7 +200,7 @@ class TabBody : public TransparentWidget
 class Background : public Widget
 {
     public:
-        explicit Background(GUI& gui);
+        Background(GUI& gui, Synth& synth);
         ~Background();
 
         void replace_body(TabBody* const new_body);
@@ -209,10 +210,14 @@ class Background : public Widget
         void refresh();
 
     private:
-        static constexpr Integer FULL_REFRESH_TICKS = 3;
+        static constexpr Integer SYNTH_STATE_UPDATE_TICKS = 3;
 
+        bool collect_changed_params();
+
+        Synth& synth;
         TabBody* body;
-        Integer next_full_refresh;
+        Integer next_synth_state_update;
+        bool changed_params[Synth::ParamId::PARAM_ID_COUNT];
 };
 
 
@@ -451,6 +456,7 @@ class KnobParamEditor : public TransparentWidget
         void set_sync_param_id(Synth::ParamId const param_id);
 
         bool has_controller() const;
+        bool is_affected_by(bool const* const changed_params) const;
 
         void adjust_ratio(Number const ratio);
         void handle_ratio_change(Number const new_ratio);
@@ -538,6 +544,7 @@ class KnobParamEditor : public TransparentWidget
                 virtual void set_scale(Number const new_scale) override;
 
                 void set_sync_param_id(Synth::ParamId const param_id);
+                Synth::ParamId get_sync_param_id() const;
 
                 void update(Number const ratio);
                 void update();
@@ -803,6 +810,7 @@ class DiscreteParamEditor : public TransparentWidget
 
         virtual void set_scale(Number const new_scale) override;
 
+        virtual bool is_affected_by(bool const* const changed_params) const;
         virtual void refresh();
 
         Synth::ParamId const param_id;
@@ -895,6 +903,10 @@ class TuningSelector : public DiscreteParamEditor
             Synth::ParamId const param_id
         );
 
+        virtual bool is_affected_by(
+            bool const* const changed_params
+        ) const override;
+
         virtual void refresh() override;
 
     protected:
@@ -57,6 +57,24 @@ SignalProducer::produce(), etc.)
 #define JS80P_OVERRIDE
 
 
+/*
+Number of extra slots in each SignalProducer's preallocated event queue, see
+SignalProducer::EVENT_QUEUE_HEADROOM.
+*/
+#ifndef JS80P_EVENT_QUEUE_HEADROOM
+#define JS80P_EVENT_QUEUE_HEADROOM 16
+#endif
+
+
+/*
+Number of threads (including the audio thread) which may render voices in
+parallel, see Synth::set_voice_rendering_threads().
+*/
+#ifndef JS80P_VOICE_RENDERING_THREADS
+#define JS80P_VOICE_RENDERING_THREADS 1
+#endif
+
+
 namespace JS80P
 {
 
@@ -67,10 +85,22 @@ typedef intptr_t Integer;
 Aliases for Number to make signatures more informative while avoiding type
 conversions.
 */
-typedef Number Sample;
 typedef Number Seconds;
 typedef Number Frequency;
 
+/*
+When JS80P_SINGLE_PRECISION_SAMPLES is defined, then signal and parameter
+buffers, delay lines, and the like are stored as float, halving the memory
+footprint and bandwidth of the signal chain. Precision-sensitive state, like
+oscillator phases, filter coefficients and filter state, antiderivative
+lookup tables, etc. remains Number.
+*/
+#ifdef JS80P_SINGLE_PRECISION_SAMPLES
+typedef float Sample;
+#else
+typedef Number Sample;
+#endif
+
 typedef unsigned char Byte;
 
 
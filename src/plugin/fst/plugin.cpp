@@ -598,43 +598,62 @@ FstPlugin::~FstPlugin()
 void FstPlugin::process_internal_messages_in_audio_thread(
         SPSCQueue<FstPlugin::Message>& messages
 ) noexcept {
-    SPSCQueue<Message>::SizeType const message_count = messages.length();
+    SPSCQueue<Message>::SizeType remaining = messages.length();
 
-    for (size_t i = 0; i != message_count; ++i) {
-        Message message;
+    if (remaining == 0) {
+        return;
+    }
 
-        if (!messages.pop(message)) {
-            continue;
+    Message batch[INTERNAL_MESSAGE_BATCH_SIZE];
+
+    while (remaining != 0) {
+        SPSCQueue<Message>::SizeType const popped = messages.pop_batch(
+            batch, std::min(remaining, INTERNAL_MESSAGE_BATCH_SIZE)
+        );
+
+        if (popped == 0) {
+            break;
         }
 
-        switch (message.get_type()) {
-            case MessageType::CHANGE_PROGRAM:
-                handle_change_program(message.get_index());
-                break;
+        for (size_t i = 0; i != popped; ++i) {
+            process_internal_message_in_audio_thread(batch[i]);
+        }
 
-            case MessageType::RENAME_PROGRAM:
-                handle_rename_program(message.get_serialized_data());
-                break;
+        remaining -= popped;
+    }
+}
 
-            case MessageType::CHANGE_PARAM:
-                handle_change_param(
-                    message.get_controller_id(),
-                    message.get_new_value(),
-                    message.get_channel()
-                );
-                break;
 
-            case MessageType::IMPORT_PATCH:
-                handle_import_patch(message.get_serialized_data());
-                break;
+void FstPlugin::process_internal_message_in_audio_thread(
+        Message const& message
+) noexcept {
+    switch (message.get_type()) {
+        case MessageType::CHANGE_PROGRAM:
+            handle_change_program(message.get_index());
+            break;
 
-            case MessageType::IMPORT_BANK:
-                handle_import_bank(message.get_serialized_data());
-                break;
+        case MessageType::RENAME_PROGRAM:
+            handle_rename_program(message.get_serialized_data());
+            break;
 
-            default:
-                break;
-        }
+        case MessageType::CHANGE_PARAM:
+            handle_change_param(
+                message.get_controller_id(),
+                message.get_new_value(),
+                message.get_channel()
+            );
+            break;
+
+        case MessageType::IMPORT_PATCH:
+            handle_import_patch(message.get_serialized_data());
+            break;
+
+        case MessageType::IMPORT_BANK:
+            handle_import_bank(message.get_serialized_data());
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -1227,6 +1246,8 @@ void FstPlugin::set_chunk(
 
         program_names[current_program_index].set_name(name);
 
+        Serializer::prepare_patch(synth, current_patch);
+
         to_audio_string_messages.push(
             Message(MessageType::IMPORT_PATCH, 0, current_patch)
         );
@@ -1238,6 +1259,12 @@ void FstPlugin::set_chunk(
 
         program_names.import_names(serialized_bank);
 
+        Bank imported_bank;
+        imported_bank.import(serialized_bank);
+        Serializer::prepare_patch(
+            synth, imported_bank[current_program_index].serialize()
+        );
+
         to_audio_string_messages.push(
             Message(MessageType::IMPORT_BANK, 0, serialized_bank)
         );
@@ -273,6 +273,8 @@ class FstPlugin : public Midi::EventHandler, public GUI::EventHandler
             1.0 / BANK_UPDATE_FREQUENCY
         );
 
+        static constexpr size_t INTERNAL_MESSAGE_BATCH_SIZE = 16;
+
         enum MessageType {
             NONE = 0,
 
@@ -361,6 +363,10 @@ class FstPlugin : public Midi::EventHandler, public GUI::EventHandler
             SPSCQueue<Message>& messages
         ) noexcept;
 
+        void process_internal_message_in_audio_thread(
+            Message const& message
+        ) noexcept;
+
         void process_internal_messages_in_gui_thread() noexcept;
 
         void handle_change_program(size_t const new_program) noexcept;
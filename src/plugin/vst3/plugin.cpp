@@ -235,6 +235,15 @@ tresult PLUGIN_API Vst3Plugin::Processor::notify(Vst::IMessage* message)
 
         if (result == kResultOk) {
             bank = (Bank const*)bank_ptr;
+
+            /*
+            Programs are loaded in the audio thread, so the waveforms which
+            they use are prepared in advance.
+            */
+            for (size_t i = 0; i != Bank::NUMBER_OF_PROGRAMS; ++i) {
+                Serializer::prepare_patch(synth, (*bank)[i].serialize());
+            }
+
             share_synth();
         }
     }
@@ -25,6 +25,8 @@
 
 #include "synth.hpp"
 
+#include "dsp/cpu.hpp"
+
 
 namespace JS80P
 {
@@ -111,51 +113,17 @@ class Renderer
                     block_size - next_synth_sample_index
                 );
 
-                if (JS80P_LIKELY(input != NULL)) {
-                    if (JS80P_LIKELY(in_samples != NULL)) {
-                        for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
-                            NumberType const* const src_channel = in_samples[c];
-                            Sample* const dst_channel = input[c];
-
-                            for (Integer i = 0; i != batch_size; ++i) {
-                                dst_channel[next_synth_sample_index + i] = (
-                                    (Sample)src_channel[
-                                        next_host_sample_index + i
-                                    ]
-                                );
-                            }
-                        }
-                    } else {
-                        for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
-                            Sample* const dst_channel = input[c];
-
-                            for (Integer i = 0; i != batch_size; ++i) {
-                                dst_channel[next_synth_sample_index + i] = 0.0;
-                            }
-                        }
-                    }
-                }
-
-                for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
-                    Sample const* const src_channel = rendered[c];
-                    NumberType* const dst_channel = out_samples[c];
-
-                    for (Integer i = 0; i != batch_size; ++i) {
-                        if constexpr (operation == Operation::OVERWRITE) {
-                            dst_channel[next_host_sample_index + i] = (
-                                (NumberType)src_channel[
-                                    next_synth_sample_index + i
-                                ]
-                            );
-                        } else {
-                            dst_channel[next_host_sample_index + i] += (
-                                (NumberType)src_channel[
-                                    next_synth_sample_index + i
-                                ]
-                            );
-                        }
+                CPU::dispatch(
+                    [&] () JS80P_KERNEL {
+                        convert<NumberType, operation>(
+                            in_samples,
+                            out_samples,
+                            next_host_sample_index,
+                            next_synth_sample_index,
+                            batch_size
+                        );
                     }
-                }
+                );
 
                 next_synth_sample_index += batch_size;
                 next_host_sample_index += batch_size;
@@ -177,6 +145,55 @@ class Renderer
     private:
         static constexpr Integer ROUND_MASK = 0x7fffff;
 
+        template<typename NumberType, Operation operation>
+        JS80P_INLINE void convert(
+                NumberType const* const* const in_samples,
+                NumberType** out_samples,
+                Integer const next_host_sample_index,
+                Integer const next_synth_sample_index,
+                Integer const batch_size
+        ) noexcept {
+            if (JS80P_LIKELY(input != NULL)) {
+                if (JS80P_LIKELY(in_samples != NULL)) {
+                    for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
+                        NumberType const* const src_channel = in_samples[c];
+                        Sample* const dst_channel = input[c];
+
+                        for (Integer i = 0; i != batch_size; ++i) {
+                            dst_channel[next_synth_sample_index + i] = (
+                                (Sample)src_channel[next_host_sample_index + i]
+                            );
+                        }
+                    }
+                } else {
+                    for (Integer c = 0; c != Synth::IN_CHANNELS; ++c) {
+                        Sample* const dst_channel = input[c];
+
+                        for (Integer i = 0; i != batch_size; ++i) {
+                            dst_channel[next_synth_sample_index + i] = 0.0;
+                        }
+                    }
+                }
+            }
+
+            for (Integer c = 0; c != Synth::OUT_CHANNELS; ++c) {
+                Sample const* const src_channel = rendered[c];
+                NumberType* const dst_channel = out_samples[c];
+
+                for (Integer i = 0; i != batch_size; ++i) {
+                    if constexpr (operation == Operation::OVERWRITE) {
+                        dst_channel[next_host_sample_index + i] = (
+                            (NumberType)src_channel[next_synth_sample_index + i]
+                        );
+                    } else {
+                        dst_channel[next_host_sample_index + i] += (
+                            (NumberType)src_channel[next_synth_sample_index + i]
+                        );
+                    }
+                }
+            }
+        }
+
         Integer const block_size;
         Integer const channels;
 
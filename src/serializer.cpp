@@ -189,6 +189,20 @@ void Serializer::import_patch_in_audio_thread(
 }
 
 
+void Serializer::prepare_patch(
+        Synth const& synth,
+        std::string const& serialized
+) noexcept {
+    Lines const* const lines = parse_lines(serialized);
+    Messages messages;
+
+    collect_messages(synth, lines, messages);
+    synth.prepare_messages(messages.data(), (Integer)messages.size());
+
+    delete lines;
+}
+
+
 template<Serializer::Thread thread>
 void Serializer::import_patch(
         Synth& synth,
@@ -293,9 +307,39 @@ bool Serializer::is_section_name_char(char const c) noexcept
 template<Serializer::Thread thread>
 void Serializer::process_lines(Synth& synth, Lines const* const lines) noexcept
 {
-    typedef std::vector<Synth::Message> Messages;
-
     Messages messages;
+
+    collect_messages(synth, lines, messages);
+
+    send_message<thread>(
+        synth,
+        Synth::Message(
+            Synth::MessageType::CLEAR, Synth::ParamId::INVALID_PARAM_ID, 0.0, 0
+        )
+    );
+
+    /*
+    Load discrete parameters first because they may affect how float param
+    ratios are to be interpreted (especially the log-scale toggles).
+    */
+
+    std::stable_partition(
+        messages.begin(),
+        messages.end(),
+        [&synth](Synth::Message const& message) -> bool {
+            return synth.is_discrete_param(message.param_id);
+        }
+    );
+
+    send_messages<thread>(synth, messages.data(), (Integer)messages.size());
+}
+
+
+void Serializer::collect_messages(
+        Synth const& synth,
+        Lines const* const lines,
+        Messages& messages
+) noexcept {
     SectionName section_name;
     bool inside_js80p_section = false;
 
@@ -315,32 +359,6 @@ void Serializer::process_lines(Synth& synth, Lines const* const lines) noexcept
             process_line(messages, synth, line);
         }
     }
-
-    send_message<thread>(
-        synth,
-        Synth::Message(
-            Synth::MessageType::CLEAR, Synth::ParamId::INVALID_PARAM_ID, 0.0, 0
-        )
-    );
-
-    /*
-    Load discrete parameters first because they may affect how float param
-    ratios are to be interpreted (especially the log-scale toggles).
-    */
-
-    Messages::const_iterator it;
-
-    for (it = messages.begin(); it != messages.end(); ++it) {
-        if (synth.is_discrete_param(it->param_id)) {
-            send_message<thread>(synth, *it);
-        }
-    }
-
-    for (it = messages.begin(); it != messages.end(); ++it) {
-        if (!synth.is_discrete_param(it->param_id)) {
-            send_message<thread>(synth, *it);
-        }
-    }
 }
 
 
@@ -357,6 +375,22 @@ void Serializer::send_message(
 }
 
 
+template<Serializer::Thread thread>
+void Serializer::send_messages(
+        Synth& synth,
+        Synth::Message const* const messages,
+        Integer const count
+) noexcept {
+    if constexpr (thread == Thread::AUDIO) {
+        for (Integer i = 0; i != count; ++i) {
+            synth.process_message(messages[i]);
+        }
+    } else {
+        synth.push_messages(messages, count);
+    }
+}
+
+
 bool Serializer::is_js80p_section_start(
         SectionName const& section_name
 ) noexcept {
@@ -82,6 +82,19 @@ class Serializer
             std::string const& serialized
         ) noexcept;
 
+        /**
+         * \brief Build everything outside the audio thread that the given
+         *        patch is going to need when it is imported with
+         *        \c import_patch_in_audio_thread(), see
+         *        \c Synth::prepare_messages().
+         *
+         * \warning Not real-time safe.
+         */
+        static void prepare_patch(
+            Synth const& synth,
+            std::string const& serialized
+        ) noexcept;
+
         static void trim_excess_zeros_from_end(
             char* const number,
             int const length,
@@ -94,6 +107,8 @@ class Serializer
             GUI = 1,
         };
 
+        typedef std::vector<Synth::Message> Messages;
+
         /*
         Using a greater number than Synth::ControllerId::CONTROLLER_ID_COUNT, so
         that there is some room left for introducing more controllers.
@@ -127,12 +142,25 @@ class Serializer
             Lines const* const lines
         ) noexcept;
 
+        static void collect_messages(
+            Synth const& synth,
+            Lines const* const lines,
+            Messages& messages
+        ) noexcept;
+
         template<Thread thread>
         static void send_message(
             Synth& synth,
             Synth::Message const& message
         ) noexcept;
 
+        template<Thread thread>
+        static void send_messages(
+            Synth& synth,
+            Synth::Message const* const messages,
+            Integer const count
+        ) noexcept;
+
         static bool is_section_name_char(char const c) noexcept;
         static bool is_digit(char const c) noexcept;
         static bool is_capital_letter(char const c) noexcept;
@@ -31,7 +31,9 @@ template<class ItemClass>
 SPSCQueue<ItemClass>::SPSCQueue(SizeType const capacity) noexcept
     : capacity(capacity + 1),
     next_push(0),
-    next_pop(0)
+    cached_next_pop(0),
+    next_pop(0),
+    cached_next_push(0)
 {
     items.reserve(this->capacity);
 
@@ -51,9 +53,18 @@ bool SPSCQueue<ItemClass>::is_empty() const noexcept
 template<class ItemClass>
 typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::length(
 ) const noexcept {
-    size_t const next_pop = this->next_pop.load();
-    size_t const next_push = this->next_push.load();
+    SizeType const next_pop = this->next_pop.load(std::memory_order_acquire);
+    SizeType const next_push = this->next_push.load(std::memory_order_acquire);
 
+    return count_items(next_push, next_pop);
+}
+
+
+template<class ItemClass>
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::count_items(
+        SizeType const next_push,
+        SizeType const next_pop
+) const noexcept {
     if (next_push < next_pop) {
         return capacity + next_push - next_pop;
     } else {
@@ -72,21 +83,51 @@ bool SPSCQueue<ItemClass>::is_lock_free() const noexcept
 template<class ItemClass>
 bool SPSCQueue<ItemClass>::push(ItemClass const& item) noexcept
 {
-    size_t const old_next_push = next_push.load();
-    size_t const next_pop = this->next_pop.load();
-    size_t const new_next_push = advance(old_next_push);
+    SizeType const old_next_push = next_push.load(std::memory_order_relaxed);
+    SizeType const new_next_push = advance(old_next_push);
+
+    if (cached_next_pop == new_next_push) {
+        cached_next_pop = next_pop.load(std::memory_order_acquire);
 
-    if (next_pop == new_next_push) {
-        return false;
+        if (cached_next_pop == new_next_push) {
+            return false;
+        }
     }
 
     items[old_next_push] = item;
-    next_push.store(new_next_push);
+    next_push.store(new_next_push, std::memory_order_release);
 
     return true;
 }
 
 
+template<class ItemClass>
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::push_batch(
+        ItemClass const* const batch,
+        SizeType const count
+) noexcept {
+    SizeType const old_next_push = next_push.load(std::memory_order_relaxed);
+    SizeType free = capacity - 1 - count_items(old_next_push, cached_next_pop);
+
+    if (free < count) {
+        cached_next_pop = next_pop.load(std::memory_order_acquire);
+        free = capacity - 1 - count_items(old_next_push, cached_next_pop);
+    }
+
+    SizeType const pushed = count < free ? count : free;
+    SizeType index = old_next_push;
+
+    for (SizeType i = 0; i != pushed; ++i) {
+        items[index] = batch[i];
+        index = advance(index);
+    }
+
+    next_push.store(index, std::memory_order_release);
+
+    return pushed;
+}
+
+
 template<class ItemClass>
 typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::advance(
         SizeType const index
@@ -100,23 +141,56 @@ typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::advance(
 template<class ItemClass>
 bool SPSCQueue<ItemClass>::pop(ItemClass& item) noexcept
 {
-    size_t const next_pop = this->next_pop.load();
-    size_t const next_push = this->next_push.load();
+    SizeType const next_pop = this->next_pop.load(std::memory_order_relaxed);
 
-    if (next_push == next_pop) {
-        return false;
+    if (cached_next_push == next_pop) {
+        cached_next_push = next_push.load(std::memory_order_acquire);
+
+        if (cached_next_push == next_pop) {
+            return false;
+        }
     }
 
-    ItemClass replacement;
+    ItemClass replacement = ItemClass();
 
     std::swap(items[next_pop], replacement);
     item = std::move(replacement);
 
-    this->next_pop.store(advance(next_pop));
+    this->next_pop.store(advance(next_pop), std::memory_order_release);
 
     return true;
 }
 
+
+template<class ItemClass>
+typename SPSCQueue<ItemClass>::SizeType SPSCQueue<ItemClass>::pop_batch(
+        ItemClass* const batch,
+        SizeType const max_count
+) noexcept {
+    SizeType const old_next_pop = next_pop.load(std::memory_order_relaxed);
+    SizeType available = count_items(cached_next_push, old_next_pop);
+
+    if (available < max_count) {
+        cached_next_push = next_push.load(std::memory_order_acquire);
+        available = count_items(cached_next_push, old_next_pop);
+    }
+
+    SizeType const popped = max_count < available ? max_count : available;
+    SizeType index = old_next_pop;
+
+    for (SizeType i = 0; i != popped; ++i) {
+        ItemClass replacement = ItemClass();
+
+        std::swap(items[index], replacement);
+        batch[i] = std::move(replacement);
+        index = advance(index);
+    }
+
+    next_pop.store(index, std::memory_order_release);
+
+    return popped;
+}
+
 }
 
 #endif
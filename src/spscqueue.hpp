@@ -1,6 +1,6 @@
 /*
  * This file is part of JS80P, a synthesizer plugin.
- * Copyright (C) 2023, 2024  Attila M. Magyar
+ * Copyright (C) 2023, 2024, 2026  Attila M. Magyar
  *
  * JS80P is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -51,15 +51,57 @@ class SPSCQueue
         bool push(ItemClass const& item) noexcept;
         bool pop(ItemClass& item) noexcept;
 
+        /**
+         * \brief Push as many of the given items as there is room for, with a
+         *        single publication of the new write index.
+         *
+         * \return The number of items that were pushed.
+         */
+        SizeType push_batch(
+            ItemClass const* const batch,
+            SizeType const count
+        ) noexcept;
+
+        /**
+         * \brief Pop at most \c max_count items into \c batch, with a single
+         *        publication of the new read index.
+         *
+         * \return The number of items that were popped.
+         */
+        SizeType pop_batch(
+            ItemClass* const batch,
+            SizeType const max_count
+        ) noexcept;
+
     private:
+        /*
+        Keeping the indices which are written by different threads on separate
+        cache lines prevents the producer and the consumer from invalidating
+        each other's cache line on every operation.
+        */
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
         SizeType advance(SizeType const index) const noexcept;
 
+        SizeType count_items(
+            SizeType const next_push,
+            SizeType const next_pop
+        ) const noexcept;
+
         SizeType const capacity;
 
         std::vector<ItemClass> items;
 
-        std::atomic<SizeType> next_push;
-        std::atomic<SizeType> next_pop;
+        /*
+        Each thread keeps a possibly outdated copy of the other thread's index
+        next to its own, and only reloads the shared one when the copy
+        suggests that the queue is full or empty.
+        */
+        alignas(CACHE_LINE_SIZE) std::atomic<SizeType> next_push;
+        SizeType cached_next_pop;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<SizeType> next_pop;
+        SizeType cached_next_push;
 };
 
 }
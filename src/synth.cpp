@@ -32,8 +32,11 @@
 
 #include "dsp/biquad_filter.cpp"
 #include "dsp/chorus.cpp"
+#include "dsp/comb_filter_bank.cpp"
 #include "dsp/compressor.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/echo.cpp"
 #include "dsp/effect.cpp"
@@ -47,6 +50,7 @@
 #include "dsp/math.cpp"
 #include "dsp/midi_controller.cpp"
 #include "dsp/mixer.cpp"
+#include "dsp/multi_tap_delay.cpp"
 #include "dsp/noise_generator.cpp"
 #include "dsp/oscillator.cpp"
 #include "dsp/param.cpp"
@@ -62,7 +66,9 @@
 #include "note_stack.cpp"
 #include "random_patch.cpp"
 #include "spscqueue.cpp"
+#include "table_cache.cpp"
 #include "voice.cpp"
+#include "worker_pool.cpp"
 
 
 namespace JS80P
@@ -271,6 +277,7 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     carrier_params("C", (Envelope* const*)&envelopes_rw),
     input_volume("IN", 0.0, 1.0, 0.0),
     messages(MESSAGE_QUEUE_SIZE),
+    changed_params(CHANGED_PARAMS_QUEUE_SIZE),
     bus(
         OUT_CHANNELS,
         modulators,
@@ -279,7 +286,11 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         carrier_params,
         POLYPHONY,
         modulator_add_volume,
-        input_volume
+        input_volume,
+        amplitude_modulation_level,
+        frequency_modulation_level,
+        phase_modulation_level,
+        biquad_filter_shared_buffers
     ),
     /*
     Different Synth instances should produce different noise patterns, so we're
@@ -290,6 +301,7 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     samples_between_gc(samples_between_gc),
     next_voice(0),
     next_note_id(0),
+    macro_evaluation_plan_length(0),
     previous_note(Midi::NOTE_MAX + 1),
     previous_note_handling(NOTE_HANDLING_DEFAULT),
     is_learning(false),
@@ -298,6 +310,7 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     is_dirty_(false),
     has_cc_74(false),
     has_channel_pressure(false),
+    is_macro_evaluation_plan_dirty(true),
     effects(
         "E",
         bus,
@@ -310,8 +323,13 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     envelopes((Envelope* const*)envelopes_rw),
     lfos((LFO* const*)lfos_rw)
 {
+    StandardWaveforms::start_builder();
+
     is_mts_esp_connected_.store(false);
 
+    active_sample_evaluated_float_params = NULL;
+    active_block_evaluated_float_params = NULL;
+
     deferred_note_offs.reserve(2 * POLYPHONY);
 
     allocate_buffers();
@@ -325,6 +343,7 @@ Synth::Synth(Integer const samples_between_gc) noexcept
         byte_params[i] = NULL;
     }
 
+    param_changes_dropped.store(false);
     active_voices_count.store(0);
 
     tape_state.store(effects.tape_params.state);
@@ -372,6 +391,8 @@ Synth::Synth(Integer const samples_between_gc) noexcept
     vol_3_peak.clear();
 
     update_param_states();
+
+    set_voice_rendering_threads(JS80P_VOICE_RENDERING_THREADS);
 }
 
 
@@ -1307,11 +1328,11 @@ void Synth::allocate_buffers() noexcept
     for (Integer i = 0; i != BIQUAD_FILTER_SHARED_BUFFERS; ++i) {
         BiquadFilterSharedBuffers& sh_bufs = biquad_filter_shared_buffers[i];
 
-        sh_bufs.b0_buffer = new Sample[block_size];
-        sh_bufs.b1_buffer = new Sample[block_size];
-        sh_bufs.b2_buffer = new Sample[block_size];
-        sh_bufs.a1_buffer = new Sample[block_size];
-        sh_bufs.a2_buffer = new Sample[block_size];
+        sh_bufs.b0_buffer = new Number[block_size];
+        sh_bufs.b1_buffer = new Number[block_size];
+        sh_bufs.b2_buffer = new Number[block_size];
+        sh_bufs.a1_buffer = new Number[block_size];
+        sh_bufs.a2_buffer = new Number[block_size];
     }
 }
 
@@ -1366,10 +1387,23 @@ void Synth::register_param(ParamId const param_id, ParamClass& param) noexcept
 
     size_t const index = (size_t)param_id;
 
+    /*
+    The rest of the params are kept up to date by the objects that use them.
+    */
+    bool const needs_active_list = param_id < ParamId::EV3V;
+
     if constexpr (std::is_same<ParamClass, FloatParamS>::value) {
         sample_evaluated_float_params[index] = &param;
+
+        if (needs_active_list) {
+            param.set_active_params_list(&active_sample_evaluated_float_params);
+        }
     } else if constexpr (std::is_same<ParamClass, FloatParamB>::value) {
         block_evaluated_float_params[index] = &param;
+
+        if (needs_active_list) {
+            param.set_active_params_list(&active_block_evaluated_float_params);
+        }
     } else if constexpr (std::is_base_of<ByteParam, ParamClass>::value) {
         byte_params[index] = (ByteParam*)&param;
     } else {
@@ -1429,6 +1463,8 @@ Synth::~Synth() noexcept
     }
 
     free_buffers();
+
+    StandardWaveforms::stop_builder();
 }
 
 
@@ -1492,6 +1528,8 @@ bool Synth::is_lock_free() const noexcept
     return (
         is_lock_free
         && messages.is_lock_free()
+        && changed_params.is_lock_free()
+        && param_changes_dropped.is_lock_free()
         && is_mts_esp_connected_.is_lock_free()
         && active_voices_count.is_lock_free()
         && tape_state.is_lock_free()
@@ -1551,6 +1589,39 @@ Integer Synth::get_active_voices_count() const noexcept
 }
 
 
+void Synth::set_voice_rendering_threads(Integer const threads) noexcept
+{
+    static_assert(
+        WorkerPool::MAX_THREADS <= FloatParamS::MAX_RENDERING_THREADS,
+        "Each worker thread needs its own set of buffers for param followers"
+    );
+
+    bus.set_voice_rendering_threads(threads);
+
+    Integer const new_threads = bus.get_voice_rendering_threads();
+
+    for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
+        if (sample_evaluated_float_params[i] != NULL) {
+            sample_evaluated_float_params[i]->set_rendering_threads(
+                new_threads
+            );
+        }
+
+        if (block_evaluated_float_params[i] != NULL) {
+            block_evaluated_float_params[i]->set_rendering_threads(
+                new_threads
+            );
+        }
+    }
+}
+
+
+Integer Synth::get_voice_rendering_threads() const noexcept
+{
+    return bus.get_voice_rendering_threads();
+}
+
+
 TapeParams::State Synth::get_tape_state() const noexcept
 {
     return tape_state.load();
@@ -1750,6 +1821,48 @@ bool Synth::should_sync_oscillator_instability(
 }
 
 
+bool Synth::can_render_voices_in_parallel() const noexcept
+{
+    if (bus.get_voice_rendering_threads() < 2) {
+        return false;
+    }
+
+    /*
+    Voices share the leaders of their parameters, the LFOs, the macros, etc.,
+    which are rendered lazily and cached for the round by the first voice that
+    needs them. Before starting the voices in parallel, Synth::Bus renders the
+    shared leaders (and with them, their LFOs) on its own, and the tempo of the
+    envelopes is updated in advance, so that the voices only read these caches,
+    the MIDI channel of the shared envelope params, and the leaders' decisions
+    about being constant in the round. Without MPE, all voices use
+    the channel on which the macros are locked for the round, so they don't
+    update the macros either. (Polyphonic parameters, e.g. the ones which are
+    controlled by envelopes, render into per-thread buffers of their leaders,
+    see FloatParamS::set_rendering_threads().) However, the following features
+    make voices modify shared state in ways that also depend on the order in
+    which the voices are rendered:
+
+     * MPE makes voices follow different MIDI channels, and update the per
+       channel values of macros and controllers.
+
+     * LFOs with envelopes are rendered separately for each voice into buffers
+       that are owned by the LFO.
+    */
+
+    if (mpe_settings.get_value() != MPE_OFF) {
+        return false;
+    }
+
+    for (Byte i = 0; i != Constants::LFOS; ++i) {
+        if (lfos[i]->has_envelope()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 void Synth::note_on_polyphonic(
         Seconds const time_offset,
         Midi::Channel const channel,
@@ -2688,10 +2801,127 @@ void Synth::push_message(
 
 void Synth::push_message(Message const& message) noexcept
 {
+    prepare_messages(&message, 1);
     messages.push(message);
 }
 
 
+Integer Synth::push_messages(
+        Message const* const batch,
+        Integer const count
+) noexcept {
+    prepare_messages(batch, count);
+
+    return (Integer)messages.push_batch(
+        batch, (SPSCQueue<Message>::SizeType)count
+    );
+}
+
+
+void Synth::prepare_messages(
+        Message const* const messages,
+        Integer const count
+) const noexcept {
+    for (Integer i = 0; i != count; ++i) {
+        Message const& message = messages[i];
+
+        if (message.type != MessageType::SET_PARAM) {
+            continue;
+        }
+
+        ParamId const param_id = message.param_id;
+        Number const ratio = message.number_param;
+
+        if (param_id == ParamId::MWFM) {
+            modulator_params.waveform.prepare_wavetable(ratio);
+        } else if (param_id == ParamId::CWFM) {
+            carrier_params.waveform.prepare_wavetable(ratio);
+        } else if (param_id >= ParamId::L1WAV && param_id <= ParamId::L8WAV) {
+            size_t const lfo_index = (size_t)param_id - (size_t)ParamId::L1WAV;
+
+            lfos_rw[lfo_index]->waveform.prepare_wavetable(ratio);
+        } else {
+            prepare_tape(param_id, ratio);
+        }
+    }
+}
+
+
+void Synth::prepare_tape(
+        ParamId const param_id,
+        Number const ratio
+) const noexcept {
+    switch (param_id) {
+        case ParamId::ETEND:
+        case ParamId::ETSTP:
+        case ParamId::ETWFA:
+        case ParamId::ETSAT:
+        case ParamId::ETCLR:
+        case ParamId::ETHSS:
+        case ParamId::ETSTR:
+            break;
+
+        default:
+            return;
+    }
+
+    /*
+    This is only an estimate (e.g. it doesn't know about controllers), but
+    the tape doesn't depend on it, because if it turns out to be wrong, then
+    the background thread of the delay buffer arena sorts it out.
+    */
+    constexpr ParamId engaging_params[] = {
+        ParamId::ETSTP,
+        ParamId::ETWFA,
+        ParamId::ETSAT,
+        ParamId::ETHSS,
+        ParamId::ETSTR,
+    };
+
+    bool is_engaged = false;
+
+    for (ParamId const engaging_param_id : engaging_params) {
+        Number const engaging_param_ratio = (
+            engaging_param_id == param_id
+                ? ratio
+                : get_param_ratio_atomic(engaging_param_id)
+        );
+
+        if (engaging_param_ratio >= 0.000001) {
+            is_engaged = true;
+
+            break;
+        }
+    }
+
+    Number const color_ratio = (
+        param_id == ParamId::ETCLR
+            ? ratio
+            : get_param_ratio_atomic(ParamId::ETCLR)
+    );
+
+    if (!is_engaged && Math::is_close(color_ratio, 0.5, 0.0005)) {
+        return;
+    }
+
+    Number const tape_at_end_ratio = (
+        param_id == ParamId::ETEND
+            ? ratio
+            : get_param_ratio_atomic(ParamId::ETEND)
+    );
+
+    Byte const tape_at_end = effects.tape_at_end.ratio_to_value(
+        tape_at_end_ratio
+    );
+
+    if (tape_at_end == ToggleParam::ON) {
+        effects.tape_2.commit_delay_buffer_now();
+    } else {
+        effects.tape_1.commit_delay_buffer_now();
+    }
+}
+
+
 std::string const& Synth::get_param_name(ParamId const param_id) const noexcept
 {
     return param_names_by_id[param_id];
@@ -2878,10 +3108,26 @@ Synth::ControllerId Synth::get_param_controller_id_atomic(
 }
 
 
+bool Synth::pop_changed_param(ParamId& param_id) noexcept
+{
+    return changed_params.pop(param_id);
+}
+
+
+bool Synth::have_param_changes_been_dropped() noexcept
+{
+    return param_changes_dropped.exchange(false);
+}
+
+
 void Synth::update_param_states() noexcept
 {
+    /*
+    There's no GUI yet which would need to be notified about the changes, it
+    will read the initial state on its own when it gets created.
+    */
     for (int i = 0; i != ParamId::PARAM_ID_COUNT; ++i) {
-        handle_refresh_param((ParamId)i);
+        param_ratios[i].store(get_param_ratio((ParamId)i));
     }
 }
 
@@ -2908,29 +3154,67 @@ Sample const* const* Synth::initialize_rendering(
         samples_since_gc = 0;
     }
 
+    bool const is_parallel_rendering_allowed = can_render_voices_in_parallel();
+
+    if (JS80P_UNLIKELY(is_macro_evaluation_plan_dirty)) {
+        compile_macro_evaluation_plan();
+    }
+
+    /*
+    Without MPE, all parameters use the same channel for their macros, so after
+    this, voices (including the ones which are rendered in parallel) will find
+    all macros up to date, and they won't need to recalculate them, nor to walk
+    the macros which control them, until the macros are unlocked below. Nothing
+    can change the macros' inputs on this channel while the voices and effects
+    are rendered.
+    */
+    for (Integer i = 0; i != macro_evaluation_plan_length; ++i) {
+        macro_evaluation_plan[i]->update_and_lock(PARAM_GLOBAL_MPE_CHANNEL);
+    }
+
+    /*
+    The custom waveforms are shared by all the voices, so they are rebuilt
+    here, before any of the voices start rendering.
+    */
+    Byte const modulator_waveform = modulator_params.waveform.get_value();
+    Byte const carrier_waveform = carrier_params.waveform.get_value();
+
+    if (modulator_waveform == Modulator::Oscillator_::CUSTOM) {
+        modulator_params.custom_waveform.update(round, sample_count);
+    }
+
+    if (carrier_waveform == Carrier::Oscillator_::CUSTOM) {
+        carrier_params.custom_waveform.update(round, sample_count);
+    }
+
+    if (is_parallel_rendering_allowed) {
+        for (Byte i = 0; i != Constants::ENVELOPES; ++i) {
+            envelopes_rw[i]->update();
+        }
+    }
+
+    bus.set_parallel_rendering_allowed(is_parallel_rendering_allowed);
+
     raw_output = SignalProducer::produce< Effects::Effects<Bus> >(
         effects, round, sample_count
     );
 
-    FloatParamS* const* const sample_evaluated_float_params = (
-        this->sample_evaluated_float_params
+    for (Integer i = 0; i != macro_evaluation_plan_length; ++i) {
+        macro_evaluation_plan[i]->unlock();
+    }
+
+    /*
+    Params which are not used by any of the active voices or effects still need
+    to keep up with their scheduled events and controllers, but there's no need
+    to visit those which have neither.
+    */
+    FloatParamS::produce_active_params(
+        &active_sample_evaluated_float_params, round, sample_count
     );
-    FloatParamB* const* const block_evaluated_float_params = (
-        this->block_evaluated_float_params
+    FloatParamB::produce_active_params(
+        &active_block_evaluated_float_params, round, sample_count
     );
 
-    for (int i = 0; i != (int)ParamId::EV3V; ++i) {
-        if (sample_evaluated_float_params[i] != NULL) {
-            FloatParamS::produce_if_not_constant(
-                *sample_evaluated_float_params[i], round, sample_count
-            );
-        } else if (block_evaluated_float_params[i] != NULL) {
-            FloatParamB::produce_if_not_constant(
-                *block_evaluated_float_params[i], round, sample_count
-            );
-        }
-    }
-
     for (Byte i = 0; i != Constants::LFOS; ++i) {
         lfos_rw[i]->skip_round(round, sample_count);
     }
@@ -2944,6 +3228,66 @@ Sample const* const* Synth::initialize_rendering(
 }
 
 
+void Synth::compile_macro_evaluation_plan() noexcept
+{
+    Byte visit_states[MACROS];
+
+    std::fill_n(visit_states, MACROS, MACRO_NOT_VISITED);
+    macro_evaluation_plan_length = 0;
+
+    for (Integer i = 0; i != MACROS; ++i) {
+        if (macros[i]->is_assigned()) {
+            add_to_macro_evaluation_plan(i, visit_states);
+        }
+    }
+
+    is_macro_evaluation_plan_dirty = false;
+}
+
+
+void Synth::add_to_macro_evaluation_plan(
+        Integer const macro_index,
+        Byte* const visit_states
+) noexcept {
+    /*
+    Circular dependencies are broken up at the macro which is already being
+    visited, the same way as Macro::update() does it.
+    */
+    if (visit_states[macro_index] != MACRO_NOT_VISITED) {
+        return;
+    }
+
+    visit_states[macro_index] = MACRO_VISITING;
+
+    Macro* const macro = macros_rw[macro_index];
+    Macro* dependencies[Macro::PARAMS];
+    Integer const dependencies_count = macro->get_dependencies(dependencies);
+
+    for (Integer i = 0; i != dependencies_count; ++i) {
+        Integer const dependency_index = find_macro_index(dependencies[i]);
+
+        if (dependency_index != MACROS) {
+            add_to_macro_evaluation_plan(dependency_index, visit_states);
+        }
+    }
+
+    visit_states[macro_index] = MACRO_VISITED;
+    macro_evaluation_plan[macro_evaluation_plan_length++] = macro;
+}
+
+
+Integer Synth::find_macro_index(Macro const* const macro) const noexcept
+{
+    for (Integer i = 0; i != MACROS; ++i) {
+        if (macros[i] == macro) {
+            return i;
+        }
+    }
+
+    return MACROS;
+}
+
+
 void Synth::garbage_collect_voices() noexcept
 {
     Modulator* const* const modulators = this->modulators;
@@ -2993,14 +3337,23 @@ void Synth::garbage_collect_voices() noexcept
 
 void Synth::process_messages() noexcept
 {
-    SPSCQueue<Message>::SizeType const message_count = messages.length();
+    SPSCQueue<Message>::SizeType remaining = messages.length();
+    Message batch[MESSAGE_BATCH_SIZE];
 
-    for (SPSCQueue<Message>::SizeType i = 0; i != message_count; ++i) {
-        Message message;
+    while (remaining != 0) {
+        SPSCQueue<Message>::SizeType const popped = messages.pop_batch(
+            batch, std::min(remaining, MESSAGE_BATCH_SIZE)
+        );
 
-        if (messages.pop(message)) {
-            process_message(message);
+        if (popped == 0) {
+            break;
         }
+
+        for (SPSCQueue<Message>::SizeType i = 0; i != popped; ++i) {
+            process_message(batch[i]);
+        }
+
+        remaining -= popped;
     }
 
     bool const was_holding = is_holding_;
@@ -3130,7 +3483,7 @@ void Synth::handle_set_param_smoothly(
 
             param.cancel_events();
             param.schedule_linear_ramp(0.0125, param.ratio_to_value(ratio));
-            param_ratios[param_id].store(ratio);
+            update_param_ratio(param_id, ratio);
 
             break;
         }
@@ -3196,7 +3549,12 @@ void Synth::handle_assign_controller(
         return;
     }
 
-    controller_assignments[param_id].store(controller_id);
+    is_macro_evaluation_plan_dirty = true;
+
+    if (controller_assignments[param_id].load() != controller_id) {
+        controller_assignments[param_id].store(controller_id);
+        notify_param_change(param_id);
+    }
 
     if ((ControllerId)controller_id == ControllerId::MIDI_LEARN) {
         is_learning = true;
@@ -3297,7 +3655,29 @@ bool Synth::may_be_controllable(
 
 void Synth::handle_refresh_param(ParamId const param_id) noexcept
 {
-    param_ratios[param_id].store(get_param_ratio(param_id));
+    update_param_ratio(param_id, get_param_ratio(param_id));
+}
+
+
+void Synth::update_param_ratio(
+        ParamId const param_id,
+        Number const ratio
+) noexcept {
+    /* The audio thread is the only writer, so the load cannot be stale. */
+    if (param_ratios[param_id].load() == ratio) {
+        return;
+    }
+
+    param_ratios[param_id].store(ratio);
+    notify_param_change(param_id);
+}
+
+
+void Synth::notify_param_change(ParamId const param_id) noexcept
+{
+    if (JS80P_UNLIKELY(!changed_params.push(param_id))) {
+        param_changes_dropped.store(true);
+    }
 }
 
 
@@ -3869,7 +4249,7 @@ void Synth::finalize_rendering(
             peak, peak_index, sample_count, sampling_period
         );
         osc_1_peak.change_all_channels(
-            0.0, std::min(1.0, osc_1_peak_tracker.get_peak())
+            0.0, std::min<Number>(1.0, osc_1_peak_tracker.get_peak())
         );
     }
 
@@ -3879,7 +4259,7 @@ void Synth::finalize_rendering(
             peak, peak_index, sample_count, sampling_period
         );
         osc_2_peak.change_all_channels(
-            0.0, std::min(1.0, osc_2_peak_tracker.get_peak())
+            0.0, std::min<Number>(1.0, osc_2_peak_tracker.get_peak())
         );
     }
 
@@ -3889,7 +4269,7 @@ void Synth::finalize_rendering(
             peak, peak_index, sample_count, sampling_period
         );
         vol_1_peak.change_all_channels(
-            0.0, std::min(1.0, vol_1_peak_tracker.get_peak())
+            0.0, std::min<Number>(1.0, vol_1_peak_tracker.get_peak())
         );
     }
 
@@ -3899,7 +4279,7 @@ void Synth::finalize_rendering(
             peak, peak_index, sample_count, sampling_period
         );
         vol_2_peak.change_all_channels(
-            0.0, std::min(1.0, vol_2_peak_tracker.get_peak())
+            0.0, std::min<Number>(1.0, vol_2_peak_tracker.get_peak())
         );
     }
 
@@ -3909,7 +4289,7 @@ void Synth::finalize_rendering(
             peak, peak_index, sample_count, sampling_period
         );
         vol_3_peak.change_all_channels(
-            0.0, std::min(1.0, vol_3_peak_tracker.get_peak())
+            0.0, std::min<Number>(1.0, vol_3_peak_tracker.get_peak())
         );
     }
 
@@ -3955,12 +4335,16 @@ Synth::Message::Message(
 Synth::Bus::Bus(
         Integer const channels,
         Modulator* const* const modulators,
-        Modulator::Params const& modulator_params,
+        Modulator::Params& modulator_params,
         Carrier* const* const carriers,
-        Carrier::Params const& carrier_params,
+        Carrier::Params& carrier_params,
         Integer const polyphony,
         FloatParamS& modulator_add_volume,
-        FloatParamS& input_volume
+        FloatParamS& input_volume,
+        FloatParamS& amplitude_modulation_level,
+        FloatParamS& frequency_modulation_level,
+        FloatParamS& phase_modulation_level,
+        BiquadFilterSharedBuffers* const filter_shared_buffers
 ) noexcept
     : SignalProducer(channels, 0),
     polyphony(polyphony),
@@ -3973,7 +4357,47 @@ Synth::Bus::Bus(
     modulator_add_volume(modulator_add_volume),
     input_volume(input_volume),
     modulators_buffer(NULL),
-    carriers_buffer(NULL)
+    carriers_buffer(NULL),
+    modulator_leaders{
+        &modulator_params.noise_level,
+        &modulator_params.pulse_width,
+        &modulator_params.amplitude,
+        &modulator_params.subharmonic_amplitude,
+        &modulator_params.detune,
+        &modulator_params.fine_detune,
+        &modulator_params.filter_1_frequency,
+        &modulator_params.filter_1_q,
+        &modulator_params.filter_1_gain,
+        &modulator_params.folding,
+        &modulator_params.filter_2_frequency,
+        &modulator_params.filter_2_q,
+        &modulator_params.filter_2_gain,
+        &modulator_params.panning,
+        &modulator_params.volume,
+        &modulator_add_volume,
+    },
+    carrier_leaders{
+        &carrier_params.noise_level,
+        &carrier_params.pulse_width,
+        &carrier_params.amplitude,
+        &carrier_params.detune,
+        &carrier_params.fine_detune,
+        &amplitude_modulation_level,
+        &frequency_modulation_level,
+        &phase_modulation_level,
+        &carrier_params.filter_1_frequency,
+        &carrier_params.filter_1_q,
+        &carrier_params.filter_1_gain,
+        &carrier_params.folding,
+        &carrier_params.distortion,
+        &carrier_params.filter_2_frequency,
+        &carrier_params.filter_2_q,
+        &carrier_params.filter_2_gain,
+        &carrier_params.panning,
+        &carrier_params.volume,
+    },
+    filter_shared_buffers(filter_shared_buffers),
+    is_parallel_rendering_allowed(false)
 {
     allocate_buffers();
 }
@@ -3989,6 +4413,8 @@ void Synth::Bus::allocate_buffers() noexcept
 {
     modulators_buffer = allocate_buffer();
     carriers_buffer = allocate_buffer();
+
+    allocate_worker_filter_shared_buffers();
 }
 
 
@@ -3996,6 +4422,83 @@ void Synth::Bus::free_buffers() noexcept
 {
     modulators_buffer = free_buffer(modulators_buffer);
     carriers_buffer = free_buffer(carriers_buffer);
+
+    free_worker_filter_shared_buffers();
+}
+
+
+void Synth::Bus::allocate_worker_filter_shared_buffers() noexcept
+{
+    Integer const threads = worker_pool.get_threads();
+
+    for (Integer t = 1; t < threads; ++t) {
+        for (Integer i = 0; i != VOICE_FILTER_SHARED_BUFFERS; ++i) {
+            BiquadFilterSharedBuffers& sh_bufs = (
+                worker_filter_shared_buffers[t][i]
+            );
+
+            sh_bufs.round = -1;
+            sh_bufs.b0_buffer = new Number[block_size];
+            sh_bufs.b1_buffer = new Number[block_size];
+            sh_bufs.b2_buffer = new Number[block_size];
+            sh_bufs.a1_buffer = new Number[block_size];
+            sh_bufs.a2_buffer = new Number[block_size];
+        }
+    }
+}
+
+
+void Synth::Bus::free_worker_filter_shared_buffers() noexcept
+{
+    for (Integer t = 1; t != WorkerPool::MAX_THREADS; ++t) {
+        for (Integer i = 0; i != VOICE_FILTER_SHARED_BUFFERS; ++i) {
+            BiquadFilterSharedBuffers& sh_bufs = (
+                worker_filter_shared_buffers[t][i]
+            );
+
+            delete[] sh_bufs.b0_buffer;
+            delete[] sh_bufs.b1_buffer;
+            delete[] sh_bufs.b2_buffer;
+            delete[] sh_bufs.a1_buffer;
+            delete[] sh_bufs.a2_buffer;
+
+            sh_bufs.b0_buffer = NULL;
+            sh_bufs.b1_buffer = NULL;
+            sh_bufs.b2_buffer = NULL;
+            sh_bufs.a1_buffer = NULL;
+            sh_bufs.a2_buffer = NULL;
+        }
+    }
+}
+
+
+void Synth::Bus::set_voice_rendering_threads(Integer const threads) noexcept
+{
+    /*
+    Voices might still refer to the shared buffers of worker threads which are
+    about to be stopped.
+    */
+    for (Integer v = 0; v != polyphony; ++v) {
+        use_filter_shared_buffers<Modulator>(*modulators[v], 0);
+        use_filter_shared_buffers<Carrier>(*carriers[v], 0);
+    }
+
+    free_worker_filter_shared_buffers();
+    worker_pool.set_threads(threads);
+    allocate_worker_filter_shared_buffers();
+}
+
+
+Integer Synth::Bus::get_voice_rendering_threads() const noexcept
+{
+    return worker_pool.get_threads();
+}
+
+
+void Synth::Bus::set_parallel_rendering_allowed(
+        bool const is_allowed
+) noexcept {
+    is_parallel_rendering_allowed = is_allowed;
 }
 
 
@@ -4269,6 +4772,14 @@ void Synth::Bus::render_voices(
             }
         }
 
+        if (is_parallel_rendering_allowed && voices_count > 1) {
+            render_voices_in_parallel<VoiceClass>(
+                voices, voices_count, round, sample_count
+            );
+
+            return;
+        }
+
         for (size_t v = 0; v != voices_count; ++v) {
             voices[v]->render_oscillator(round, sample_count);
         }
@@ -4282,6 +4793,116 @@ void Synth::Bus::render_voices(
 }
 
 
+template<class VoiceClass>
+void Synth::Bus::render_shared_leaders(
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    /*
+    The voices which follow a leader find it rendered and cached for the round,
+    along with its LFO and its decision about being constant, so they only read
+    it. (See Synth::can_render_voices_in_parallel().) Polyphonic leaders are
+    not followed, their followers render into per-thread buffers instead.
+    */
+    constexpr bool is_carrier = std::is_same<VoiceClass, Carrier>::value;
+
+    FloatParamS* const* const leaders = (
+        is_carrier ? carrier_leaders : modulator_leaders
+    );
+    Integer const leaders_count = (
+        is_carrier ? CARRIER_LEADERS : MODULATOR_LEADERS
+    );
+
+    for (Integer i = 0; i != leaders_count; ++i) {
+        FloatParamS& leader = *leaders[i];
+
+        if (!leader.is_polyphonic()) {
+            FloatParamS::produce_if_not_constant<FloatParamS>(
+                leader, round, sample_count
+            );
+        }
+    }
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::render_voices_in_parallel(
+        VoiceClass* const (&voices)[POLYPHONY],
+        size_t const voices_count,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    render_shared_leaders<VoiceClass>(round, sample_count);
+
+    VoiceRenderingJob<VoiceClass> job{*this, voices, round, sample_count};
+
+    FloatParamS::set_rendering_in_parallel(true);
+    FloatParamB::set_rendering_in_parallel(true);
+
+    worker_pool.run(
+        &VoiceRenderingJob<VoiceClass>::run,
+        (void*)&job,
+        (Integer)voices_count
+    );
+
+    FloatParamS::set_rendering_in_parallel(false);
+    FloatParamB::set_rendering_in_parallel(false);
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::render_voice(
+        VoiceClass& voice,
+        Integer const thread,
+        Integer const round,
+        Integer const sample_count
+) noexcept {
+    use_filter_shared_buffers<VoiceClass>(voice, thread);
+    voice.render_oscillator(round, sample_count);
+    SignalProducer::produce<VoiceClass>(voice, round, sample_count);
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::use_filter_shared_buffers(
+        VoiceClass& voice,
+        Integer const thread
+) noexcept {
+    BiquadFilterSharedBuffers* const shared_buffers = (
+        thread == 0
+            ? filter_shared_buffers
+            : worker_filter_shared_buffers[thread]
+    );
+    Integer const offset = std::is_same<VoiceClass, Carrier>::value ? 2 : 0;
+
+    voice.set_filter_shared_buffers(
+        &shared_buffers[offset], &shared_buffers[offset + 1]
+    );
+}
+
+
+template<class VoiceClass>
+void Synth::Bus::VoiceRenderingJob<VoiceClass>::run(
+        void* job,
+        Integer const index,
+        Integer const thread
+) noexcept {
+    VoiceRenderingJob<VoiceClass> const& voice_rendering_job = (
+        *(VoiceRenderingJob<VoiceClass> const*)job
+    );
+
+    FloatParamS::set_rendering_thread(thread);
+    FloatParamB::set_rendering_thread(thread);
+
+    voice_rendering_job.bus.template render_voice<VoiceClass>(
+        *voice_rendering_job.voices[index],
+        thread,
+        voice_rendering_job.round,
+        voice_rendering_job.sample_count
+    );
+}
+
+
 void Synth::Bus::render(
         Integer const round,
         Integer const first_sample_index,
@@ -29,6 +29,7 @@
 #include "note_stack.hpp"
 #include "spscqueue.hpp"
 #include "voice.hpp"
+#include "worker_pool.hpp"
 
 #include "dsp/envelope.hpp"
 #include "dsp/biquad_filter.hpp"
@@ -98,7 +99,9 @@ class Synth : public Midi::EventHandler, public SignalProducer
             REFRESH_PARAM = 4,      ///< Make sure that
                                     ///< \c get_param_ratio_atomic()
                                     ///< will return the most recent value of
-                                    ///< the given parameter.
+                                    ///< the given parameter, and notify the
+                                    ///< GUI via \c pop_changed_param() if
+                                    ///< it has changed.
 
             CLEAR = 5,              ///< Clear all buffers, release all
                                     ///< controller assignments, and reset all
@@ -1226,6 +1229,19 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         Integer get_active_voices_count() const noexcept;
 
+        /**
+         * \brief Set the number of threads (including the audio thread) which
+         *        may render voices in parallel. The default is
+         *        \c JS80P_VOICE_RENDERING_THREADS (1 unless it is set at build
+         *        time), i.e. voices are rendered one after the other on the
+         *        audio thread.
+         *
+         * \warning Not real-time safe, must not be called while rendering.
+         */
+        void set_voice_rendering_threads(Integer const threads) noexcept;
+
+        Integer get_voice_rendering_threads() const noexcept;
+
         TapeParams::State get_tape_state() const noexcept;
 
         bool has_mts_esp_tuning() const noexcept;
@@ -1270,6 +1286,32 @@ class Synth : public Midi::EventHandler, public SignalProducer
          */
         void push_message(Message const& message) noexcept;
 
+        /**
+         * \brief Thread-safe way to send multiple state changing messages to
+         *        the synthesizer outside the audio thread at once.
+         *
+         * \return The number of messages that fit into the queue.
+         */
+        Integer push_messages(
+            Message const* const batch,
+            Integer const count
+        ) noexcept;
+
+        /**
+         * \brief Build the wavetables which the given messages are going to
+         *        select, and commit the delay buffer of the tape if the
+         *        messages are going to engage it, so that the audio thread
+         *        finds them ready when it processes the messages. (Messages
+         *        which are sent with \c push_message() and
+         *        \c push_messages() are prepared automatically.)
+         *
+         * \warning Not real-time safe.
+         */
+        void prepare_messages(
+            Message const* const messages,
+            Integer const count
+        ) const noexcept;
+
         void process_messages() noexcept;
 
         /**
@@ -1330,6 +1372,24 @@ class Synth : public Midi::EventHandler, public SignalProducer
             ParamId const param_id
         ) const noexcept;
 
+        /**
+         * \brief Retrieve the next parameter whose ratio or controller
+         *        assignment has been changed by the audio thread. Meant to be
+         *        called only from the GUI thread.
+         *
+         * \return     \c false if there are no more pending changes.
+         */
+        bool pop_changed_param(ParamId& param_id) noexcept;
+
+        /**
+         * \brief Tell whether some change notifications had to be dropped
+         *        since the last call, because the GUI was not keeping up (or
+         *        was not open at all). When this returns \c true, then all
+         *        parameters should be considered changed. Meant to be called
+         *        only from the GUI thread.
+         */
+        bool have_param_changes_been_dropped() noexcept;
+
         void note_off(
             Seconds const time_offset,
             Midi::Channel const channel,
@@ -1447,6 +1507,10 @@ class Synth : public Midi::EventHandler, public SignalProducer
         PerChannelFrequencyTable per_channel_frequencies;
 
     private:
+        static constexpr Byte MACRO_NOT_VISITED = 0;
+        static constexpr Byte MACRO_VISITING = 1;
+        static constexpr Byte MACRO_VISITED = 2;
+
         class Bus : public SignalProducer
         {
             friend class SignalProducer;
@@ -1455,12 +1519,16 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Bus(
                     Integer const channels,
                     Modulator* const* const modulators,
-                    Modulator::Params const& modulator_params,
+                    Modulator::Params& modulator_params,
                     Carrier* const* const carriers,
-                    Carrier::Params const& carrier_params,
+                    Carrier::Params& carrier_params,
                     Integer const polyphony,
                     FloatParamS& modulator_add_volume,
-                    FloatParamS& input_volume
+                    FloatParamS& input_volume,
+                    FloatParamS& amplitude_modulation_level,
+                    FloatParamS& frequency_modulation_level,
+                    FloatParamS& phase_modulation_level,
+                    BiquadFilterSharedBuffers* const filter_shared_buffers
                 ) noexcept;
 
                 virtual ~Bus() noexcept;
@@ -1490,6 +1558,16 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
                 size_t get_active_voices_count() const noexcept;
 
+                void set_voice_rendering_threads(
+                    Integer const threads
+                ) noexcept;
+
+                Integer get_voice_rendering_threads() const noexcept;
+
+                void set_parallel_rendering_allowed(
+                    bool const is_allowed
+                ) noexcept;
+
             protected:
                 Sample const* const* initialize_rendering(
                     Integer const round,
@@ -1504,14 +1582,74 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 ) noexcept JS80P_OVERRIDE;
 
             private:
+                template<class VoiceClass>
+                class VoiceRenderingJob
+                {
+                    public:
+                        static void run(
+                            void* job,
+                            Integer const index,
+                            Integer const thread
+                        ) noexcept;
+
+                        Bus& bus;
+                        VoiceClass* const* const voices;
+                        Integer const round;
+                        Integer const sample_count;
+                };
+
                 static constexpr Sample MODULATOR_VOLUME_THRESHOLD = 0.000001;
 
+                /*
+                Modulators use the first two, carriers use the last two sets of
+                shared filter buffers.
+                */
+                static constexpr Integer VOICE_FILTER_SHARED_BUFFERS = 4;
+
+                /*
+                The leader params which are shared by all modulators and by all
+                carriers respectively, and which the voices render lazily.
+                */
+                static constexpr Integer MODULATOR_LEADERS = 16;
+                static constexpr Integer CARRIER_LEADERS = 18;
+
                 void allocate_buffers() noexcept;
                 void free_buffers() noexcept;
                 void reallocate_buffers() noexcept;
 
+                void allocate_worker_filter_shared_buffers() noexcept;
+                void free_worker_filter_shared_buffers() noexcept;
+
                 void collect_active_voices() noexcept;
 
+                template<class VoiceClass>
+                void use_filter_shared_buffers(
+                    VoiceClass& voice,
+                    Integer const thread
+                ) noexcept;
+
+                template<class VoiceClass>
+                void render_voice(
+                    VoiceClass& voice,
+                    Integer const thread,
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                template<class VoiceClass>
+                void render_shared_leaders(
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
+                template<class VoiceClass>
+                void render_voices_in_parallel(
+                    VoiceClass* const (&voices)[POLYPHONY],
+                    size_t const voices_count,
+                    Integer const round,
+                    Integer const sample_count
+                ) noexcept;
+
                 template<
                     class VoiceClass,
                     bool should_sync_oscillator_inaccuracy,
@@ -1569,6 +1707,14 @@ class Synth : public Midi::EventHandler, public SignalProducer
                 Sample const* input_volume_buffer;
                 Sample** modulators_buffer;
                 Sample** carriers_buffer;
+                FloatParamS* const modulator_leaders[MODULATOR_LEADERS];
+                FloatParamS* const carrier_leaders[CARRIER_LEADERS];
+                BiquadFilterSharedBuffers* const filter_shared_buffers;
+                BiquadFilterSharedBuffers worker_filter_shared_buffers[
+                    WorkerPool::MAX_THREADS
+                ][VOICE_FILTER_SHARED_BUFFERS];
+                WorkerPool worker_pool;
+                bool is_parallel_rendering_allowed;
         };
 
         class ParamIdHashTable
@@ -1765,6 +1911,11 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         static constexpr SPSCQueue<Message>::SizeType MESSAGE_QUEUE_SIZE = 8192;
 
+        static constexpr SPSCQueue<Message>::SizeType MESSAGE_BATCH_SIZE = 64;
+
+        static constexpr SPSCQueue<ParamId>::SizeType
+            CHANGED_PARAMS_QUEUE_SIZE = 4096;
+
         static constexpr Number MIDI_WORD_SCALE = 1.0 / 16384.0;
         static constexpr Number MIDI_BYTE_SCALE = 1.0 / 127.0;
 
@@ -1852,6 +2003,11 @@ class Synth : public Midi::EventHandler, public SignalProducer
         void stop_lfos() noexcept;
         void start_lfos() noexcept;
 
+        void prepare_tape(
+            ParamId const param_id,
+            Number const ratio
+        ) const noexcept;
+
         void handle_set_param(
             ParamId const param_id,
             Number const ratio
@@ -1869,6 +2025,13 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         void handle_refresh_param(ParamId const param_id) noexcept;
 
+        void update_param_ratio(
+            ParamId const param_id,
+            Number const ratio
+        ) noexcept;
+
+        void notify_param_change(ParamId const param_id) noexcept;
+
         void handle_clear() noexcept;
 
         void handle_randomize() noexcept;
@@ -1911,6 +2074,17 @@ class Synth : public Midi::EventHandler, public SignalProducer
         bool should_sync_oscillator_inaccuracy() const noexcept;
         bool should_sync_oscillator_instability() const noexcept;
 
+        bool can_render_voices_in_parallel() const noexcept;
+
+        void compile_macro_evaluation_plan() noexcept;
+
+        void add_to_macro_evaluation_plan(
+            Integer const macro_index,
+            Byte* const visit_states
+        ) noexcept;
+
+        Integer find_macro_index(Macro const* const macro) const noexcept;
+
         void note_on_polyphonic(
             Seconds const time_offset,
             Midi::Channel const channel,
@@ -1966,6 +2140,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         std::vector<DeferredNoteOff> deferred_note_offs;
         SPSCQueue<Message> messages;
+        SPSCQueue<ParamId> changed_params;
         Bus bus;
         NoteStack note_stack;
         PeakTracker osc_1_peak_tracker;
@@ -1985,12 +2160,28 @@ class Synth : public Midi::EventHandler, public SignalProducer
 
         FloatParamS* sample_evaluated_float_params[ParamId::PARAM_ID_COUNT];
         FloatParamB* block_evaluated_float_params[ParamId::PARAM_ID_COUNT];
+
+        /*
+        Intrusive lists of the float params which may need to be rendered in
+        the current round, see FloatParam::set_active_params_list().
+        */
+        FloatParamS* active_sample_evaluated_float_params;
+        FloatParamB* active_block_evaluated_float_params;
+
         ByteParam* byte_params[ParamId::PARAM_ID_COUNT];
         std::atomic<Number> param_ratios[ParamId::PARAM_ID_COUNT];
         std::atomic<Byte> controller_assignments[ParamId::PARAM_ID_COUNT];
+        std::atomic<bool> param_changes_dropped;
         Envelope* envelopes_rw[Constants::ENVELOPES];
         LFO* lfos_rw[Constants::LFOS];
         Macro* macros_rw[MACROS];
+
+        /*
+        The macros which are in use, ordered so that each one comes after the
+        macros which control its parameters, see
+        compile_macro_evaluation_plan().
+        */
+        Macro* macro_evaluation_plan[MACROS];
         MidiController* midi_controllers_rw[MIDI_CONTROLLERS];
         Integer midi_note_to_voice_assignments[Midi::CHANNELS][Midi::NOTES];
         OscillatorInaccuracy* synced_oscillator_inaccuracies[POLYPHONY];
@@ -2003,6 +2194,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
         Integer samples_between_gc;
         Integer next_voice;
         Integer next_note_id;
+        Integer macro_evaluation_plan_length;
         Midi::Note previous_note;
         Byte previous_note_handling;
         std::atomic<bool> is_mts_esp_connected_;
@@ -2012,6 +2204,7 @@ class Synth : public Midi::EventHandler, public SignalProducer
         bool is_dirty_:1;
         bool has_cc_74:1;
         bool has_channel_pressure:1;
+        bool is_macro_evaluation_plan_dirty:1;
 
     public:
         Effects::Effects<Bus> effects;
@@ -0,0 +1,451 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__TABLE_CACHE_CPP
+#define JS80P__TABLE_CACHE_CPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+/* The synth is compiled as a single unit, and it relies on std::min(). */
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "table_cache.hpp"
+
+
+namespace JS80P
+{
+
+std::string const& TableCache::get_default_directory() noexcept
+{
+    static std::string const directory = []() -> std::string {
+        /*
+        Development builds would keep loading stale tables after changes to
+        the code that generates them, since their version never changes.
+        */
+        if (std::strcmp(JS80P_TO_STRING(JS80P_VERSION_STR), "dev") == 0) {
+            return "";
+        }
+
+#ifdef _WIN32
+        char const* const local_app_data = std::getenv("LOCALAPPDATA");
+
+        if (local_app_data == NULL || *local_app_data == '\x00') {
+            return "";
+        }
+
+        return std::string(local_app_data) + "\\js80p";
+#else
+        char const* const home = std::getenv("HOME");
+
+  #ifdef __APPLE__
+        if (home == NULL || *home == '\x00') {
+            return "";
+        }
+
+        return std::string(home) + "/Library/Caches/js80p";
+  #else
+        char const* const xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+
+        if (xdg_cache_home != NULL && *xdg_cache_home != '\x00') {
+            return std::string(xdg_cache_home) + "/js80p";
+        }
+
+        if (home == NULL || *home == '\x00') {
+            return "";
+        }
+
+        return std::string(home) + "/.cache/js80p";
+  #endif
+#endif
+    }();
+
+    return directory;
+}
+
+
+TableCache::TableCache(
+        std::string const& directory,
+        std::string const& name,
+        size_t const size
+) noexcept
+    : directory(directory),
+    path(build_path(directory, name)),
+    size(size),
+    key(build_key(name)),
+    file_data(NULL)
+#ifdef _WIN32
+    , mapping(NULL)
+#endif
+{
+    map();
+}
+
+
+TableCache::~TableCache()
+{
+    unmap();
+}
+
+
+std::string TableCache::build_path(
+        std::string const& directory,
+        std::string const& name
+) noexcept {
+    if (directory.empty()) {
+        return "";
+    }
+
+#ifdef _WIN32
+    constexpr char separator = '\\';
+#else
+    constexpr char separator = '/';
+#endif
+
+    return directory + separator + build_file_name(name);
+}
+
+
+std::string TableCache::build_file_name(std::string const& name) noexcept
+{
+    return (
+        std::string(
+            "tables-" JS80P_TO_STRING(JS80P_VERSION_STR)
+            "-" JS80P_TO_STRING(JS80P_INSTRUCTION_SET)
+        )
+        + "-" + std::to_string(sizeof(Number) * 8)
+        + "-f" + std::to_string(FORMAT_VERSION)
+        + "-" + name
+        + ".bin"
+    );
+}
+
+
+uint64_t TableCache::build_key(std::string const& name) noexcept
+{
+    std::string const file_name = build_file_name(name);
+
+    return hash(file_name.data(), file_name.length());
+}
+
+
+uint64_t TableCache::hash(void const* const data, size_t const size) noexcept
+{
+    /*
+    FNV-1a, but taking 8 bytes at a time, since it has to go through several
+    megabytes of tables.
+    */
+    constexpr uint64_t prime = 0x100000001b3;
+
+    unsigned char const* const bytes = (unsigned char const*)data;
+    size_t const words_end = size - size % sizeof(uint64_t);
+    uint64_t result = 0xcbf29ce484222325;
+
+    for (size_t i = 0; i != words_end; i += sizeof(uint64_t)) {
+        uint64_t word;
+
+        std::memcpy(&word, &bytes[i], sizeof(uint64_t));
+        result = (result ^ word) * prime;
+    }
+
+    for (size_t i = words_end; i != size; ++i) {
+        result = (result ^ (uint64_t)bytes[i]) * prime;
+    }
+
+    return result;
+}
+
+
+void const* TableCache::get_data() const noexcept
+{
+    return file_data == NULL ? NULL : file_data + HEADER_SIZE;
+}
+
+
+std::string const& TableCache::get_path() const noexcept
+{
+    return path;
+}
+
+
+bool TableCache::is_valid(unsigned char const* const file_data) const noexcept
+{
+    Header header;
+
+    std::memcpy(&header, file_data, sizeof(Header));
+
+    return (
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.format_version == FORMAT_VERSION
+        && header.size == (uint64_t)size
+        && header.key == key
+        && header.checksum == hash(file_data + HEADER_SIZE, size)
+    );
+}
+
+
+bool TableCache::store(void const* const data) const noexcept
+{
+    if (path.empty() || file_data != NULL || !create_directory(directory)) {
+        return false;
+    }
+
+    /*
+    Several processes may be racing to create the same file, so each of them
+    writes its own temporary file, and the one which renames it last wins.
+    Since their contents are identical, it doesn't matter which one it is.
+    */
+
+#ifdef _WIN32
+    std::string const temp_path = (
+        path + ".tmp" + std::to_string((unsigned long)GetCurrentProcessId())
+    );
+#else
+    std::string const temp_path = (
+        path + ".tmp" + std::to_string((unsigned long)getpid())
+    );
+#endif
+
+    unsigned char header[HEADER_SIZE];
+    Header const header_fields = {
+        {MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3],
+            MAGIC[4], MAGIC[5], MAGIC[6], MAGIC[7]},
+        FORMAT_VERSION,
+        0,
+        (uint64_t)size,
+        key,
+        hash(data, size),
+    };
+
+    std::fill_n(header, HEADER_SIZE, 0);
+    std::memcpy(header, &header_fields, sizeof(Header));
+
+    {
+        std::ofstream file(
+            temp_path, std::ios::out | std::ios::binary | std::ios::trunc
+        );
+
+        if (!file.is_open()) {
+            return false;
+        }
+
+        file.write((char const*)header, HEADER_SIZE);
+        file.write((char const*)data, (std::streamsize)size);
+
+        if (!file.good()) {
+            file.close();
+            std::remove(temp_path.c_str());
+
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    bool const is_renamed = MoveFileExA(
+        temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING
+    ) != 0;
+#else
+    bool const is_renamed = std::rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+
+    if (!is_renamed) {
+        std::remove(temp_path.c_str());
+    }
+
+    return is_renamed;
+}
+
+
+#ifdef _WIN32
+
+bool TableCache::create_directory(std::string const& directory) noexcept
+{
+    return (
+        CreateDirectoryA(directory.c_str(), NULL) != 0
+        || GetLastError() == ERROR_ALREADY_EXISTS
+    );
+}
+
+
+void TableCache::map() noexcept
+{
+    if (path.empty()) {
+        return;
+    }
+
+    HANDLE const file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (
+            GetFileSizeEx(file, &file_size) == 0
+            || (uint64_t)file_size.QuadPart != (uint64_t)(HEADER_SIZE + size)
+    ) {
+        CloseHandle(file);
+
+        return;
+    }
+
+    HANDLE const file_mapping = CreateFileMappingA(
+        file, NULL, PAGE_READONLY, 0, 0, NULL
+    );
+
+    CloseHandle(file);
+
+    if (file_mapping == NULL) {
+        return;
+    }
+
+    void const* const view = MapViewOfFile(
+        file_mapping, FILE_MAP_READ, 0, 0, 0
+    );
+
+    if (view == NULL) {
+        CloseHandle(file_mapping);
+
+        return;
+    }
+
+    if (!is_valid((unsigned char const*)view)) {
+        UnmapViewOfFile(view);
+        CloseHandle(file_mapping);
+
+        return;
+    }
+
+    mapping = (void*)file_mapping;
+    file_data = (unsigned char const*)view;
+}
+
+
+void TableCache::unmap() noexcept
+{
+    if (file_data == NULL) {
+        return;
+    }
+
+    UnmapViewOfFile((void const*)file_data);
+    CloseHandle((HANDLE)mapping);
+
+    file_data = NULL;
+    mapping = NULL;
+}
+
+#else
+
+bool TableCache::create_directory(std::string const& directory) noexcept
+{
+    /*
+    The parent directory (e.g. ~/.cache) may not exist either on a fresh
+    system.
+    */
+
+    std::string::size_type const last_slash = directory.rfind('/');
+
+    if (last_slash != std::string::npos && last_slash != 0) {
+        mkdir(directory.substr(0, last_slash).c_str(), 0700);
+    }
+
+    return mkdir(directory.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+
+void TableCache::map() noexcept
+{
+    if (path.empty()) {
+        return;
+    }
+
+    int const file = open(path.c_str(), O_RDONLY);
+
+    if (file < 0) {
+        return;
+    }
+
+    struct stat file_stat;
+
+    if (
+            fstat(file, &file_stat) != 0
+            || (uint64_t)file_stat.st_size != (uint64_t)(HEADER_SIZE + size)
+    ) {
+        close(file);
+
+        return;
+    }
+
+    void* const mapped = mmap(
+        NULL, HEADER_SIZE + size, PROT_READ, MAP_SHARED, file, 0
+    );
+
+    close(file);
+
+    if (mapped == MAP_FAILED) {
+        return;
+    }
+
+    if (!is_valid((unsigned char const*)mapped)) {
+        munmap(mapped, HEADER_SIZE + size);
+
+        return;
+    }
+
+    file_data = (unsigned char const*)mapped;
+}
+
+
+void TableCache::unmap() noexcept
+{
+    if (file_data == NULL) {
+        return;
+    }
+
+    munmap((void*)file_data, HEADER_SIZE + size);
+    file_data = NULL;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__TABLE_CACHE_HPP
+#define JS80P__TABLE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "js80p.hpp"
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A read-only, memory-mapped file which holds precomputed lookup tables,
+ *        so that processes which load the plugin after the first one can skip
+ *        computing them, and the operating system can let all of them share
+ *        the same physical memory pages.
+ *
+ * \note The cache is best effort: if the directory is not available or not
+ *       writable (e.g. in a sandbox), then the tables are simply computed in
+ *       memory as usual.
+ */
+class TableCache
+{
+    public:
+        /**
+         * \brief The default directory for the cache files, or an empty string
+         *        if no suitable directory is known, or if this is a development
+         *        build.
+         */
+        static std::string const& get_default_directory() noexcept;
+
+        /**
+         * \brief Open and map the cache file of the tables that are identified
+         *        by \c name. The name must contain everything that the content
+         *        of the tables depends on (sizes, parameters, the version of
+         *        the code which generates them, etc.); the plugin version, the
+         *        instruction set, and the size of \c Number are added
+         *        automatically.
+         */
+        TableCache(
+            std::string const& directory,
+            std::string const& name,
+            size_t const size
+        ) noexcept;
+
+        ~TableCache();
+
+        TableCache(TableCache const& table_cache) = delete;
+        TableCache(TableCache&& table_cache) = delete;
+
+        TableCache& operator=(TableCache const& table_cache) = delete;
+        TableCache& operator=(TableCache&& table_cache) = delete;
+
+        /**
+         * \brief The cached tables, or \c NULL when there was no valid cache
+         *        file, in which case the tables need to be computed and then
+         *        passed to \c store().
+         */
+        void const* get_data() const noexcept;
+
+        /**
+         * \brief Write the computed tables to the cache file, so that they can
+         *        be mapped by the next process. The file is written under a
+         *        temporary name and then renamed, so other processes never see
+         *        a partially written file.
+         */
+        bool store(void const* const data) const noexcept;
+
+        std::string const& get_path() const noexcept;
+
+    private:
+        static constexpr char const MAGIC[8] = {
+            'J', 'S', '8', '0', 'P', 'T', 'B', 'L'
+        };
+
+        /* Increment this when the layout of the file changes. */
+        static constexpr uint32_t FORMAT_VERSION = 2;
+
+        /*
+        The header is padded to a whole cache line, so that the tables in the
+        mapped file are aligned just as well as if they were allocated with
+        new[].
+        */
+        static constexpr size_t HEADER_SIZE = 64;
+
+        /*
+        The key is a hash of the file name (which contains everything that the
+        tables depend on), so that a file which was renamed or copied from
+        somewhere else is not mistaken for different tables. The
+        checksum protects against files which were truncated, partially
+        written, or corrupted otherwise.
+        */
+        struct Header {
+            char magic[8];
+            uint32_t format_version;
+            uint32_t reserved;
+            uint64_t size;
+            uint64_t key;
+            uint64_t checksum;
+        };
+
+        static_assert(sizeof(Header) <= HEADER_SIZE, "Header is too big");
+
+        static uint64_t hash(void const* const data, size_t const size) noexcept;
+
+        static std::string build_file_name(std::string const& name) noexcept;
+        static uint64_t build_key(std::string const& name) noexcept;
+
+        static std::string build_path(
+            std::string const& directory,
+            std::string const& name
+        ) noexcept;
+
+        static bool create_directory(std::string const& directory) noexcept;
+
+        void map() noexcept;
+        void unmap() noexcept;
+
+        bool is_valid(unsigned char const* const file_data) const noexcept;
+
+        std::string const directory;
+        std::string const path;
+        size_t const size;
+        uint64_t const key;
+
+        unsigned char const* file_data;
+
+#ifdef _WIN32
+        void* mapping;
+#endif
+};
+
+}
+
+#endif
@@ -261,6 +261,18 @@ Voice<ModulatorSignalProducerClass>::Params::Params(
     harmonic_7(name + "C8", -1.0, 1.0, 0.0),
     harmonic_8(name + "C9", -1.0, 1.0, 0.0),
     harmonic_9(name + "C10", -1.0, 1.0, 0.0),
+    custom_waveform(
+        harmonic_0,
+        harmonic_1,
+        harmonic_2,
+        harmonic_3,
+        harmonic_4,
+        harmonic_5,
+        harmonic_6,
+        harmonic_7,
+        harmonic_8,
+        harmonic_9
+    ),
 
     filter_1_type(name + "F1TYP"),
     filter_1_freq_log_scale(name + "F1LOG", ToggleParam::OFF),
@@ -497,16 +509,7 @@ Voice<ModulatorSignalProducerClass>::Voice(
         param_leaders.detune,
         param_leaders.fine_detune,
         param_leaders.fine_detune_x4,
-        param_leaders.harmonic_0,
-        param_leaders.harmonic_1,
-        param_leaders.harmonic_2,
-        param_leaders.harmonic_3,
-        param_leaders.harmonic_4,
-        param_leaders.harmonic_5,
-        param_leaders.harmonic_6,
-        param_leaders.harmonic_7,
-        param_leaders.harmonic_8,
-        param_leaders.harmonic_9,
+        param_leaders.custom_waveform,
         status
     ),
     noise_generator(
@@ -585,16 +588,7 @@ Voice<ModulatorSignalProducerClass>::Voice(
         param_leaders.detune,
         param_leaders.fine_detune,
         param_leaders.fine_detune_x4,
-        param_leaders.harmonic_0,
-        param_leaders.harmonic_1,
-        param_leaders.harmonic_2,
-        param_leaders.harmonic_3,
-        param_leaders.harmonic_4,
-        param_leaders.harmonic_5,
-        param_leaders.harmonic_6,
-        param_leaders.harmonic_7,
-        param_leaders.harmonic_8,
-        param_leaders.harmonic_9,
+        param_leaders.custom_waveform,
         status,
         modulator,
         amplitude_modulation_level_leader,
@@ -1633,6 +1627,16 @@ void Voice<ModulatorSignalProducerClass>::render_oscillator(
 }
 
 
+template<class ModulatorSignalProducerClass>
+void Voice<ModulatorSignalProducerClass>::set_filter_shared_buffers(
+        BiquadFilterSharedBuffers* const filter_1_shared_buffers,
+        BiquadFilterSharedBuffers* const filter_2_shared_buffers
+) noexcept {
+    filter_1.set_shared_buffers(filter_1_shared_buffers);
+    filter_2.set_shared_buffers(filter_2_shared_buffers);
+}
+
+
 template<class ModulatorSignalProducerClass>
 Sample const* const* Voice<ModulatorSignalProducerClass>::initialize_rendering(
         Integer const round,
@@ -196,6 +196,8 @@ class Voice : public SignalProducer
                 FloatParamB harmonic_8;
                 FloatParamB harmonic_9;
 
+                CustomWaveform custom_waveform;
+
                 BiquadFilterTypeParam filter_1_type;
                 ToggleParam filter_1_freq_log_scale;
                 ToggleParam filter_1_q_log_scale;
@@ -394,6 +396,11 @@ class Voice : public SignalProducer
             Integer const sample_count
         ) noexcept;
 
+        void set_filter_shared_buffers(
+            BiquadFilterSharedBuffers* const filter_1_shared_buffers,
+            BiquadFilterSharedBuffers* const filter_2_shared_buffers
+        ) noexcept;
+
         typename std::conditional<
             IS_MODULATOR, FloatParamS, Dummy
         >::type additive_volume;
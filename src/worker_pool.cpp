@@ -0,0 +1,258 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__WORKER_POOL_CPP
+#define JS80P__WORKER_POOL_CPP
+
+#include <algorithm>
+
+#include "worker_pool.hpp"
+
+
+namespace JS80P
+{
+
+WorkerPool::WorkerPool() noexcept
+    : ticket(0),
+    finished(0),
+    is_stopping(false),
+    job(NULL),
+    context(NULL),
+    threads(1)
+{
+    std::fegetenv(&fenv);
+
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+    std::fill_n(workers, MAX_THREADS, (std::thread*)NULL);
+    parked_workers.store(0);
+#endif
+}
+
+
+WorkerPool::~WorkerPool()
+{
+    stop_threads();
+}
+
+
+void WorkerPool::set_threads(Integer const threads) noexcept
+{
+#ifdef JS80P_WORKER_POOL_SINGLE_THREADED
+    this->threads = 1;
+#else
+    Integer const new_threads = std::min(
+        MAX_THREADS, std::max((Integer)1, threads)
+    );
+
+    if (new_threads == this->threads) {
+        return;
+    }
+
+    stop_threads();
+    this->threads = new_threads;
+    start_threads();
+#endif
+}
+
+
+Integer WorkerPool::get_threads() const noexcept
+{
+    return threads;
+}
+
+
+void WorkerPool::start_threads() noexcept
+{
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+    is_stopping.store(false);
+
+    for (Integer i = 1; i != threads; ++i) {
+        workers[i] = new std::thread(&WorkerPool::work, this, i);
+    }
+#endif
+}
+
+
+void WorkerPool::stop_threads() noexcept
+{
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        is_stopping.store(true);
+    }
+
+    condition.notify_all();
+
+    for (Integer i = 1; i != MAX_THREADS; ++i) {
+        if (workers[i] != NULL) {
+            workers[i]->join();
+            delete workers[i];
+            workers[i] = NULL;
+        }
+    }
+#endif
+}
+
+
+void WorkerPool::run(
+        Job const job,
+        void* const context,
+        Integer const count
+) noexcept {
+    if (threads < 2 || count < 2 || (uint64_t)count > TICKET_COUNT_MASK) {
+        for (Integer i = 0; i != count; ++i) {
+            job(context, i, 0);
+        }
+
+        return;
+    }
+
+    /*
+    No thread can be running a job at this point, and the ones which are
+    holding a ticket from the previous batch will fail to claim anything with
+    it, so it is safe to replace the members which describe the batch before
+    publishing the new ticket.
+    */
+    this->job = job;
+    this->context = context;
+    std::fegetenv(&fenv);
+
+    finished.store(0, std::memory_order_relaxed);
+
+    uint64_t const generation = (
+        get_generation(ticket.load(std::memory_order_relaxed)) + 1
+    );
+
+    /*
+    Publishing the ticket and checking the number of parked workers are both
+    sequentially consistent, and so are their counterparts in work(), so either
+    the worker sees the new ticket before it would park, or this thread sees
+    that the worker is (about to be) parked.
+    */
+    ticket.store(
+        (generation << TICKET_GENERATION_SHIFT)
+            | ((uint64_t)count << TICKET_COUNT_SHIFT)
+    );
+
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+    if (parked_workers.load() != 0) {
+        condition.notify_all();
+    }
+#endif
+
+    process_jobs(0);
+
+    while (finished.load(std::memory_order_acquire) != count) {
+        /* Only the last few jobs that were claimed by workers are left. */
+    }
+}
+
+
+void WorkerPool::work(WorkerPool* const pool, Integer const thread) noexcept
+{
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+    uint64_t generation = get_generation(pool->ticket.load());
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+
+            pool->parked_workers.fetch_add(1);
+
+            /*
+            A notification which arrives between checking the condition and
+            parking is lost, but then this worker only misses a single batch,
+            because run() doesn't wait for workers to wake up.
+            */
+            pool->condition.wait(
+                lock,
+                [pool, generation]() {
+                    return (
+                        pool->is_stopping.load(std::memory_order_relaxed)
+                        || get_generation(pool->ticket.load()) != generation
+                    );
+                }
+            );
+
+            pool->parked_workers.fetch_sub(1);
+        }
+
+        if (pool->is_stopping.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        generation = get_generation(pool->ticket.load());
+        pool->process_jobs(thread);
+    }
+#endif
+}
+
+
+uint64_t WorkerPool::get_generation(uint64_t const ticket) noexcept
+{
+    return ticket >> TICKET_GENERATION_SHIFT;
+}
+
+
+void WorkerPool::process_jobs(Integer const thread) noexcept
+{
+    uint64_t ticket = this->ticket.load(std::memory_order_acquire);
+    bool has_processed_any = false;
+
+    while (true) {
+        uint64_t const index = ticket & TICKET_INDEX_MASK;
+        uint64_t const count = (
+            (ticket >> TICKET_COUNT_SHIFT) & TICKET_COUNT_MASK
+        );
+
+        if (index >= count) {
+            return;
+        }
+
+        /*
+        A successful claim guarantees that the batch (generation, count, and
+        index) is still the same one that the ticket belongs to, and that it
+        cannot finish (and let run() reuse the job and context members) before
+        this job is done.
+        */
+        if (
+                this->ticket.compare_exchange_weak(
+                    ticket,
+                    ticket + 1,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire
+                )
+        ) {
+            if (thread != 0 && !has_processed_any) {
+                std::fesetenv(&fenv);
+            }
+
+            job(context, (Integer)index, thread);
+            has_processed_any = true;
+
+            finished.fetch_add(1, std::memory_order_release);
+
+            ticket = this->ticket.load(std::memory_order_acquire);
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef JS80P__WORKER_POOL_HPP
+#define JS80P__WORKER_POOL_HPP
+
+#include <atomic>
+#include <cfenv>
+#include <cstdint>
+
+#include "js80p.hpp"
+
+
+/*
+MinGW-w64 toolchains which use the win32 threading model don't provide
+std::thread before GCC 13, so the pool degrades to running everything on the
+calling thread there.
+*/
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_HAS_GTHREADS)
+  #define JS80P_WORKER_POOL_SINGLE_THREADED
+#endif
+
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+
+namespace JS80P
+{
+
+/**
+ * \brief A fixed set of pre-spawned threads which can process a batch of
+ *        independent jobs together with the audio thread.
+ */
+class WorkerPool
+{
+    public:
+        /**
+         * \brief A job receives the context that was passed to \c run(), the
+         *        index of the job within the batch, and the index of the thread
+         *        that is running it. (The thread which called \c run() is
+         *        always thread 0.)
+         */
+        typedef void (*Job)(
+            void* context,
+            Integer const job,
+            Integer const thread
+        ) noexcept;
+
+        static constexpr Integer MAX_THREADS = 16;
+
+        WorkerPool() noexcept;
+        ~WorkerPool();
+
+        WorkerPool(WorkerPool const& worker_pool) = delete;
+        WorkerPool(WorkerPool&& worker_pool) = delete;
+
+        WorkerPool& operator=(WorkerPool const& worker_pool) = delete;
+        WorkerPool& operator=(WorkerPool&& worker_pool) = delete;
+
+        /**
+         * \brief Set the number of threads (including the calling thread of
+         *        \c run() ) that may work on a batch.
+         *
+         * \warning Not real-time safe, and must not be called while \c run() is
+         *          in progress.
+         */
+        void set_threads(Integer const threads) noexcept;
+
+        Integer get_threads() const noexcept;
+
+        /**
+         * \brief Run \c job for each index in <tt>[0, count)</tt>, and return
+         *        when all of them are finished.
+         *
+         * \note Real-time safe: the calling thread never waits for a worker to
+         *       wake up, it keeps processing unclaimed jobs on its own, and it
+         *       only waits for the jobs that are already running on other
+         *       threads. Idle workers are woken up with a single notification
+         *       per batch. Workers run with the floating point environment of
+         *       the calling thread. Batches with more than 65535 jobs are
+         *       run on the calling thread alone.
+         */
+        void run(
+            Job const job,
+            void* const context,
+            Integer const count
+        ) noexcept;
+
+    private:
+        /*
+        The upper half of a ticket holds the generation of the batch, the lower
+        half holds the number of jobs in the batch and the index of the next
+        job to be claimed. Since everything that a thread needs for deciding
+        whether there is a job left to be claimed is in a single atomic
+        variable, a stale ticket can never claim a job from another batch.
+        */
+        static constexpr int TICKET_GENERATION_SHIFT = 32;
+        static constexpr int TICKET_COUNT_SHIFT = 16;
+        static constexpr uint64_t TICKET_COUNT_MASK = 0xffff;
+        static constexpr uint64_t TICKET_INDEX_MASK = 0xffff;
+
+        static void work(WorkerPool* const pool, Integer const thread) noexcept;
+
+        static uint64_t get_generation(uint64_t const ticket) noexcept;
+
+        void start_threads() noexcept;
+        void stop_threads() noexcept;
+
+        void process_jobs(Integer const thread) noexcept;
+
+#ifndef JS80P_WORKER_POOL_SINGLE_THREADED
+        std::thread* workers[MAX_THREADS];
+
+        /*
+        Idle workers are parked on the condition variable until the next batch
+        is published. The calling thread of run() never locks the mutex, it
+        only notifies the workers when some of them are parked.
+        */
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<Integer> parked_workers;
+#endif
+
+        std::atomic<uint64_t> ticket;
+        std::atomic<Integer> finished;
+        std::atomic<bool> is_stopping;
+
+        Job job;
+        void* context;
+        std::fenv_t fenv;
+        Integer threads;
+};
+
+}
+
+#endif
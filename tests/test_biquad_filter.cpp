@@ -25,6 +25,7 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
 #include "dsp/lfo.cpp"
@@ -38,6 +39,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -799,11 +802,11 @@ TEST(when_no_params_are_polyphonic_then_uses_cached_coefficients, {
         "", input, filter_type, NULL
     );
 
-    shared_buffers.b0_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.b1_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.b2_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.a1_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.a2_buffer = new Sample[BLOCK_SIZE];
+    shared_buffers.b0_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b2_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a2_buffer = new Number[BLOCK_SIZE];
 
     filter_clone_1.type.set_value(BiquadFilter<SumOfSines>::BAND_PASS);
     filter_clone_2.type.set_value(BiquadFilter<SumOfSines>::BAND_PASS);
@@ -879,6 +882,7 @@ TEST(when_params_are_polyphonic_then_does_not_use_cached_coefficients, {
     );
 
     lfo.waveform.set_value(LFO::Oscillator_::SQUARE);
+    lfo.waveform.prepare_wavetable(lfo.waveform.get_ratio());
     lfo.frequency.set_value(Constants::LFO_FREQUENCY_MIN);
     lfo.phase.set_value(0.1);
     lfo.min.set_value(0.0);
@@ -896,11 +900,11 @@ TEST(when_params_are_polyphonic_then_does_not_use_cached_coefficients, {
     frequency.set_lfo(&lfo);
     q.set_value(5.0);
 
-    shared_buffers.b0_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.b1_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.b2_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.a1_buffer = new Sample[BLOCK_SIZE];
-    shared_buffers.a2_buffer = new Sample[BLOCK_SIZE];
+    shared_buffers.b0_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b2_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a2_buffer = new Number[BLOCK_SIZE];
 
     envelope.scale.set_value(
         filter_1.frequency.value_to_ratio(7040.0) * headroom
@@ -1081,11 +1085,11 @@ TEST(silent_input_fast_path_keeps_continuity, {
 
     BiquadFilterSharedBuffers shared_buffers;
 
-    shared_buffers.b0_buffer = new Sample[block_size];
-    shared_buffers.b1_buffer = new Sample[block_size];
-    shared_buffers.b2_buffer = new Sample[block_size];
-    shared_buffers.a1_buffer = new Sample[block_size];
-    shared_buffers.a2_buffer = new Sample[block_size];
+    shared_buffers.b0_buffer = new Number[block_size];
+    shared_buffers.b1_buffer = new Number[block_size];
+    shared_buffers.b2_buffer = new Number[block_size];
+    shared_buffers.a1_buffer = new Number[block_size];
+    shared_buffers.a2_buffer = new Number[block_size];
 
     test_fast_path_continuity<block_size>(
         0, NULL, BiquadFilter<FixedSignalProducer>::LOW_PASS, 1.0, 0.0
@@ -25,6 +25,7 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
 #include "dsp/lfo.cpp"
@@ -38,6 +39,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
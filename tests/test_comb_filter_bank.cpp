@@ -0,0 +1,322 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/comb_filter_bank.cpp"
+#include "dsp/cpu.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/gain.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/mixer.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer LANES = 4;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Integer ROUNDS = 80;
+constexpr Frequency SAMPLE_RATE = 22050.0;
+constexpr Seconds TIME_MAX = 0.45;
+
+
+typedef DistortedHighShelfStereoPannedDelay<
+    SumOfSines,
+    DelayCapabilities::DC_SCALABLE
+> CombFilter;
+
+typedef CombFilterBank<SumOfSines, LANES> SumOfSinesCombFilterBank;
+typedef CombFilterBank<FixedSignalProducer, LANES> FixedCombFilterBank;
+
+
+class Tuning
+{
+    public:
+        Seconds const delay_time;
+        Number const weight;
+        Number const panning_scale;
+};
+
+
+constexpr Tuning TUNINGS[LANES] = {
+    {0.011, 1.00, 1.0},
+    {0.017, 0.70, -0.6},
+    {0.023, 0.90, 0.4},
+    {0.000, 0.00, 1.0},
+};
+
+
+void allocate_shared_buffers(BiquadFilterSharedBuffers& shared_buffers)
+{
+    shared_buffers.b0_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.b2_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a1_buffer = new Number[BLOCK_SIZE];
+    shared_buffers.a2_buffer = new Number[BLOCK_SIZE];
+}
+
+
+void free_shared_buffers(BiquadFilterSharedBuffers& shared_buffers)
+{
+    delete[] shared_buffers.b0_buffer;
+    delete[] shared_buffers.b1_buffer;
+    delete[] shared_buffers.b2_buffer;
+    delete[] shared_buffers.a1_buffer;
+    delete[] shared_buffers.a2_buffer;
+}
+
+
+void test_comb_filter_bank(
+        bool const is_automated,
+        Number const distortion_level_value
+) {
+    SumOfSines input(0.3, 220.0, 0.2, 1760.0, 0.1, 5000.0, CHANNELS);
+    FloatParamS width("W", -1.0, 1.0, 0.3);
+    FloatParamS reflectivity(
+        "G",
+        Constants::DELAY_FEEDBACK_MIN,
+        Constants::DELAY_FEEDBACK_MAX,
+        0.8
+    );
+    FloatParamS room_size("RS", 0.0, 3.0, 0.7);
+    FloatParamS damping_frequency(
+        "DF",
+        Constants::BIQUAD_FILTER_FREQUENCY_MIN,
+        Constants::BIQUAD_FILTER_FREQUENCY_MAX,
+        3000.0
+    );
+    FloatParamS damping_gain("DG", -36.0, -0.01, -6.0);
+    FloatParamS distortion_level("DST", 0.0, 1.0, distortion_level_value);
+    Distortion::TypeParam distortion_type(
+        "DSTTYP", Distortion::TYPE_DELAY_FEEDBACK
+    );
+    BiquadFilterSharedBuffers expected_shared_buffers;
+    BiquadFilterSharedBuffers actual_shared_buffers;
+    FloatParamS* const params[] = {
+        &width,
+        &reflectivity,
+        &room_size,
+        &damping_frequency,
+        &damping_gain,
+        &distortion_level,
+    };
+
+    allocate_shared_buffers(expected_shared_buffers);
+    allocate_shared_buffers(actual_shared_buffers);
+
+    CombFilter* comb_filters[LANES];
+    Mixer<CombFilter> mixer(CHANNELS);
+    SumOfSinesCombFilterBank comb_filter_bank(
+        input,
+        width,
+        reflectivity,
+        room_size,
+        TIME_MAX,
+        actual_shared_buffers,
+        damping_frequency,
+        damping_gain,
+        distortion_level
+    );
+    Buffer expected_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+    Buffer actual_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+
+    input.set_sample_rate(SAMPLE_RATE);
+    input.set_block_size(BLOCK_SIZE);
+
+    for (Integer i = 0; i != 6; ++i) {
+        params[i]->set_sample_rate(SAMPLE_RATE);
+        params[i]->set_block_size(BLOCK_SIZE);
+    }
+
+    for (Integer l = 0; l != LANES; ++l) {
+        Tuning const& tuning = TUNINGS[l];
+
+        comb_filters[l] = new CombFilter(
+            input,
+            StereoPannedDelayMode::NORMAL,
+            width,
+            reflectivity,
+            tuning.delay_time,
+            TIME_MAX,
+            expected_shared_buffers,
+            damping_frequency,
+            damping_gain,
+            distortion_level,
+            distortion_type
+        );
+        comb_filters[l]->delay.set_feedback_signal_producer(
+            comb_filters[l]->high_shelf_filter
+        );
+        comb_filters[l]->delay.set_time_scale_param(room_size);
+        comb_filters[l]->set_sample_rate(SAMPLE_RATE);
+        comb_filters[l]->set_block_size(BLOCK_SIZE);
+        comb_filters[l]->set_panning_scale(tuning.panning_scale);
+
+        mixer.add(*comb_filters[l]);
+        mixer.set_weight((size_t)l, tuning.weight);
+
+        comb_filter_bank.set_lane(
+            l, tuning.delay_time, tuning.panning_scale, tuning.weight
+        );
+    }
+
+    mixer.set_sample_rate(SAMPLE_RATE);
+    mixer.set_block_size(BLOCK_SIZE);
+    comb_filter_bank.set_sample_rate(SAMPLE_RATE);
+    comb_filter_bank.set_block_size(BLOCK_SIZE);
+
+    if (is_automated) {
+        width.schedule_linear_ramp(0.3, -0.7);
+        room_size.schedule_linear_ramp(0.2, 0.9);
+        damping_frequency.schedule_linear_ramp(0.25, 9000.0);
+        damping_gain.schedule_linear_ramp(0.15, -12.0);
+        distortion_level.schedule_linear_ramp(0.1, 0.7);
+        reflectivity.schedule_linear_ramp(0.35, 0.6);
+    }
+
+    expected_output.reset();
+    actual_output.reset();
+
+    for (Integer round = 1; round != ROUNDS + 1; ++round) {
+        expected_output.append(
+            SignalProducer::produce< Mixer<CombFilter> >(
+                mixer, round, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+        actual_output.append(
+            SignalProducer::produce<SumOfSinesCombFilterBank>(
+                comb_filter_bank, round, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            BLOCK_SIZE * ROUNDS,
+            0.001,
+            "channel=%d",
+            (int)c
+        );
+    }
+
+    for (Integer l = 0; l != LANES; ++l) {
+        delete comb_filters[l];
+    }
+
+    free_shared_buffers(expected_shared_buffers);
+    free_shared_buffers(actual_shared_buffers);
+}
+
+
+TEST(renders_the_same_signal_as_independent_comb_filters, {
+    test_comb_filter_bank(false, 0.0);
+    test_comb_filter_bank(false, 0.5);
+})
+
+
+TEST(renders_the_same_signal_as_independent_comb_filters_with_automation, {
+    test_comb_filter_bank(true, 0.0);
+})
+
+
+TEST(when_input_becomes_silent_then_bank_falls_silent_after_the_tail, {
+    constexpr Integer rounds = 300;
+
+    Sample impulse[CHANNELS][BLOCK_SIZE] = {};
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const impulse_channels[] = {impulse[0], impulse[1]};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(impulse_channels);
+    FloatParamS width("W", -1.0, 1.0, 0.0);
+    FloatParamS reflectivity("G", 0.0, 0.999, 0.5);
+    FloatParamS room_size("RS", 0.0, 3.0, 1.0);
+    FloatParamS damping_frequency("DF", 1.0, 20000.0, 5000.0);
+    FloatParamS damping_gain("DG", -36.0, -0.01, -6.0);
+    FloatParamS distortion_level("DST", 0.0, 1.0, 0.0);
+    BiquadFilterSharedBuffers shared_buffers;
+    FixedCombFilterBank comb_filter_bank(
+        input,
+        width,
+        reflectivity,
+        room_size,
+        0.05,
+        shared_buffers,
+        damping_frequency,
+        damping_gain,
+        distortion_level
+    );
+    Sample peak = 0.0;
+
+    impulse[0][0] = 1.0;
+    impulse[1][0] = 1.0;
+
+    allocate_shared_buffers(shared_buffers);
+
+    comb_filter_bank.set_sample_rate(SAMPLE_RATE);
+    comb_filter_bank.set_block_size(BLOCK_SIZE);
+
+    for (Integer l = 0; l != LANES; ++l) {
+        comb_filter_bank.set_lane(l, 0.01 * (Number)(l + 1), 1.0, 1.0);
+    }
+
+    for (Integer round = 1; round != rounds + 1; ++round) {
+        Sample const* const* const block = (
+            SignalProducer::produce<FixedCombFilterBank>(
+                comb_filter_bank, round, BLOCK_SIZE
+            )
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            for (Integer i = 0; i != BLOCK_SIZE; ++i) {
+                peak = std::max(peak, std::fabs(block[c][i]));
+            }
+        }
+
+        input.set_fixed_samples(silent_channels);
+    }
+
+    assert_gt(peak, 0.1);
+    assert_true(comb_filter_bank.is_silent(rounds, BLOCK_SIZE));
+
+    free_shared_buffers(shared_buffers);
+})
@@ -25,6 +25,7 @@
 #include "js80p.hpp"
 
 #include "dsp/compressor.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/effect.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -41,6 +42,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -0,0 +1,70 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "test.cpp"
+#include "utils.hpp"
+
+#include "js80p.hpp"
+
+#include "dsp/cpu.cpp"
+
+
+using namespace JS80P;
+
+
+TEST(instruction_set_detection_is_stable, {
+    CPU::InstructionSet const instruction_set = CPU::get_instruction_set();
+    char const* const name = CPU::get_instruction_set_name();
+
+    assert_eq((int)instruction_set, (int)CPU::get_instruction_set());
+    assert_gte((int)instruction_set, (int)CPU::InstructionSet::BASELINE);
+    assert_lte((int)instruction_set, (int)CPU::InstructionSet::AVX512);
+    assert_gt((int)std::strlen(name), 0);
+    assert_eq(name, CPU::get_instruction_set_name());
+})
+
+
+TEST(kernel_is_run_exactly_once, {
+    constexpr Integer size = 1000;
+
+    Sample input[size];
+    Sample expected_output[size];
+    Sample output[size];
+    int calls = 0;
+
+    for (Integer i = 0; i != size; ++i) {
+        input[i] = (Sample)i / (Sample)size;
+        expected_output[i] = 0.25 + 0.5 * input[i] * input[i];
+        output[i] = 0.0;
+    }
+
+    CPU::dispatch(
+        [&] () JS80P_KERNEL {
+            ++calls;
+
+            for (Integer i = 0; i != size; ++i) {
+                output[i] = 0.25 + 0.5 * input[i] * input[i];
+            }
+        }
+    );
+
+    assert_eq(1, calls);
+    assert_close(expected_output, output, size, DOUBLE_DELTA);
+})
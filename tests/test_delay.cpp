@@ -22,7 +22,9 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -38,6 +40,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
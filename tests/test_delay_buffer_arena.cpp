@@ -0,0 +1,364 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/gain.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Integer ROUNDS = 40;
+
+
+typedef Delay<SumOfSines> SumOfSinesDelay;
+
+
+TEST(regions_are_aligned_zero_initialized_and_do_not_overlap, {
+    constexpr Integer regions_count = 3;
+    constexpr Integer channels[regions_count] = {2, 1, 2};
+    constexpr Integer capacities[regions_count] = {1000, 37, 5};
+
+    DelayBufferArena arena;
+    DelayBufferArena::Region* regions[regions_count];
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        regions[r] = arena.reserve(channels[r], capacities[r]);
+        regions[r]->use(capacities[r]);
+    }
+
+    assert_false(arena.is_allocated());
+    assert_eq(NULL, regions[0]->buffer[0]);
+
+    arena.allocate();
+
+    assert_true(arena.is_allocated());
+    assert_gte((int)arena.get_size(), (int)(2047 * sizeof(Sample)));
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        for (Integer c = 0; c != channels[r]; ++c) {
+            Sample* const channel = regions[r]->buffer[c];
+
+            assert_eq(
+                0,
+                (int)((uintptr_t)channel % 64),
+                "r=%d, c=%d",
+                (int)r,
+                (int)c
+            );
+
+            for (Integer i = 0; i != capacities[r]; ++i) {
+                assert_eq(
+                    0.0,
+                    channel[i],
+                    DOUBLE_DELTA,
+                    "r=%d, c=%d, i=%d",
+                    (int)r,
+                    (int)c,
+                    (int)i
+                );
+            }
+
+            std::fill_n(channel, capacities[r], (Sample)(r * 10 + c + 1));
+        }
+    }
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        for (Integer c = 0; c != channels[r]; ++c) {
+            Sample const expected = (Sample)(r * 10 + c + 1);
+
+            for (Integer i = 0; i != capacities[r]; ++i) {
+                assert_eq(
+                    expected,
+                    regions[r]->buffer[c][i],
+                    DOUBLE_DELTA,
+                    "r=%d, c=%d, i=%d",
+                    (int)r,
+                    (int)c,
+                    (int)i
+                );
+            }
+        }
+    }
+})
+
+
+TEST(clearing_a_region_zeroes_it_without_touching_its_neighbours, {
+    constexpr Integer regions_count = 3;
+    constexpr Integer channels[regions_count] = {1, 2, 1};
+    constexpr Integer capacities[regions_count] = {3, 50000, 7};
+
+    DelayBufferArena arena;
+    DelayBufferArena::Region* regions[regions_count];
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        regions[r] = arena.reserve(channels[r], capacities[r]);
+        regions[r]->use(capacities[r]);
+    }
+
+    regions[1]->clear();
+
+    arena.allocate();
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        for (Integer c = 0; c != channels[r]; ++c) {
+            std::fill_n(
+                regions[r]->buffer[c], capacities[r], (Sample)(r * 10 + c + 1)
+            );
+        }
+    }
+
+    regions[1]->clear();
+
+    for (Integer r = 0; r != regions_count; ++r) {
+        for (Integer c = 0; c != channels[r]; ++c) {
+            Sample const expected = r == 1 ? 0.0 : (Sample)(r * 10 + c + 1);
+
+            for (Integer i = 0; i != capacities[r]; ++i) {
+                assert_eq(
+                    expected,
+                    regions[r]->buffer[c][i],
+                    DOUBLE_DELTA,
+                    "r=%d, c=%d, i=%d",
+                    (int)r,
+                    (int)c,
+                    (int)i
+                );
+            }
+        }
+    }
+})
+
+
+TEST(using_more_of_a_region_zeroes_the_samples_in_use, {
+    constexpr Integer channels = 2;
+    constexpr Integer capacity = 5000;
+
+    DelayBufferArena arena;
+    DelayBufferArena::Region* const region = arena.reserve(channels, capacity);
+
+    region->use(100);
+    arena.allocate();
+
+    for (Integer c = 0; c != channels; ++c) {
+        std::fill_n(region->buffer[c], 100, 1.0);
+    }
+
+    region->use(capacity);
+
+    for (Integer c = 0; c != channels; ++c) {
+        for (Integer i = 0; i != capacity; ++i) {
+            assert_eq(
+                0.0,
+                region->buffer[c][i],
+                DOUBLE_DELTA,
+                "c=%d, i=%d",
+                (int)c,
+                (int)i
+            );
+        }
+    }
+})
+
+
+void assert_region_samples(
+        DelayBufferArena::Region const& region,
+        Integer const samples,
+        Sample const expected,
+        char const* const message
+) {
+    for (Integer c = 0; c != region.channels; ++c) {
+        for (Integer i = 0; i != samples; ++i) {
+            assert_eq(
+                expected,
+                region.buffer[c][i],
+                DOUBLE_DELTA,
+                "%s, c=%d, i=%d",
+                message,
+                (int)c,
+                (int)i
+            );
+        }
+    }
+}
+
+
+TEST(on_demand_regions_are_committed_only_between_acquire_and_release, {
+    constexpr Integer capacity = 50000;
+    constexpr Integer used = 30000;
+
+    DelayBufferArena arena;
+    DelayBufferArena::Region* const region = arena.reserve(1, 1000);
+    DelayBufferArena::Region* const on_demand_region = arena.reserve(
+        2, capacity, true
+    );
+
+    region->use(1000);
+    on_demand_region->use(used);
+    arena.allocate();
+
+    assert_false(region->is_on_demand);
+    assert_true(on_demand_region->is_on_demand);
+
+    assert_true(region->acquire());
+    on_demand_region->clear();
+    assert_false(on_demand_region->acquire());
+
+    arena.update_regions();
+
+    assert_true(on_demand_region->acquire());
+    assert_region_samples(*on_demand_region, used, 0.0, "committed");
+
+    for (Integer c = 0; c != on_demand_region->channels; ++c) {
+        std::fill_n(on_demand_region->buffer[c], used, 1.0);
+    }
+
+    on_demand_region->release();
+    arena.update_regions();
+
+    assert_false(on_demand_region->acquire());
+
+    on_demand_region->use(capacity);
+    arena.update_regions();
+
+    assert_true(on_demand_region->acquire());
+    assert_region_samples(*on_demand_region, capacity, 0.0, "recommitted");
+
+    on_demand_region->release();
+    region->release();
+    arena.update_regions();
+
+    assert_true(region->acquire());
+})
+
+
+TEST(on_demand_regions_can_be_committed_on_the_calling_thread, {
+    constexpr Integer capacity = 5000;
+
+    DelayBufferArena arena;
+    DelayBufferArena::Region* const region = arena.reserve(2, capacity, true);
+
+    region->use(capacity);
+    arena.allocate();
+
+    region->commit_now();
+
+    assert_true(region->acquire());
+    assert_region_samples(*region, capacity, 0.0, "committed");
+})
+
+
+void render_and_compare(
+        SumOfSines& expected_input,
+        SumOfSines& actual_input,
+        SumOfSinesDelay& expected_delay,
+        SumOfSinesDelay& actual_delay,
+        Frequency const sample_rate
+) {
+    Buffer expected_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+    Buffer actual_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+
+    expected_input.set_sample_rate(sample_rate);
+    actual_input.set_sample_rate(sample_rate);
+    expected_delay.set_sample_rate(sample_rate);
+    actual_delay.set_sample_rate(sample_rate);
+
+    render_rounds<SumOfSinesDelay>(expected_delay, expected_output, ROUNDS);
+    render_rounds<SumOfSinesDelay>(actual_delay, actual_output, ROUNDS);
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            BLOCK_SIZE * ROUNDS,
+            DOUBLE_DELTA,
+            "sample_rate=%f, channel=%d",
+            sample_rate,
+            (int)c
+        );
+    }
+}
+
+
+TEST(delay_using_the_arena_renders_the_same_signal_as_with_heap_buffer, {
+    DelayBufferArena arena;
+    SumOfSines expected_input(0.5, 220.0, 0.3, 1760.0, 0.0, 0.0, CHANNELS);
+    SumOfSines actual_input(0.5, 220.0, 0.3, 1760.0, 0.0, 0.0, CHANNELS);
+    SumOfSinesDelay expected_delay(expected_input);
+    SumOfSinesDelay actual_delay(actual_input);
+    SumOfSinesDelay* const delays[] = {&expected_delay, &actual_delay};
+
+    expected_input.set_block_size(BLOCK_SIZE);
+    actual_input.set_block_size(BLOCK_SIZE);
+
+    for (SumOfSinesDelay* const delay : delays) {
+        delay->set_block_size(BLOCK_SIZE);
+        delay->gain.set_value(0.7);
+        delay->time.set_value(0.01);
+    }
+
+    actual_delay.use_delay_buffer_arena(arena);
+    arena.allocate();
+
+    Frequency const sample_rates[] = {
+        22050.0,
+        48000.0,
+
+        /* Above the limits of the arena, the delay falls back to the heap. */
+        DelayBufferArena::SAMPLE_RATE_MAX * 2.0,
+
+        44100.0,
+    };
+
+    for (Frequency const sample_rate : sample_rates) {
+        render_and_compare(
+            expected_input,
+            actual_input,
+            expected_delay,
+            actual_delay,
+            sample_rate
+        );
+    }
+})
@@ -24,6 +24,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -38,6 +39,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
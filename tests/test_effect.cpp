@@ -0,0 +1,444 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/chorus.cpp"
+#include "dsp/comb_filter_bank.cpp"
+#include "dsp/cpu.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/echo.cpp"
+#include "dsp/effect.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/gain.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/multi_tap_delay.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/peak_tracker.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/reverb.cpp"
+#include "dsp/side_chain_compressable_effect.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Frequency SAMPLE_RATE = 22050.0;
+constexpr Integer SLEEP_ROUND_MAX = 1000;
+constexpr Integer WAKE_UP_ROUNDS = 100;
+
+
+typedef Chorus<FixedSignalProducer> Chorus_;
+typedef Echo<FixedSignalProducer> Echo_;
+typedef Reverb<FixedSignalProducer> Reverb_;
+
+
+class HighShelfFilterSharedBuffers
+{
+    public:
+        HighShelfFilterSharedBuffers()
+        {
+            buffers.b0_buffer = new Number[BLOCK_SIZE];
+            buffers.b1_buffer = new Number[BLOCK_SIZE];
+            buffers.b2_buffer = new Number[BLOCK_SIZE];
+            buffers.a1_buffer = new Number[BLOCK_SIZE];
+            buffers.a2_buffer = new Number[BLOCK_SIZE];
+        }
+
+        ~HighShelfFilterSharedBuffers()
+        {
+            delete[] buffers.b0_buffer;
+            delete[] buffers.b1_buffer;
+            delete[] buffers.b2_buffer;
+            delete[] buffers.a1_buffer;
+            delete[] buffers.a2_buffer;
+        }
+
+        BiquadFilterSharedBuffers buffers;
+};
+
+
+class EchoTest : public HighShelfFilterSharedBuffers
+{
+    public:
+        typedef Echo_ EffectClass;
+
+        static constexpr Seconds TAIL_LENGTH = 0.05 * 26.0;
+
+        EchoTest(FixedSignalProducer& input)
+            : effect("E", input, buffers)
+        {
+            effect.delay_time.set_value(0.05);
+            effect.feedback.set_value(0.5);
+            effect.width.set_value(0.3);
+        }
+
+        Echo_ effect;
+};
+
+
+class ReverbTest : public HighShelfFilterSharedBuffers
+{
+    public:
+        typedef Reverb_ EffectClass;
+
+        static constexpr Seconds TAIL_LENGTH = 1617.0 / 44100.0 * 0.3 * 26.0;
+
+        ReverbTest(FixedSignalProducer& input)
+            : effect("R", input, buffers)
+        {
+            effect.room_size.set_value(0.3);
+            effect.room_reflectivity.set_value(0.5);
+            effect.width.set_value(0.3);
+        }
+
+        Reverb_ effect;
+};
+
+
+template<class EffectTestClass>
+Integer render_until_asleep(
+        EffectTestClass& effect_test,
+        FixedSignalProducer& input,
+        Sample const* const* const impulse_channels,
+        Sample const* const* const silent_channels,
+        Integer const first_round
+) {
+    typedef typename EffectTestClass::EffectClass EffectClass;
+
+    input.set_fixed_samples(impulse_channels);
+
+    for (Integer round = first_round; round != SLEEP_ROUND_MAX; ++round) {
+        Sample const* const* const input_block = (
+            SignalProducer::produce<FixedSignalProducer>(
+                input, round, BLOCK_SIZE
+            )
+        );
+        Sample const* const* const output_block = (
+            SignalProducer::produce<EffectClass>(
+                effect_test.effect, round, BLOCK_SIZE
+            )
+        );
+
+        if (output_block == input_block) {
+            return round;
+        }
+
+        input.set_fixed_samples(silent_channels);
+    }
+
+    return SLEEP_ROUND_MAX;
+}
+
+
+template<class EffectTestClass>
+void test_sleeping_and_waking_up()
+{
+    typedef typename EffectTestClass::EffectClass EffectClass;
+
+    Sample impulse[CHANNELS][BLOCK_SIZE] = {};
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const impulse_channels[] = {impulse[0], impulse[1]};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(silent_channels);
+    FixedSignalProducer reference_input(impulse_channels);
+    EffectTestClass effect_test(input);
+    EffectTestClass reference_effect_test(reference_input);
+    EffectClass* const effects[] = {
+        &effect_test.effect, &reference_effect_test.effect
+    };
+    Buffer expected_output(BLOCK_SIZE * WAKE_UP_ROUNDS, CHANNELS);
+    Buffer actual_output(BLOCK_SIZE * WAKE_UP_ROUNDS, CHANNELS);
+
+    impulse[0][3] = 0.9;
+    impulse[1][5] = -0.7;
+
+    for (EffectClass* const effect : effects) {
+        effect->set_sample_rate(SAMPLE_RATE);
+        effect->set_block_size(BLOCK_SIZE);
+        effect->dry.set_value(0.0);
+        effect->wet.set_value(1.0);
+    }
+
+    Integer const sleep_round = render_until_asleep<EffectTestClass>(
+        effect_test, input, impulse_channels, silent_channels, 1
+    );
+
+    assert_lt((int)sleep_round, (int)SLEEP_ROUND_MAX);
+    assert_gt(
+        (Number)(sleep_round * BLOCK_SIZE),
+        EffectTestClass::TAIL_LENGTH * SAMPLE_RATE
+    );
+
+    Integer const wake_up_round = sleep_round + 10;
+
+    for (Integer round = sleep_round + 1; round != wake_up_round; ++round) {
+        SignalProducer::produce<EffectClass>(
+            effect_test.effect, round, BLOCK_SIZE
+        );
+    }
+
+    expected_output.reset();
+    actual_output.reset();
+
+    input.set_fixed_samples(impulse_channels);
+
+    for (Integer i = 0; i != WAKE_UP_ROUNDS; ++i) {
+        actual_output.append(
+            SignalProducer::produce<EffectClass>(
+                effect_test.effect, wake_up_round + i, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+        expected_output.append(
+            SignalProducer::produce<EffectClass>(
+                reference_effect_test.effect, i + 1, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+
+        input.set_fixed_samples(silent_channels);
+        reference_input.set_fixed_samples(silent_channels);
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            BLOCK_SIZE * WAKE_UP_ROUNDS,
+            0.000001,
+            "channel=%d",
+            (int)c
+        );
+    }
+
+    Integer const second_sleep_round = render_until_asleep<EffectTestClass>(
+        effect_test,
+        input,
+        silent_channels,
+        silent_channels,
+        wake_up_round + WAKE_UP_ROUNDS
+    );
+
+    assert_lt((int)second_sleep_round, (int)SLEEP_ROUND_MAX);
+    assert_gt(
+        (Number)((second_sleep_round - wake_up_round) * BLOCK_SIZE),
+        EffectTestClass::TAIL_LENGTH * SAMPLE_RATE
+    );
+}
+
+
+TEST(echo_falls_asleep_after_its_tail_and_wakes_up_when_input_returns, {
+    test_sleeping_and_waking_up<EchoTest>();
+})
+
+
+TEST(reverb_falls_asleep_after_its_tail_and_wakes_up_when_input_returns, {
+    test_sleeping_and_waking_up<ReverbTest>();
+})
+
+
+TEST(when_the_tail_is_long_then_the_effect_stays_awake, {
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(silent_channels);
+    EchoTest echo_test(input);
+
+    echo_test.effect.set_sample_rate(SAMPLE_RATE);
+    echo_test.effect.set_block_size(BLOCK_SIZE);
+    echo_test.effect.wet.set_value(1.0);
+    echo_test.effect.delay_time.set_value(Constants::DELAY_TIME_MAX);
+    echo_test.effect.feedback.set_value(Constants::DELAY_FEEDBACK_MAX);
+
+    assert_eq(
+        (int)SLEEP_ROUND_MAX,
+        (int)render_until_asleep<EchoTest>(
+            echo_test, input, silent_channels, silent_channels, 1
+        )
+    );
+})
+
+
+template<class EffectClass>
+class InsomniacEffect : public EffectClass
+{
+    public:
+        using EffectClass::EffectClass;
+
+    protected:
+        virtual Seconds get_tail_length() const noexcept override
+        {
+            return EffectClass::TAIL_LENGTH_INFINITE;
+        }
+};
+
+
+template<class EffectClass>
+void test_waking_up_is_seamless(
+        FixedSignalProducer& input,
+        EffectClass& effect,
+        EffectClass& reference_effect
+) {
+    Sample impulse[CHANNELS][BLOCK_SIZE] = {};
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const impulse_channels[] = {impulse[0], impulse[1]};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    EffectClass* const effects[] = {&effect, &reference_effect};
+    Buffer expected_output(BLOCK_SIZE * WAKE_UP_ROUNDS, CHANNELS);
+    Buffer actual_output(BLOCK_SIZE * WAKE_UP_ROUNDS, CHANNELS);
+    Integer round = 1;
+    Integer asleep_rounds = 0;
+
+    impulse[0][3] = 0.9;
+    impulse[1][5] = -0.7;
+
+    for (EffectClass* const effect : effects) {
+        effect->set_sample_rate(SAMPLE_RATE);
+        effect->set_block_size(BLOCK_SIZE);
+        effect->dry.set_value(0.0);
+        effect->wet.set_value(1.0);
+    }
+
+    input.set_fixed_samples(impulse_channels);
+
+    for (; round != SLEEP_ROUND_MAX && asleep_rounds != 10; ++round) {
+        Sample const* const* const input_block = (
+            SignalProducer::produce<FixedSignalProducer>(
+                input, round, BLOCK_SIZE
+            )
+        );
+
+        Sample const* const* const output_block = (
+            SignalProducer::produce<EffectClass>(effect, round, BLOCK_SIZE)
+        );
+        Sample const* const* const reference_output_block = (
+            SignalProducer::produce<EffectClass>(
+                reference_effect, round, BLOCK_SIZE
+            )
+        );
+
+        if (output_block == input_block) {
+            ++asleep_rounds;
+        }
+
+        assert_neq((void*)input_block, (void*)reference_output_block);
+
+        input.set_fixed_samples(silent_channels);
+    }
+
+    assert_eq(10, (int)asleep_rounds);
+
+    input.set_fixed_samples(impulse_channels);
+
+    for (Integer i = 0; i != WAKE_UP_ROUNDS; ++i, ++round) {
+        actual_output.append(
+            SignalProducer::produce<EffectClass>(effect, round, BLOCK_SIZE),
+            BLOCK_SIZE
+        );
+        expected_output.append(
+            SignalProducer::produce<EffectClass>(
+                reference_effect, round, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+
+        input.set_fixed_samples(silent_channels);
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            BLOCK_SIZE * WAKE_UP_ROUNDS,
+            0.000001,
+            "channel=%d",
+            (int)c
+        );
+    }
+}
+
+
+void set_up_chorus_wake_up_test(Chorus_& chorus)
+{
+    chorus.delay_time.set_value(0.01);
+    chorus.frequency.set_value(3.0);
+    chorus.depth.set_value(0.8);
+    chorus.feedback.set_value(0.3);
+}
+
+
+TEST(chorus_lfos_keep_running_while_the_effect_is_asleep, {
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(silent_channels);
+    Chorus_ chorus("C", input);
+    InsomniacEffect<Chorus_> reference_chorus("C", input);
+
+    set_up_chorus_wake_up_test(chorus);
+    set_up_chorus_wake_up_test(reference_chorus);
+
+    test_waking_up_is_seamless<Chorus_>(input, chorus, reference_chorus);
+})
+
+
+void set_up_compressor_wake_up_test(Echo_& echo)
+{
+    echo.delay_time.set_value(0.05);
+    echo.feedback.set_value(0.5);
+    echo.width.set_value(0.3);
+    echo.side_chain_compression_threshold.set_value(-30.0);
+    echo.side_chain_compression_attack_time.set_value(0.5);
+    echo.side_chain_compression_release_time.set_value(3.0);
+    echo.side_chain_compression_ratio.set_value(10.0);
+}
+
+
+TEST(side_chain_compression_keeps_running_while_the_effect_is_asleep, {
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(silent_channels);
+    HighShelfFilterSharedBuffers buffers;
+    HighShelfFilterSharedBuffers reference_buffers;
+    Echo_ echo("E", input, buffers.buffers);
+    InsomniacEffect<Echo_> reference_echo(
+        "E", input, reference_buffers.buffers
+    );
+
+    set_up_compressor_wake_up_test(echo);
+    set_up_compressor_wake_up_test(reference_echo);
+
+    test_waking_up_is_seamless<Echo_>(input, echo, reference_echo);
+})
@@ -30,6 +30,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
@@ -42,6 +43,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -21,6 +21,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
 #include "dsp/gain.cpp"
@@ -35,6 +36,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
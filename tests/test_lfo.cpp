@@ -26,6 +26,7 @@ f* Copyright (C) 2023, 2024, 2026  Attila M. Magyar
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
@@ -38,6 +39,8 @@ f* Copyright (C) 2023, 2024, 2026  Attila M. Magyar
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -148,6 +151,7 @@ void test_pulse_lfo(
     lfo.set_sample_rate(sample_rate);
     lfo.set_bpm(120);
     lfo.waveform.set_value(waveform);
+    lfo.waveform.prepare_wavetable(lfo.waveform.get_ratio());
     lfo.pulse_width.set_value(pulse_width - 0.000001);
     lfo.pulse_width.schedule_value(0.2, pulse_width);
     lfo.frequency.set_value(frequency);
@@ -385,6 +389,7 @@ void test_lfo_modifier_statistics(
     lfo.set_block_size(BLOCK_SIZE);
     lfo.set_sample_rate(SAMPLE_RATE);
     lfo.waveform.set_value(LFO::Oscillator_::TRIANGLE);
+    lfo.waveform.prepare_wavetable(lfo.waveform.get_ratio());
     lfo.min.set_value(0.25);
     lfo.max.set_value(0.75);
     lfo.distortion.set_value(distortion);
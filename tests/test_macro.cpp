@@ -24,6 +24,7 @@
 #include "js80p.hpp"
 #include "midi.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
@@ -36,6 +37,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -294,3 +297,57 @@ TEST(macro_can_modify_midi_controller_channels_independently_from_each_other, {
         DOUBLE_DELTA
     );
 })
+
+
+TEST(macro_can_list_the_macros_which_control_its_params, {
+    Macro macro_1;
+    Macro macro_2;
+    Macro macro_3;
+    MidiController midi_controller;
+    Macro* dependencies[Macro::PARAMS];
+
+    assert_eq((int)0, (int)macro_3.get_dependencies(dependencies));
+
+    macro_3.input.set_macro(&macro_1);
+    macro_3.min.set_midi_controller(&midi_controller);
+    macro_3.scale.set_macro(&macro_2);
+
+    assert_eq((int)2, (int)macro_3.get_dependencies(dependencies));
+    assert_eq((void*)&macro_1, (void*)dependencies[0]);
+    assert_eq((void*)&macro_2, (void*)dependencies[1]);
+})
+
+
+TEST(locked_macro_is_not_recalculated_on_the_locked_channel_until_unlocked, {
+    constexpr Midi::Channel channel_1 = 1;
+    constexpr Midi::Channel channel_2 = 2;
+
+    Macro macro;
+    MidiController midi_controller;
+
+    macro.input.set_midi_controller(&midi_controller);
+
+    midi_controller.change(channel_1, 0.0, 0.2);
+    midi_controller.change(channel_2, 0.0, 0.2);
+    macro.update_and_lock(channel_1);
+
+    assert_eq(0.2, macro.get_value(channel_1), DOUBLE_DELTA);
+
+    midi_controller.change(channel_1, 0.0, 0.4);
+    midi_controller.change(channel_2, 0.0, 0.6);
+    macro.update(channel_1);
+    macro.update(channel_2);
+
+    assert_eq(0.2, macro.get_value(channel_1), DOUBLE_DELTA);
+    assert_eq(0.6, macro.get_value(channel_2), DOUBLE_DELTA);
+
+    macro.unlock();
+    macro.update(channel_1);
+
+    assert_eq(0.4, macro.get_value(channel_1), DOUBLE_DELTA);
+
+    midi_controller.change(channel_1, 0.0, 0.8);
+    macro.update_and_lock(channel_1);
+
+    assert_eq(0.8, macro.get_value(channel_1), DOUBLE_DELTA);
+})
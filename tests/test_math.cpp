@@ -653,6 +653,47 @@ TEST(rng_can_generate_normally_distributed_random_numbers_within_bounds, {
 })
 
 
+TEST(counter_based_rng_streams_are_uniformly_distributed_and_independent, {
+    constexpr Integer probes = 10000;
+    std::vector<Number> numbers(probes);
+    Math::RNG rng(0x2345);
+    Math::CounterBasedRNG stream_1(rng.make_stream_seed());
+    Math::CounterBasedRNG stream_2(rng.make_stream_seed());
+    Math::Statistics statistics;
+    Number first_numbers[3];
+    Integer same_numbers = 0;
+
+    for (Integer i = 0; i != probes; ++i) {
+        Number const number = stream_1.random();
+
+        numbers[i] = number;
+        assert_gte(number, 0.0);
+        assert_lt(number, 1.0);
+
+        if (number == stream_2.random()) {
+            ++same_numbers;
+        }
+
+        if (i < 3) {
+            first_numbers[i] = number;
+        }
+    }
+
+    assert_eq(0, (int)same_numbers);
+
+    Math::compute_statistics(numbers, statistics);
+    assert_statistics(
+        true, 0.0, 0.5, 1.0, 0.5, std::sqrt(1.0 / 12.0), statistics, 0.015
+    );
+
+    stream_1.reset();
+
+    for (Integer i = 0; i != 3; ++i) {
+        assert_eq(first_numbers[i], stream_1.random(), 0.0);
+    }
+})
+
+
 TEST(randomize, {
     constexpr Integer last_probe = 500;
     std::vector<Number> numbers(last_probe + 1);
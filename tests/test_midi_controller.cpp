@@ -71,6 +71,37 @@ TEST(midi_controller_stores_midi_control_change_events, {
 })
 
 
+TEST(when_too_many_changes_arrive_in_a_round_then_the_last_one_wins, {
+    constexpr Midi::Channel channel = 3;
+    constexpr Integer capacity = MidiController::EVENTS_PER_CHANNEL;
+    MidiController midi_ctl;
+
+    for (Integer i = 0; i != capacity + 5; ++i) {
+        midi_ctl.change(channel, (Seconds)i * 0.001, (Number)i / 100.0);
+    }
+
+    assert_eq((int)capacity, (int)midi_ctl.event_queues[channel].length());
+    assert_eq(
+        0.0, midi_ctl.event_queues[channel][0].number_param_1, DOUBLE_DELTA
+    );
+    assert_eq(
+        (Number)(capacity + 4) / 100.0,
+        midi_ctl.event_queues[channel].back().number_param_1,
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        (Seconds)(capacity + 4) * 0.001,
+        midi_ctl.event_queues[channel].back().time_offset,
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        (Number)(capacity + 4) / 100.0,
+        midi_ctl.get_value(channel),
+        DOUBLE_DELTA
+    );
+})
+
+
 TEST(channels_are_independent_from_each_other, {
     constexpr Midi::Channel channel_1 = 1;
     constexpr Midi::Channel channel_2 = 5;
@@ -0,0 +1,276 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
+#include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/gain.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/mixer.cpp"
+#include "dsp/multi_tap_delay.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer CHANNELS = 2;
+constexpr Integer TAPS = 4;
+constexpr Integer BLOCK_SIZE = 128;
+constexpr Integer ROUNDS = 80;
+constexpr Frequency SAMPLE_RATE = 22050.0;
+constexpr Seconds TIME_MAX = 0.1;
+constexpr Number BPM = 120.0;
+
+
+typedef StereoPannedDelay<SumOfSines> Voice;
+typedef Mixer<Voice> Voices;
+typedef Gain<Voices> VoicesFeedback;
+
+typedef MultiTapDelay<SumOfSines, TAPS> SumOfSinesMultiTapDelay;
+typedef Gain<SumOfSinesMultiTapDelay> SumOfSinesMultiTapDelayFeedback;
+
+typedef MultiTapDelay<FixedSignalProducer, TAPS> FixedMultiTapDelay;
+typedef Gain<FixedMultiTapDelay> FixedMultiTapDelayFeedback;
+
+
+class Tuning
+{
+    public:
+        Seconds const delay_time;
+        Number const weight;
+        Number const panning_scale;
+};
+
+
+constexpr Tuning TUNINGS[TAPS] = {
+    {0.011, 1.00, 1.0},
+    {0.017, 0.70, -0.6},
+    {0.000, 0.00, 1.0},
+    {0.023, 0.90, 0.4},
+};
+
+
+void test_multi_tap_delay(bool const is_automated, Byte const tempo_sync_value)
+{
+    SumOfSines input(0.3, 220.0, 0.2, 1760.0, 0.1, 5000.0, CHANNELS);
+    FloatParamS panning("W", -1.0, 1.0, 0.3);
+    FloatParamS feedback("FB", 0.0, 0.95, 0.6);
+    ToggleParam tempo_sync("SYN", tempo_sync_value);
+    FloatParamS times[TAPS] = {
+        FloatParamS("T1", 0.0, TIME_MAX, TUNINGS[0].delay_time),
+        FloatParamS("T2", 0.0, TIME_MAX, TUNINGS[1].delay_time),
+        FloatParamS("T3", 0.0, TIME_MAX, TUNINGS[2].delay_time),
+        FloatParamS("T4", 0.0, TIME_MAX, TUNINGS[3].delay_time),
+    };
+    Voice* voices[TAPS];
+    Voices mixer(CHANNELS);
+    VoicesFeedback expected_feedback(mixer, feedback, NULL, CHANNELS);
+    SumOfSinesMultiTapDelay multi_tap_delay(input, panning, times, &tempo_sync);
+    SumOfSinesMultiTapDelayFeedback actual_feedback(
+        multi_tap_delay, feedback, NULL, CHANNELS
+    );
+    Buffer expected_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+    Buffer actual_output(BLOCK_SIZE * ROUNDS, CHANNELS);
+
+    input.set_sample_rate(SAMPLE_RATE);
+    input.set_block_size(BLOCK_SIZE);
+    panning.set_sample_rate(SAMPLE_RATE);
+    panning.set_block_size(BLOCK_SIZE);
+    feedback.set_sample_rate(SAMPLE_RATE);
+    feedback.set_block_size(BLOCK_SIZE);
+
+    for (Integer t = 0; t != TAPS; ++t) {
+        Tuning const& tuning = TUNINGS[t];
+
+        times[t].set_sample_rate(SAMPLE_RATE);
+        times[t].set_block_size(BLOCK_SIZE);
+
+        voices[t] = new Voice(
+            input,
+            StereoPannedDelayMode::NORMAL,
+            panning,
+            times[t],
+            &tempo_sync
+        );
+        voices[t]->delay.set_feedback_signal_producer(expected_feedback);
+
+        if (t > 0) {
+            voices[t]->delay.use_shared_delay_buffer(voices[0]->delay);
+        }
+
+        voices[t]->set_sample_rate(SAMPLE_RATE);
+        voices[t]->set_block_size(BLOCK_SIZE);
+        voices[t]->set_bpm(BPM);
+        voices[t]->set_panning_scale(tuning.panning_scale);
+
+        mixer.add(*voices[t]);
+        mixer.set_weight((size_t)t, tuning.weight);
+
+        multi_tap_delay.set_tap(t, tuning.panning_scale, tuning.weight);
+    }
+
+    mixer.set_sample_rate(SAMPLE_RATE);
+    mixer.set_block_size(BLOCK_SIZE);
+    expected_feedback.set_sample_rate(SAMPLE_RATE);
+    expected_feedback.set_block_size(BLOCK_SIZE);
+
+    multi_tap_delay.set_feedback_signal_producer(actual_feedback);
+    multi_tap_delay.set_sample_rate(SAMPLE_RATE);
+    multi_tap_delay.set_block_size(BLOCK_SIZE);
+    multi_tap_delay.set_bpm(BPM);
+    actual_feedback.set_sample_rate(SAMPLE_RATE);
+    actual_feedback.set_block_size(BLOCK_SIZE);
+
+    if (is_automated) {
+        panning.schedule_linear_ramp(0.3, -0.7);
+        times[0].schedule_linear_ramp(0.2, 0.05);
+        times[1].schedule_linear_ramp(0.25, 0.002);
+        times[3].schedule_linear_ramp(0.15, 0.09);
+        feedback.schedule_linear_ramp(0.35, 0.3);
+    }
+
+    expected_output.reset();
+    actual_output.reset();
+
+    for (Integer round = 1; round != ROUNDS + 1; ++round) {
+        expected_output.append(
+            SignalProducer::produce<Voices>(mixer, round, BLOCK_SIZE),
+            BLOCK_SIZE
+        );
+        SignalProducer::produce<VoicesFeedback>(
+            expected_feedback, round, BLOCK_SIZE
+        );
+
+        actual_output.append(
+            SignalProducer::produce<SumOfSinesMultiTapDelay>(
+                multi_tap_delay, round, BLOCK_SIZE
+            ),
+            BLOCK_SIZE
+        );
+        SignalProducer::produce<SumOfSinesMultiTapDelayFeedback>(
+            actual_feedback, round, BLOCK_SIZE
+        );
+    }
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        assert_eq(
+            expected_output.samples[c],
+            actual_output.samples[c],
+            BLOCK_SIZE * ROUNDS,
+            0.000001,
+            "channel=%d",
+            (int)c
+        );
+    }
+
+    for (Integer t = 0; t != TAPS; ++t) {
+        delete voices[t];
+    }
+}
+
+
+TEST(renders_the_same_signal_as_stereo_panned_delays_sharing_a_buffer, {
+    test_multi_tap_delay(false, ToggleParam::OFF);
+    test_multi_tap_delay(false, ToggleParam::ON);
+})
+
+
+TEST(renders_the_same_signal_as_stereo_panned_delays_with_automation, {
+    test_multi_tap_delay(true, ToggleParam::OFF);
+    test_multi_tap_delay(true, ToggleParam::ON);
+})
+
+
+TEST(when_input_becomes_silent_then_falls_silent_after_the_tail, {
+    constexpr Integer rounds = 300;
+
+    Sample impulse[CHANNELS][BLOCK_SIZE] = {};
+    Sample const silence[CHANNELS][BLOCK_SIZE] = {};
+    Sample const* const impulse_channels[] = {impulse[0], impulse[1]};
+    Sample const* const silent_channels[] = {silence[0], silence[1]};
+    FixedSignalProducer input(impulse_channels);
+    FloatParamS panning("W", -1.0, 1.0, 0.0);
+    FloatParamS feedback("FB", 0.0, 0.95, 0.5);
+    FloatParamS times[TAPS] = {
+        FloatParamS("T1", 0.0, TIME_MAX, 0.01),
+        FloatParamS("T2", 0.0, TIME_MAX, 0.02),
+        FloatParamS("T3", 0.0, TIME_MAX, 0.03),
+        FloatParamS("T4", 0.0, TIME_MAX, 0.04),
+    };
+    FixedMultiTapDelay multi_tap_delay(input, panning, times);
+    FixedMultiTapDelayFeedback multi_tap_delay_feedback(
+        multi_tap_delay, feedback, NULL, CHANNELS
+    );
+    Sample peak = 0.0;
+
+    impulse[0][0] = 1.0;
+    impulse[1][0] = 1.0;
+
+    multi_tap_delay.set_feedback_signal_producer(multi_tap_delay_feedback);
+    multi_tap_delay.set_sample_rate(SAMPLE_RATE);
+    multi_tap_delay.set_block_size(BLOCK_SIZE);
+    multi_tap_delay_feedback.set_sample_rate(SAMPLE_RATE);
+    multi_tap_delay_feedback.set_block_size(BLOCK_SIZE);
+
+    for (Integer t = 0; t != TAPS; ++t) {
+        multi_tap_delay.set_tap(t, 1.0, 0.25);
+    }
+
+    for (Integer round = 1; round != rounds + 1; ++round) {
+        Sample const* const* const block = (
+            SignalProducer::produce<FixedMultiTapDelay>(
+                multi_tap_delay, round, BLOCK_SIZE
+            )
+        );
+
+        for (Integer c = 0; c != CHANNELS; ++c) {
+            for (Integer i = 0; i != BLOCK_SIZE; ++i) {
+                peak = std::max(peak, std::fabs(block[c][i]));
+            }
+        }
+
+        SignalProducer::produce<FixedMultiTapDelayFeedback>(
+            multi_tap_delay_feedback, round, BLOCK_SIZE
+        );
+
+        input.set_fixed_samples(silent_channels);
+    }
+
+    assert_gt(peak, 0.1);
+    assert_true(multi_tap_delay.is_silent(rounds, BLOCK_SIZE));
+})
@@ -24,6 +24,7 @@
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
 #include "dsp/lfo.cpp"
@@ -38,6 +39,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -393,3 +396,81 @@ TEST(when_noise_level_is_zero_then_handles_events_and_returns_the_input_as_is, {
         input_channel_2, rendered[1], block_size, DOUBLE_DELTA, "round=5"
     );
 })
+
+
+TEST(output_of_noise_generator_does_not_depend_on_other_noise_generators, {
+    constexpr Integer block_size = 128;
+    constexpr Integer rounds = 5;
+
+    Sample input_channel_1[block_size];
+    Sample input_channel_2[block_size];
+    Sample* const input_channels[FixedSignalProducer::CHANNELS] = {
+        input_channel_1, input_channel_2
+    };
+    FixedSignalProducer input(input_channels);
+    Math::RNG rng_1(123);
+    Math::RNG rng_2(123);
+    FloatParamB level("L", 0.0, 1.0, 0.5);
+    NoiseGenerator<FixedSignalProducer> noise_generator_1(
+        input, level, 0.001, SAMPLE_RATE, rng_1
+    );
+    NoiseGenerator<FixedSignalProducer> noise_generator_1_other(
+        input, level, 0.001, SAMPLE_RATE, rng_1
+    );
+    NoiseGenerator<FixedSignalProducer> noise_generator_2(
+        input, level, 0.001, SAMPLE_RATE, rng_2
+    );
+    NoiseGenerator<FixedSignalProducer>* const noise_generators[3] = {
+        &noise_generator_1, &noise_generator_1_other, &noise_generator_2
+    };
+
+    std::fill_n(input_channel_1, block_size, 0.0);
+    std::fill_n(input_channel_2, block_size, 0.0);
+
+    level.set_sample_rate(SAMPLE_RATE);
+    level.set_block_size(block_size);
+
+    for (Integer i = 0; i != 3; ++i) {
+        noise_generators[i]->set_sample_rate(SAMPLE_RATE);
+        noise_generators[i]->set_block_size(block_size);
+        noise_generators[i]->start(0.0);
+    }
+
+    for (Integer round = 0; round != rounds; ++round) {
+        Sample const* const* const rendered_1_other = (
+            SignalProducer::produce< NoiseGenerator<FixedSignalProducer> >(
+                noise_generator_1_other, round, block_size
+            )
+        );
+        Sample const* const* const rendered_1 = (
+            SignalProducer::produce< NoiseGenerator<FixedSignalProducer> >(
+                noise_generator_1, round, block_size
+            )
+        );
+        Sample const* const* const rendered_2 = (
+            SignalProducer::produce< NoiseGenerator<FixedSignalProducer> >(
+                noise_generator_2, round, block_size
+            )
+        );
+
+        for (Integer c = 0; c != FixedSignalProducer::CHANNELS; ++c) {
+            assert_eq(
+                rendered_2[c],
+                rendered_1[c],
+                block_size,
+                0.0,
+                "round=%d, channel=%d",
+                (int)round,
+                (int)c
+            );
+            assert_neq(
+                rendered_1[c][block_size / 2],
+                rendered_1_other[c][block_size / 2],
+                0.0,
+                "round=%d, channel=%d",
+                (int)round,
+                (int)c
+            );
+        }
+    }
+})
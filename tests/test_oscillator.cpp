@@ -16,13 +16,16 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
 #include <cmath>
+#include <thread>
 
 #include "test.cpp"
 #include "utils.cpp"
 
 #include "js80p.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
@@ -35,6 +38,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -280,6 +285,7 @@ void assert_oscillator_output_is_close_to_reference(
     Buffer expected_samples(sample_count);
     Buffer rendered_samples(sample_count);
 
+    oscillator.waveform.prepare_wavetable(oscillator.waveform.get_ratio());
     oscillator.start(0.0);
 
     for (Integer i = 0; i != sample_count; ++i) {
@@ -360,6 +366,69 @@ TEST(basic_waveforms, {
 })
 
 
+Wavetable const* wait_for_wavetable(
+        StandardWaveforms& standard_waveforms,
+        Integer const waveform
+) {
+    Wavetable const* wavetable = standard_waveforms.get_wavetable(waveform);
+
+    for (int i = 0; wavetable == NULL && i != 1000; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        wavetable = standard_waveforms.get_wavetable(waveform);
+    }
+
+    return wavetable;
+}
+
+
+TEST(standard_waveforms_are_built_in_the_background_when_requested, {
+    StandardWaveforms standard_waveforms("");
+
+    assert_false(
+        standard_waveforms.get_wavetable(StandardWaveforms::SINE) == NULL
+    );
+    assert_true(
+        standard_waveforms.get_wavetable(StandardWaveforms::SAWTOOTH) == NULL
+    );
+    assert_true(
+        standard_waveforms.get_wavetable(StandardWaveforms::SAWTOOTH) == NULL
+    );
+
+    standard_waveforms.start_building_in_background();
+
+    Wavetable const* const sawtooth = wait_for_wavetable(
+        standard_waveforms, StandardWaveforms::SAWTOOTH
+    );
+    Wavetable const* const square = wait_for_wavetable(
+        standard_waveforms, StandardWaveforms::SQUARE
+    );
+
+    standard_waveforms.stop_building_in_background();
+
+    assert_false(sawtooth == NULL);
+    assert_false(square == NULL);
+    assert_true(
+        square == standard_waveforms.get_wavetable(StandardWaveforms::SQUARE)
+    );
+})
+
+
+TEST(prepared_standard_waveforms_do_not_wait_for_the_builder, {
+    StandardWaveforms standard_waveforms("");
+
+    standard_waveforms.start_building_in_background();
+    standard_waveforms.prepare_wavetable(StandardWaveforms::TRIANGLE);
+
+    Wavetable const* const triangle = (
+        standard_waveforms.get_wavetable(StandardWaveforms::TRIANGLE)
+    );
+
+    standard_waveforms.stop_building_in_background();
+
+    assert_false(triangle == NULL);
+})
+
+
 TEST(low_frequency_oscillator_applies_dc_offset_to_oscillate_between_0_and_2, {
     constexpr Frequency frequency = 100.0;
     constexpr Integer block_size = 128;
@@ -424,15 +493,7 @@ TEST(custom_waveform_is_updated_before_each_rendering_round, {
     FloatParamB harmonic_8("", -1.0, 1.0, 0.0);
     FloatParamB harmonic_rest("", -1.0, 1.0, 0.0);
 
-    SimpleOscillator::WaveformParam waveform_param("");
-    SimpleOscillator oscillator(
-        waveform_param,
-        pulse_width,
-        amplitude,
-        dummy_float_param,
-        dummy_float_param,
-        dummy_float_param,
-        dummy_toggle_param,
+    CustomWaveform custom_waveform(
         harmonic_0,
         harmonic_1,
         harmonic_rest,
@@ -442,7 +503,19 @@ TEST(custom_waveform_is_updated_before_each_rendering_round, {
         harmonic_rest,
         harmonic_rest,
         harmonic_8,
-        harmonic_rest,
+        harmonic_rest
+    );
+
+    SimpleOscillator::WaveformParam waveform_param("");
+    SimpleOscillator oscillator(
+        waveform_param,
+        pulse_width,
+        amplitude,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_toggle_param,
+        custom_waveform,
         voice_status
     );
 
@@ -517,6 +590,120 @@ TEST(custom_waveform_is_updated_before_each_rendering_round, {
 });
 
 
+TEST(oscillators_which_share_a_custom_waveform_render_the_same_harmonics, {
+    constexpr Frequency sample_rate = 22050.0;
+    constexpr Integer block_size = 2048;
+
+    Byte const voice_status = Constants::VOICE_STATUS_NORMAL;
+
+    SumOfSines expected(
+        0.5, 440.0,
+        0.25, 440.0 * 2.0,
+        0.0, 440.0 * 9.0,
+        1,
+        0.0
+    );
+
+    FloatParamS pulse_width("", 0.0, 1.0, 0.5);
+    FloatParamS amplitude("", 0.0, 1.0, 1.0);
+    FloatParamS dummy_float_param("", 0.0, 1.0, 0.0);
+    ToggleParam dummy_toggle_param("", ToggleParam::OFF);
+    FloatParamB harmonic_0("", -1.0, 1.0, 0.5);
+    FloatParamB harmonic_1("", -1.0, 1.0, 0.25);
+    FloatParamB harmonic_rest("", -1.0, 1.0, 0.0);
+
+    CustomWaveform custom_waveform(
+        harmonic_0,
+        harmonic_1,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest
+    );
+
+    SimpleOscillator::WaveformParam waveform_param("");
+    SimpleOscillator oscillator_1(
+        waveform_param,
+        pulse_width,
+        amplitude,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_toggle_param,
+        custom_waveform,
+        voice_status
+    );
+    SimpleOscillator oscillator_2(
+        waveform_param,
+        pulse_width,
+        amplitude,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_toggle_param,
+        custom_waveform,
+        voice_status
+    );
+
+    Buffer output_1(block_size);
+    Buffer output_2(block_size);
+    Buffer expected_output(block_size);
+
+    amplitude.set_sample_rate(sample_rate);
+    amplitude.set_block_size(block_size);
+
+    dummy_float_param.set_sample_rate(sample_rate);
+    dummy_float_param.set_block_size(block_size);
+
+    harmonic_0.set_sample_rate(sample_rate);
+    harmonic_0.set_block_size(block_size);
+
+    harmonic_1.set_sample_rate(sample_rate);
+    harmonic_1.set_block_size(block_size);
+
+    harmonic_rest.set_sample_rate(sample_rate);
+    harmonic_rest.set_block_size(block_size);
+
+    expected.set_sample_rate(sample_rate);
+    expected.set_block_size(block_size);
+
+    waveform_param.set_sample_rate(sample_rate);
+    waveform_param.set_block_size(block_size);
+
+    oscillator_1.set_block_size(block_size);
+    oscillator_1.set_sample_rate(sample_rate);
+
+    oscillator_2.set_block_size(block_size);
+    oscillator_2.set_sample_rate(sample_rate);
+
+    waveform_param.set_value(SimpleOscillator::CUSTOM);
+
+    oscillator_1.frequency.set_value(440.0);
+    oscillator_2.frequency.set_value(440.0);
+    oscillator_1.start(0.0);
+    oscillator_2.start(0.0);
+
+    render_rounds<SimpleOscillator>(
+        oscillator_1, output_1, 1, block_size, 1
+    );
+    render_rounds<SimpleOscillator>(
+        oscillator_2, output_2, 1, block_size, 1
+    );
+    render_rounds<SumOfSines>(expected, expected_output, 1, block_size, 1);
+
+    assert_close(
+        expected_output.samples[0], output_1.samples[0], block_size, 0.01
+    );
+    assert_close(
+        expected_output.samples[0], output_2.samples[0], block_size, 0.01
+    );
+});
+
+
 TEST(sine_chirp_from_100hz_to_400hz, {
     constexpr Frequency start_frequency = 100.0;
     constexpr Frequency end_frequency = 400.0;
@@ -1060,6 +1247,19 @@ TEST(when_freq_is_changed_but_harmonics_stay_below_nyquist_then_they_are_kept, {
     FloatParamB harmonic_9("", -1.0, 1.0, 1.0);
     FloatParamB harmonic_rest("", -1.0, 1.0, 0.0);
 
+    CustomWaveform custom_waveform(
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_rest,
+        harmonic_9
+    );
+
     SimpleOscillator::WaveformParam waveform_param("");
     SimpleOscillator oscillator(
         waveform_param,
@@ -1069,6 +1269,58 @@ TEST(when_freq_is_changed_but_harmonics_stay_below_nyquist_then_they_are_kept, {
         dummy_float_param,
         dummy_float_param,
         dummy_toggle_param,
+        custom_waveform,
+        voice_status
+    );
+
+    amplitude.set_sample_rate(SAMPLE_RATE);
+    amplitude.set_block_size(block_size);
+
+    dummy_float_param.set_sample_rate(SAMPLE_RATE);
+    dummy_float_param.set_block_size(block_size);
+
+    harmonic_9.set_sample_rate(SAMPLE_RATE);
+    harmonic_9.set_block_size(block_size);
+
+    harmonic_rest.set_sample_rate(SAMPLE_RATE);
+    harmonic_rest.set_block_size(block_size);
+
+    waveform_param.set_sample_rate(SAMPLE_RATE);
+    waveform_param.set_block_size(block_size);
+    waveform_param.set_value(SimpleOscillator::CUSTOM);
+
+    oscillator.set_block_size(block_size);
+    oscillator.set_sample_rate(SAMPLE_RATE);
+
+    oscillator.frequency.set_value(start_frequency / 10.0);
+    oscillator.frequency.schedule_linear_ramp(
+        duration, (Number)end_frequency / 10.0
+    );
+
+    assert_oscillator_output_is_close_to_reference(
+        reference_sine, oscillator, SAMPLE_RATE, block_size, rounds, 0.02
+    );
+})
+
+
+TEST(partials_between_mipmap_levels_are_dropped_when_above_the_nyquist, {
+    constexpr Frequency frequency = NYQUIST_FREQUENCY / 9.9;
+    constexpr Integer block_size = 256;
+    constexpr Integer rounds = 3;
+
+    Byte const voice_status = Constants::VOICE_STATUS_NORMAL;
+
+    ReferenceSine reference_sine(frequency);
+    FloatParamS pulse_width("", 0.0, 1.0, 0.5);
+    FloatParamS amplitude("", 0.0, 1.0, 1.0);
+    FloatParamS dummy_float_param("", 0.0, 1.0, 0.0);
+    ToggleParam dummy_toggle_param("", ToggleParam::OFF);
+    FloatParamB harmonic_0("", -1.0, 1.0, 1.0);
+    FloatParamB harmonic_9("", -1.0, 1.0, 1.0);
+    FloatParamB harmonic_rest("", -1.0, 1.0, 0.0);
+
+    CustomWaveform custom_waveform(
+        harmonic_0,
         harmonic_rest,
         harmonic_rest,
         harmonic_rest,
@@ -1077,8 +1329,19 @@ TEST(when_freq_is_changed_but_harmonics_stay_below_nyquist_then_they_are_kept, {
         harmonic_rest,
         harmonic_rest,
         harmonic_rest,
-        harmonic_rest,
-        harmonic_9,
+        harmonic_9
+    );
+
+    SimpleOscillator::WaveformParam waveform_param("");
+    SimpleOscillator oscillator(
+        waveform_param,
+        pulse_width,
+        amplitude,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_float_param,
+        dummy_toggle_param,
+        custom_waveform,
         voice_status
     );
 
@@ -1088,6 +1351,9 @@ TEST(when_freq_is_changed_but_harmonics_stay_below_nyquist_then_they_are_kept, {
     dummy_float_param.set_sample_rate(SAMPLE_RATE);
     dummy_float_param.set_block_size(block_size);
 
+    harmonic_0.set_sample_rate(SAMPLE_RATE);
+    harmonic_0.set_block_size(block_size);
+
     harmonic_9.set_sample_rate(SAMPLE_RATE);
     harmonic_9.set_block_size(block_size);
 
@@ -1100,14 +1366,10 @@ TEST(when_freq_is_changed_but_harmonics_stay_below_nyquist_then_they_are_kept, {
 
     oscillator.set_block_size(block_size);
     oscillator.set_sample_rate(SAMPLE_RATE);
-
-    oscillator.frequency.set_value(start_frequency / 10.0);
-    oscillator.frequency.schedule_linear_ramp(
-        duration, (Number)end_frequency / 10.0
-    );
+    oscillator.frequency.set_value(frequency);
 
     assert_oscillator_output_is_close_to_reference(
-        reference_sine, oscillator, SAMPLE_RATE, block_size, rounds, 0.02
+        reference_sine, oscillator, SAMPLE_RATE, block_size, rounds, 0.01
     );
 })
 
@@ -1141,6 +1403,62 @@ TEST(oscillator_rendering_is_independent_of_chunk_size, {
 })
 
 
+void set_up_constant_frequency_test(
+        SimpleOscillator& oscillator,
+        Byte const waveform,
+        Seconds const ramp_duration
+) {
+    constexpr Frequency frequency = 1234.5;
+
+    oscillator.set_sample_rate(SAMPLE_RATE);
+    oscillator.set_block_size(300);
+    oscillator.start(0.0);
+    oscillator.waveform.set_value(waveform);
+    oscillator.frequency.set_value(frequency);
+
+    if (ramp_duration > 0.0) {
+        /* Keep the frequency unchanged, but force per-sample evaluation. */
+        oscillator.frequency.schedule_linear_ramp(ramp_duration, frequency);
+    }
+}
+
+
+TEST(constant_frequency_is_rendered_the_same_way_as_automated_frequency, {
+    constexpr Integer rounds = 3;
+    constexpr Integer size = rounds * 300;
+
+    Byte const waveforms[] = {
+        SimpleOscillator::SINE,
+        SimpleOscillator::SAWTOOTH,
+        SimpleOscillator::SQUARE,
+    };
+
+    for (Byte const waveform : waveforms) {
+        SimpleOscillator::WaveformParam waveform_param_1("");
+        SimpleOscillator::WaveformParam waveform_param_2("");
+        SimpleOscillator oscillator_1(waveform_param_1);
+        SimpleOscillator oscillator_2(waveform_param_2);
+        Buffer buffer_1(size);
+        Buffer buffer_2(size);
+
+        set_up_constant_frequency_test(oscillator_1, waveform, 0.0);
+        set_up_constant_frequency_test(oscillator_2, waveform, 1.0);
+
+        render_rounds<SimpleOscillator>(oscillator_1, buffer_1, rounds);
+        render_rounds<SimpleOscillator>(oscillator_2, buffer_2, rounds);
+
+        assert_eq(
+            buffer_2.samples[0],
+            buffer_1.samples[0],
+            size,
+            0.000001,
+            "waveform=%d",
+            (int)waveform
+        );
+    }
+})
+
+
 TEST(amplitude_modulation_creates_two_sidebands, {
     /* https://www.soundonsound.com/techniques/amplitude-modulation */
 
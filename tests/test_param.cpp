@@ -26,6 +26,7 @@
 #include "js80p.hpp"
 #include "midi.hpp"
 
+#include "dsp/cpu.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/lfo.cpp"
 #include "dsp/lfo_envelope_list.cpp"
@@ -38,6 +39,8 @@
 #include "dsp/signal_producer.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -399,6 +402,152 @@ TEST(float_param_can_tell_if_it_is_constant_through_the_next_round, {
 })
 
 
+TEST(only_params_which_may_change_are_kept_on_the_active_params_list, {
+    constexpr Integer block_size = 3;
+
+    FloatParamS* active_params = NULL;
+    FloatParamS float_param_1("float1", -1.0, 1.0, 0.0);
+    FloatParamS float_param_2("float2", -1.0, 1.0, 0.0);
+    MidiController midi_controller;
+
+    float_param_1.set_block_size(block_size);
+    float_param_1.set_sample_rate(1.0);
+    float_param_2.set_block_size(block_size);
+    float_param_2.set_sample_rate(1.0);
+
+    float_param_1.set_active_params_list(&active_params);
+    float_param_2.set_active_params_list(&active_params);
+
+    assert_true(active_params == &float_param_2);
+
+    FloatParamS::produce_active_params(&active_params, 1, block_size);
+
+    assert_true(active_params == NULL);
+
+    float_param_1.schedule_value(4.0, 1.0);
+    float_param_2.set_midi_controller(&midi_controller);
+
+    FloatParamS::produce_active_params(&active_params, 2, block_size);
+
+    assert_true(active_params == &float_param_2);
+    assert_eq(0.0, float_param_1.get_value(), DOUBLE_DELTA);
+
+    FloatParamS::produce_active_params(&active_params, 3, block_size);
+
+    assert_eq(1.0, float_param_1.get_value(), DOUBLE_DELTA);
+
+    float_param_2.set_midi_controller(NULL);
+
+    FloatParamS::produce_active_params(&active_params, 4, block_size);
+
+    assert_true(active_params == NULL);
+})
+
+
+TEST(scheduling_through_a_signal_producer_reference_activates_the_param, {
+    constexpr Integer block_size = 3;
+
+    FloatParamS* active_params = NULL;
+    FloatParamS float_param("float", -1.0, 1.0, 0.0);
+    SignalProducer& signal_producer = float_param;
+
+    float_param.set_block_size(block_size);
+    float_param.set_sample_rate(1.0);
+    float_param.set_active_params_list(&active_params);
+
+    FloatParamS::produce_active_params(&active_params, 1, block_size);
+
+    assert_true(active_params == NULL);
+
+    signal_producer.schedule(FloatParamS::EVT_SET_VALUE, 1.0, 0, 0.0, 0.5);
+
+    assert_true(active_params == &float_param);
+
+    FloatParamS::produce_active_params(&active_params, 2, block_size);
+
+    assert_eq(0.5, float_param.get_value(), DOUBLE_DELTA);
+    assert_true(active_params == NULL);
+})
+
+
+/*
+Lets go of its controller while it is processing the controller's events, and
+activates another param at the same time, so that it gets dropped from the
+active params list in the same round in which the other one is put on it.
+*/
+class ControllerReleasingParam : public FloatParamS
+{
+    public:
+        ControllerReleasingParam(FloatParamS& other)
+            : FloatParamS("releasing", -1.0, 1.0, 0.0),
+            other(other),
+            is_armed(false)
+        {
+        }
+
+        void arm() noexcept
+        {
+            is_armed = true;
+        }
+
+    protected:
+        virtual void handle_scheduled_event() noexcept override
+        {
+            FloatParamS::handle_scheduled_event();
+
+            if (!is_armed) {
+                return;
+            }
+
+            is_armed = false;
+            set_midi_controller(NULL);
+            other.schedule_value(0.0, 0.5);
+        }
+
+    private:
+        FloatParamS& other;
+        bool is_armed;
+};
+
+
+TEST(params_which_are_activated_while_the_active_list_is_produced_stay_on_it, {
+    constexpr Integer block_size = 3;
+
+    FloatParamS* active_params = NULL;
+    FloatParamS activated_param("activated", -1.0, 1.0, 0.0);
+    ControllerReleasingParam releasing_param(activated_param);
+    MidiController midi_controller;
+
+    activated_param.set_block_size(block_size);
+    activated_param.set_sample_rate(1.0);
+    releasing_param.set_block_size(block_size);
+    releasing_param.set_sample_rate(1.0);
+
+    activated_param.set_active_params_list(&active_params);
+    releasing_param.set_active_params_list(&active_params);
+
+    FloatParamS::produce_active_params(&active_params, 1, block_size);
+
+    assert_true(active_params == NULL);
+
+    releasing_param.set_midi_controller(&midi_controller);
+    midi_controller.change(PARAM_DEFAULT_MPE_CHANNEL, 0.0, 0.6);
+    releasing_param.arm();
+
+    assert_true(active_params == &releasing_param);
+
+    FloatParamS::produce_active_params(&active_params, 2, block_size);
+
+    assert_true(active_params == &activated_param);
+    assert_eq(0.0, activated_param.get_value(), DOUBLE_DELTA);
+
+    FloatParamS::produce_active_params(&active_params, 3, block_size);
+
+    assert_eq(0.5, activated_param.get_value(), DOUBLE_DELTA);
+    assert_true(active_params == NULL);
+})
+
+
 TEST(float_param_can_schedule_and_clamp_values_between_samples, {
     constexpr Integer block_size = 5;
     constexpr Sample expected_samples[] = {0.5, 0.5, 0.5, 1.0, 1.0};
@@ -505,6 +654,39 @@ TEST(float_param_can_schedule_linear_ramping_clamped_to_max_value, {
 })
 
 
+TEST(linear_ramp_may_end_between_samples_and_span_multiple_blocks, {
+    constexpr Integer block_size = 3;
+    constexpr Integer rounds = 3;
+    constexpr Sample expected_samples[rounds][block_size] = {
+        {0.0, 0.2, 0.4},
+        {0.6, 0.8, 1.0},
+        {1.1, 1.1, 1.1},
+    };
+    FloatParamS float_param("float", 0.0, 2.0, 0.0);
+
+    float_param.set_sample_rate(2.0);
+    float_param.set_block_size(block_size);
+    float_param.schedule_linear_ramp(2.75, 1.1);
+
+    for (Integer round = 0; round != rounds; ++round) {
+        Sample const* const* const rendered_samples = (
+            FloatParamS::produce<FloatParamS>(float_param, round, block_size)
+        );
+
+        assert_eq(
+            expected_samples[round],
+            rendered_samples[0],
+            block_size,
+            DOUBLE_DELTA,
+            "round=%d",
+            (int)round
+        );
+    }
+
+    assert_eq(1.1, float_param.get_value(), DOUBLE_DELTA);
+})
+
+
 TEST(float_param_can_schedule_linear_ramping_clamped_to_min_value, {
     constexpr Integer block_size = 20;
     constexpr Sample expected_samples[] = {
@@ -1246,6 +1428,82 @@ TEST(auto_skipping_a_follower_float_param_advances_the_clock_of_the_leader, {
 })
 
 
+TEST(all_followers_of_a_leader_get_the_same_buffer_in_a_round, {
+    constexpr Integer block_size = 5;
+    constexpr Integer followers_count = 4;
+    constexpr Sample expected_samples[] = {0.0, 0.2, 0.4, 0.6, 0.8};
+    FloatParamS leader("float", -1.0, 1.0, 0.0);
+    FloatParamS follower_1(leader);
+    FloatParamS follower_2(leader);
+    FloatParamS follower_3(leader);
+    FloatParamS follower_4(leader);
+    FloatParamS* followers[followers_count] = {
+        &follower_1, &follower_2, &follower_3, &follower_4
+    };
+
+    leader.set_block_size(block_size);
+    leader.set_sample_rate(10.0);
+    leader.schedule_linear_ramp(0.5, 1.0);
+
+    Sample const* const first_round = (
+        FloatParamS::produce_if_not_constant(follower_1, 1, block_size)
+    );
+
+    assert_eq(expected_samples, first_round, block_size, DOUBLE_DELTA);
+
+    for (Integer i = 1; i != followers_count; ++i) {
+        assert_eq(
+            (void*)first_round,
+            (void*)FloatParamS::produce_if_not_constant(
+                *followers[i], 1, block_size
+            ),
+            "follower=%d",
+            (int)i
+        );
+    }
+
+    Sample const* const second_round = (
+        FloatParamS::produce_if_not_constant(follower_1, 2, block_size)
+    );
+
+    for (Integer i = 1; i != followers_count; ++i) {
+        assert_eq(
+            (void*)second_round,
+            (void*)FloatParamS::produce_if_not_constant(
+                *followers[i], 2, block_size
+            ),
+            "follower=%d",
+            (int)i
+        );
+        assert_eq(1.0, followers[i]->get_value(), DOUBLE_DELTA);
+    }
+})
+
+
+TEST(followers_rendered_in_parallel_do_not_modify_the_leader, {
+    constexpr Integer block_size = 5;
+    FloatParamS leader("float", -1.0, 1.0, 0.0);
+    FloatParamS follower_1(leader);
+    FloatParamS follower_2(leader);
+
+    leader.set_block_size(block_size);
+    leader.set_sample_rate(10.0);
+
+    FloatParamS::set_rendering_in_parallel(true);
+    assert_true(follower_1.is_constant_in_next_round(1, block_size));
+    assert_true(follower_2.is_constant_in_next_round(1, block_size));
+    FloatParamS::set_rendering_in_parallel(false);
+
+    leader.schedule_linear_ramp(0.5, 1.0);
+
+    assert_false(leader.is_constant_in_next_round(1, block_size));
+
+    FloatParamS::set_rendering_in_parallel(true);
+    assert_false(follower_1.is_constant_in_next_round(2, block_size));
+    FloatParamS::set_rendering_in_parallel(false);
+})
+
+
 TEST(follower_float_param_does_not_render_its_own_signal, {
     constexpr Integer block_size = 10;
     FloatParamS leader("float", -1.0, 1.0, 0.0);
@@ -1667,7 +1925,7 @@ TEST(midi_controller_value_synchronization_may_be_scheduled, {
     );
     constexpr Sample expected_samples[sample_count] = {
         0.0, 0.1, 0.2, 0.3, 0.4,
-        0.5, 0.6, 0.7, 1.0, 1.0,
+        0.5, 0.6, 1.0, 1.0, 1.0,
     };
 
     FloatParamS float_param("F", 0.0, 1.0, 0.0);
@@ -1757,7 +2015,7 @@ TEST(macro_value_synchronization_may_be_scheduled, {
     );
     constexpr Sample expected_samples[sample_count] = {
         0.0, 0.1, 0.2, 0.3, 0.4,
-        0.5, 0.6, 0.7, 1.0, 1.0,
+        0.5, 0.6, 1.0, 1.0, 1.0,
     };
 
     FloatParamS float_param("F", 0.0, 1.0, 0.0);
@@ -3911,6 +4169,63 @@ TEST(when_first_lfo_in_chain_has_no_envelope_then_chain_is_rendered_globally, {
 })
 
 
+TEST(voices_share_the_rendering_of_lfos_without_envelopes, {
+    constexpr Integer block_size = 10;
+    constexpr Integer voices = 3;
+    constexpr Frequency sample_rate = 10.0;
+    Envelope envelope("E");
+    Envelope* const envelopes[Constants::ENVELOPES] = {
+        &envelope, NULL, NULL, NULL, NULL, NULL,
+        NULL, NULL, NULL, NULL, NULL, NULL,
+    };
+    LFO lfo("lfo", true);
+    FloatParamS leader("leader", 0.0, 10.0, 0.0, 0.0, envelopes);
+    FloatParamS voice_1(leader);
+    FloatParamS voice_2(leader);
+    FloatParamS voice_3(leader);
+    FloatParamS* const voice_params[voices] = {&voice_1, &voice_2, &voice_3};
+    Sample const* rendered_samples[voices];
+
+    lfo.set_block_size(block_size);
+    lfo.set_sample_rate(sample_rate);
+    lfo.frequency.set_value(1.0);
+    lfo.start(0.0);
+
+    leader.set_block_size(block_size);
+    leader.set_sample_rate(sample_rate);
+    leader.set_lfo(&lfo);
+
+    for (Integer i = 0; i != voices; ++i) {
+        voice_params[i]->set_block_size(block_size);
+        voice_params[i]->set_sample_rate(sample_rate);
+        voice_params[i]->start_envelope(
+            0.01 * (Seconds)i, PARAM_DEFAULT_MPE_CHANNEL, 0.0, 0.0
+        );
+    }
+
+    assert_false(leader.is_polyphonic());
+
+    for (Integer i = 0; i != voices; ++i) {
+        assert_false(voice_params[i]->is_polyphonic(), "voice=%d", (int)i);
+
+        rendered_samples[i] = FloatParamS::produce<FloatParamS>(
+            *voice_params[i], 1, block_size
+        )[0];
+    }
+
+    assert_eq((void*)rendered_samples[0], (void*)rendered_samples[1]);
+    assert_eq((void*)rendered_samples[0], (void*)rendered_samples[2]);
+
+    lfo.amplitude_envelope.set_value(0);
+
+    assert_true(leader.is_polyphonic());
+
+    for (Integer i = 0; i != voices; ++i) {
+        assert_true(voice_params[i]->is_polyphonic(), "voice=%d", (int)i);
+    }
+})
+
+
 TEST(chained_lfos_with_envelopes_are_rendered_with_envelopes, {
     constexpr Integer block_size = 20;
     constexpr Frequency sample_rate = 2.0;
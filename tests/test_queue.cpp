@@ -262,3 +262,91 @@ TEST(items_may_be_modified_in_place, {
     assert_eq(21, q[0].value);
     assert_eq(31, q[1].value);
 })
+
+
+TEST(ring_queue_allocates_all_memory_up_front, {
+    RingQueue<TestObj> q(4);
+
+    assert_true(q.is_empty());
+    assert_false(q.is_full());
+    assert_eq(0, (int)q.length());
+    assert_eq(4, (int)q.get_capacity());
+    assert_eq(0, (int)q.get_high_water_mark());
+    assert_eq(0, (int)q.get_overflows());
+})
+
+
+TEST(ring_queue_is_fifo_even_when_items_wrap_around, {
+    RingQueue<TestObj> q(3);
+
+    for (int i = 0; i != 10; ++i) {
+        assert_true(q.push(TestObj(i)));
+        assert_true(q.push(TestObj(i + 100)));
+
+        assert_eq(2, (int)q.length());
+        assert_eq(i, q[0].value);
+        assert_eq(i + 100, q[1].value);
+        assert_eq(i + 100, q.back().value);
+
+        assert_eq(i, q.pop().value);
+        assert_eq(i + 100, q.front().value);
+        assert_eq(i + 100, q.pop().value);
+        assert_true(q.is_empty());
+    }
+
+    assert_eq(2, (int)q.get_high_water_mark());
+    assert_eq(0, (int)q.get_overflows());
+})
+
+
+TEST(when_ring_queue_is_full_then_new_items_are_dropped_and_counted, {
+    RingQueue<TestObj> q(3);
+
+    assert_true(q.push(TestObj(1)));
+    assert_true(q.push(TestObj(2)));
+    assert_true(q.push(TestObj(3)));
+    assert_true(q.is_full());
+
+    assert_false(q.push(TestObj(4)));
+    assert_false(q.push(TestObj(5)));
+
+    assert_eq(3, (int)q.length());
+    assert_eq(1, q[0].value);
+    assert_eq(3, q.back().value);
+    assert_eq(3, (int)q.get_high_water_mark());
+    assert_eq(2, (int)q.get_overflows());
+
+    q.pop();
+    q.pop();
+    q.reset_statistics();
+
+    assert_eq(1, (int)q.get_high_water_mark());
+    assert_eq(0, (int)q.get_overflows());
+})
+
+
+TEST(ring_queue_elements_may_be_dropped_after_a_given_index, {
+    RingQueue<TestObj> q(4);
+
+    q.push(TestObj(10));
+    q.push(TestObj(20));
+    q.push(TestObj(30));
+    q.pop();
+    q.pop();
+    q.push(TestObj(40));
+    q.push(TestObj(50));
+    q.push(TestObj(60));
+
+    q.drop(2);
+
+    assert_eq(2, (int)q.length());
+    assert_eq(30, q[0].value);
+    assert_eq(40, q[1].value);
+    assert_eq(40, q.back().value);
+
+    q.drop(0);
+
+    assert_true(q.is_empty());
+    assert_true(q.push(TestObj(70)));
+    assert_eq(70, q.front().value);
+})
@@ -1006,6 +1006,113 @@ TEST(multiple_events_can_occur_at_the_same_time_offset, {
 })
 
 
+TEST(events_scheduled_while_others_are_pending_start_at_the_right_sample, {
+    constexpr Integer block_size = 3;
+    constexpr Integer rounds = 5;
+    constexpr Sample expected_samples[] = {
+        0.0, 0.0, 0.0,
+        0.0, 0.0, 1.0,
+        1.0, 1.0, 1.0,
+        1.0, 2.0, 2.0,
+        3.0, 3.0, 3.0,
+    };
+    EventTestSignalProducer signal_producer;
+    Buffer buffer(rounds * block_size, 1);
+    Integer next_sample_index = 0;
+
+    signal_producer.set_sample_rate(10.0);
+    signal_producer.set_block_size(block_size);
+
+    signal_producer.schedule(0.45, 1.0);
+    signal_producer.schedule(0.95, 2.0);
+
+    for (Integer round = 0; round != rounds; ++round) {
+        if (round == 2) {
+            assert_eq(
+                0.35,
+                signal_producer.get_last_event_time_offset(),
+                DOUBLE_DELTA
+            );
+            signal_producer.schedule(0.55, 3.0);
+        }
+
+        Sample const* const* const block = (
+            SignalProducer::produce<EventTestSignalProducer>(
+                signal_producer, round, block_size
+            )
+        );
+
+        for (Integer i = 0; i != block_size; ++i) {
+            buffer.samples[0][next_sample_index++] = block[0][i];
+        }
+    }
+
+    assert_eq(expected_samples, buffer.samples[0], rounds * block_size);
+    assert_false(signal_producer.has_events());
+})
+
+
+TEST(event_queue_has_fixed_capacity_and_reports_its_usage, {
+    constexpr Integer capacity = SignalProducer::EVENT_QUEUE_HEADROOM + 3;
+    SignalProducer signal_producer(1, 0, 3);
+
+    assert_eq((int)capacity, (int)signal_producer.get_event_queue_capacity());
+    assert_eq(0, (int)signal_producer.get_event_queue_high_water_mark());
+    assert_eq(0, (int)signal_producer.get_dropped_events());
+
+    for (Integer i = 0; i != capacity + 2; ++i) {
+        signal_producer.schedule(1, (Seconds)i);
+    }
+
+    assert_eq(
+        (Number)(capacity - 1),
+        signal_producer.get_last_event_time_offset(),
+        DOUBLE_DELTA
+    );
+    assert_eq(
+        (int)capacity, (int)signal_producer.get_event_queue_high_water_mark()
+    );
+    assert_eq(2, (int)signal_producer.get_dropped_events());
+
+    signal_producer.cancel_events();
+    signal_producer.reset_event_queue_statistics();
+
+    assert_eq(1, (int)signal_producer.get_event_queue_high_water_mark());
+    assert_eq(0, (int)signal_producer.get_dropped_events());
+})
+
+
+TEST(when_event_queue_is_full_then_events_before_first_cancel_are_coalesced, {
+    constexpr Integer capacity = SignalProducer::EVENT_QUEUE_HEADROOM + 3;
+    SignalProducer signal_producer(1, 0, 3);
+
+    signal_producer.schedule(1, 0.0);
+    signal_producer.schedule(1, 1.0);
+
+    for (Integer i = 2; i != capacity; ++i) {
+        signal_producer.cancel_events_at((Seconds)i);
+    }
+
+    assert_eq(
+        (int)capacity, (int)signal_producer.get_event_queue_high_water_mark()
+    );
+
+    signal_producer.schedule(1, (Seconds)capacity);
+
+    assert_eq(0, (int)signal_producer.get_dropped_events());
+    assert_eq(2, (int)signal_producer.get_coalesced_events());
+    assert_eq(
+        (Number)capacity,
+        signal_producer.get_last_event_time_offset(),
+        DOUBLE_DELTA
+    );
+
+    signal_producer.reset_event_queue_statistics();
+
+    assert_eq(0, (int)signal_producer.get_coalesced_events());
+})
+
+
 TEST(an_event_may_occur_between_samples, {
     constexpr Integer block_size = 5;
     constexpr Integer rounds = 2;
@@ -0,0 +1,120 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+Smoke test for SAMPLE_PRECISION=single builds: the Makefile always compiles
+this test with JS80P_SINGLE_PRECISION_SAMPLES, regardless of the precision of
+the rest of the build, since the other unit tests expect double precision.
+*/
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Frequency SAMPLE_RATE = 44100.0;
+constexpr Integer CHANNELS = 2;
+constexpr Integer BLOCK_SIZE = 256;
+constexpr Integer ROUNDS = 200;
+constexpr Integer SAMPLE_COUNT = BLOCK_SIZE * ROUNDS;
+
+
+TEST(samples_are_single_precision_but_filter_coefficients_are_not, {
+    BiquadFilterSharedBuffers shared_buffers;
+
+    assert_eq((int)sizeof(float), (int)sizeof(Sample));
+    assert_eq((int)sizeof(Number), (int)sizeof(*shared_buffers.b0_buffer));
+    assert_eq((int)sizeof(Number), (int)sizeof(*shared_buffers.a2_buffer));
+})
+
+
+void test_low_frequency_low_pass_filter(bool const ramp)
+{
+    SumOfSines input(0.0, 30.0, 0.5, 7040.0, 0.0, 0.0, CHANNELS);
+    SumOfSines expected(0.0, 30.0, 0.0, 7040.0, 0.0, 0.0, CHANNELS);
+    BiquadFilterTypeParam filter_type("");
+    BiquadFilter<SumOfSines> filter("", input, filter_type);
+    Buffer expected_output(SAMPLE_COUNT, CHANNELS);
+    Buffer actual_output(SAMPLE_COUNT, CHANNELS);
+
+    input.set_block_size(BLOCK_SIZE);
+    expected.set_block_size(BLOCK_SIZE);
+    filter.set_block_size(BLOCK_SIZE);
+
+    input.set_sample_rate(SAMPLE_RATE);
+    expected.set_sample_rate(SAMPLE_RATE);
+    filter.set_sample_rate(SAMPLE_RATE);
+
+    filter.type.set_value(BiquadFilter<SumOfSines>::LOW_PASS);
+    filter.q.set_value(0.0);
+
+    if (ramp) {
+        filter.frequency.set_value(1000.0);
+        filter.frequency.schedule_linear_ramp(0.1, 20.0);
+    } else {
+        filter.frequency.set_value(20.0);
+    }
+
+    render_rounds<SumOfSines>(expected, expected_output, ROUNDS);
+    render_rounds< BiquadFilter<SumOfSines> >(filter, actual_output, ROUNDS);
+
+    for (Integer c = 0; c != CHANNELS; ++c) {
+        /* Skip the transients at the beginning. */
+        Integer const offset = SAMPLE_COUNT / 2;
+
+        assert_close(
+            &expected_output.samples[c][offset],
+            &actual_output.samples[c][offset],
+            SAMPLE_COUNT - offset,
+            0.001,
+            "channel=%d",
+            (int)c
+        );
+    }
+}
+
+
+TEST(low_frequency_low_pass_filter_is_stable_with_constant_coefficients, {
+    test_low_frequency_low_pass_filter(false);
+})
+
+
+TEST(low_frequency_low_pass_filter_is_stable_with_changing_coefficients, {
+    test_low_frequency_low_pass_filter(true);
+})
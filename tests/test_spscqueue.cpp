@@ -1,6 +1,6 @@
 /*
  * This file is part of JS80P, a synthesizer plugin.
- * Copyright (C) 2023, 2024  Attila M. Magyar
+ * Copyright (C) 2023, 2024, 2026  Attila M. Magyar
  *
  * JS80P is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -154,3 +154,52 @@ TEST(queue_can_be_filled_and_emptied_multiple_times, {
 
     }
 })
+
+
+TEST(items_can_be_pushed_and_popped_in_batches, {
+    SPSCQueue<std::string> q(5);
+    std::string const batch[] = {"a", "b", "c", "d", "e", "f", "g"};
+    std::string popped[7];
+
+    assert_eq(3, q.push_batch(batch, 3));
+    assert_eq(3, q.length());
+
+    assert_eq(2, q.pop_batch(popped, 2));
+    assert_eq(1, q.length());
+    assert_eq("a", popped[0]);
+    assert_eq("b", popped[1]);
+
+    /* Wraps around the end of the underlying storage. */
+    assert_eq(4, q.push_batch(&batch[3], 4));
+    assert_eq(5, q.length());
+    assert_eq(0, q.push_batch(batch, 1));
+    assert_false(q.push("x"));
+
+    assert_eq(5, q.pop_batch(popped, 7));
+    assert_true(q.is_empty());
+    assert_eq("c", popped[0]);
+    assert_eq("d", popped[1]);
+    assert_eq("e", popped[2]);
+    assert_eq("f", popped[3]);
+    assert_eq("g", popped[4]);
+
+    assert_eq(0, q.pop_batch(popped, 7));
+})
+
+
+TEST(batch_push_is_truncated_when_the_queue_is_almost_full, {
+    SPSCQueue<std::string> q(4);
+    std::string const batch[] = {"b", "c", "d", "e"};
+    std::string item;
+
+    assert_true(q.push("a"));
+    assert_eq(3, q.push_batch(batch, 4));
+    assert_eq(4, q.length());
+
+    for (char c = 'a'; c != 'e'; ++c) {
+        assert_true(q.pop(item));
+        assert_eq(c, item[0]);
+    }
+
+    assert_false(q.pop(item));
+})
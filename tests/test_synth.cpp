@@ -305,6 +305,37 @@ TEST(midi_controller_changes_can_affect_parameters, {
 })
 
 
+TEST(chained_macros_are_evaluated_in_dependency_order_in_each_block, {
+    Synth synth;
+
+    synth.resume();
+
+    synth.set_block_size(128);
+
+    assign_controller(synth, Synth::ParamId::PM, Synth::ControllerId::MACRO_1);
+    assign_controller(
+        synth, Synth::ParamId::M1IN, Synth::ControllerId::MACRO_2
+    );
+    assign_controller(
+        synth, Synth::ParamId::M2IN, Synth::ControllerId::MODULATION_WHEEL
+    );
+
+    synth.control_change(0.0, 1, Midi::MODULATION_WHEEL, 53);
+    SignalProducer::produce<Synth>(synth, 1);
+
+    assert_eq(
+        53.0 / 127.0, synth.phase_modulation_level.get_ratio(), DOUBLE_DELTA
+    );
+
+    synth.control_change(0.0, 1, Midi::MODULATION_WHEEL, 114);
+    SignalProducer::produce<Synth>(synth, 2);
+
+    assert_eq(
+        114.0 / 127.0, synth.phase_modulation_level.get_ratio(), DOUBLE_DELTA
+    );
+})
+
+
 TEST(can_look_up_param_id_by_name, {
     Synth synth;
     Integer max_collisions;
@@ -1464,6 +1495,58 @@ TEST(can_process_messages_synchronously, {
 })
 
 
+void assert_changed_params(
+        Synth& synth,
+        std::vector<Synth::ParamId> const& expected_param_ids
+) {
+    std::vector<Synth::ParamId> param_ids;
+    Synth::ParamId param_id;
+
+    while (synth.pop_changed_param(param_id)) {
+        param_ids.push_back(param_id);
+    }
+
+    assert_eq((int)expected_param_ids.size(), (int)param_ids.size());
+
+    for (size_t i = 0; i != param_ids.size(); ++i) {
+        assert_eq((int)expected_param_ids[i], (int)param_ids[i], "i=%d", (int)i);
+    }
+}
+
+
+TEST(gui_is_notified_only_about_actually_changed_params, {
+    Synth synth;
+
+    assert_changed_params(synth, {});
+    assert_false(synth.have_param_changes_been_dropped());
+
+    synth.process_message(SET_PARAM, Synth::ParamId::PM, 0.123, 0);
+    synth.process_message(SET_PARAM, Synth::ParamId::PM, 0.123, 0);
+    synth.process_message(REFRESH_PARAM, Synth::ParamId::MIX, 0.0, 0);
+    synth.process_message(
+        ASSIGN_CONTROLLER, Synth::ParamId::FM, 0.0, Synth::ControllerId::MACRO_1
+    );
+    synth.process_message(
+        ASSIGN_CONTROLLER, Synth::ParamId::FM, 0.0, Synth::ControllerId::MACRO_1
+    );
+    assert_changed_params(synth, {Synth::ParamId::PM, Synth::ParamId::FM});
+
+    synth.modulator_add_volume.set_value(0.42);
+    synth.process_message(REFRESH_PARAM, Synth::ParamId::MIX, 0.0, 0);
+    assert_changed_params(synth, {Synth::ParamId::MIX});
+    assert_false(synth.have_param_changes_been_dropped());
+
+    for (int i = 0; i != 5000; ++i) {
+        Number const ratio = (i & 1) == 0 ? 0.2 : 0.3;
+
+        synth.process_message(SET_PARAM, Synth::ParamId::PM, ratio, 0);
+    }
+
+    assert_true(synth.have_param_changes_been_dropped());
+    assert_false(synth.have_param_changes_been_dropped());
+})
+
+
 void set_up_peak_controller_test(Synth& synth)
 {
     synth.set_block_size(PEAK_CTL_TEST_BLOCK_SIZE);
@@ -2394,6 +2477,161 @@ TEST(keeps_track_of_number_of_active_voices, {
 })
 
 
+Integer count_zero_crossings(Sample const* const samples, Integer const size)
+{
+    Integer zero_crossings = 0;
+
+    for (Integer i = 1; i != size; ++i) {
+        if ((samples[i - 1] < 0.0) != (samples[i] < 0.0)) {
+            ++zero_crossings;
+        }
+    }
+
+    return zero_crossings;
+}
+
+
+TEST(many_short_notes_in_a_single_block_leave_the_voices_in_the_right_state, {
+    constexpr Frequency sample_rate = 44100.0;
+    constexpr Integer block_size = 8192;
+    constexpr Integer notes = 16;
+    constexpr Seconds note_length = (
+        (Seconds)block_size / sample_rate / (Seconds)notes
+    );
+    constexpr Frequency expected_frequency = 311.127;
+
+    Synth synth;
+    Sample const* const* rendered_samples;
+    Integer round = 0;
+
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(sample_rate);
+
+    synth.resume();
+
+    set_param(
+        synth,
+        Synth::ParamId::MPRT,
+        synth.modulator_params.portamento_length.value_to_ratio(0.1)
+    );
+    set_param(
+        synth,
+        Synth::ParamId::CPRT,
+        synth.carrier_params.portamento_length.value_to_ratio(0.1)
+    );
+    synth.process_messages();
+    synth.mono_mode_on(0.0, 0);
+    synth.generate_samples(++round, block_size);
+
+    for (Integer i = 0; i != notes; ++i) {
+        Seconds const time_offset = note_length * (Seconds)i;
+        Midi::Note const note = Midi::NOTE_C_4 + (Midi::Note)(i % 12);
+
+        synth.note_on(time_offset, 1, note, 100);
+
+        if (i != notes - 1) {
+            synth.note_off(time_offset + note_length * 0.5, 1, note, 100);
+        }
+    }
+
+    for (Integer i = 0; i != 30; ++i) {
+        synth.generate_samples(++round, block_size);
+    }
+
+    rendered_samples = synth.generate_samples(++round, block_size);
+
+    assert_eq(
+        expected_frequency,
+        (Frequency)count_zero_crossings(rendered_samples[0], block_size)
+            * 0.5 * sample_rate / (Frequency)block_size,
+        expected_frequency * 0.01
+    );
+
+    synth.note_off(0.0, 1, Midi::NOTE_D_SHARP_4, 100);
+
+    for (Integer i = 0; i != 30; ++i) {
+        synth.generate_samples(++round, block_size);
+    }
+
+    assert_eq(0, (int)synth.get_active_voices_count());
+})
+
+
+void set_up_voice_rendering_threads_test(
+        Synth& synth,
+        Integer const threads
+) {
+    constexpr Integer block_size = 256;
+
+    synth.set_voice_rendering_threads(threads);
+    synth.set_block_size(block_size);
+    synth.set_sample_rate(22050.0);
+
+    synth.resume();
+
+    set_param(synth, Synth::ParamId::FM, 0.3);
+    set_param(synth, Synth::ParamId::MF1FRQ, 0.5);
+    set_param(synth, Synth::ParamId::MF1Q, 0.3);
+    set_param(synth, Synth::ParamId::CF1FRQ, 0.4);
+    set_param(synth, Synth::ParamId::CF2Q, 0.6);
+    set_param(synth, Synth::ParamId::L1FRQ, 0.2);
+
+    assign_controller(
+        synth, Synth::ParamId::MF1FRQ, Synth::ControllerId::ENVELOPE_1
+    );
+    assign_controller(
+        synth, Synth::ParamId::CF2FRQ, Synth::ControllerId::LFO_1
+    );
+    assign_controller(
+        synth, Synth::ParamId::CF2Q, Synth::ControllerId::MACRO_1
+    );
+
+    synth.process_messages();
+
+    for (Integer i = 0; i != 12; ++i) {
+        Seconds const time_offset = 0.001 * (Seconds)(i * 37);
+
+        synth.note_on(time_offset, 1, Midi::NOTE_A_2 + 5 * i, 64 + 5 * i);
+        synth.note_off(time_offset + 0.3, 1, Midi::NOTE_A_2 + 5 * i, 64);
+    }
+}
+
+
+TEST(parallel_voice_rendering_yields_the_same_output_as_serial_rendering, {
+    constexpr Integer rounds = 40;
+    constexpr Integer buffer_size = rounds * 256;
+
+    Synth synth_1;
+    Synth synth_2;
+    Buffer buffer_1(buffer_size, synth_1.get_channels());
+    Buffer buffer_2(buffer_size, synth_2.get_channels());
+
+    set_up_voice_rendering_threads_test(synth_1, 1);
+    set_up_voice_rendering_threads_test(synth_2, 4);
+
+    assert_eq(1, (int)synth_1.get_voice_rendering_threads());
+    assert_eq(4, (int)synth_2.get_voice_rendering_threads());
+
+    render_rounds<Synth>(synth_1, buffer_1, rounds);
+    render_rounds<Synth>(synth_2, buffer_2, rounds);
+
+    for (Integer c = 0; c != synth_1.get_channels(); ++c) {
+        assert_eq(
+            buffer_1.samples[c], buffer_2.samples[c], buffer_size, 0.0
+        );
+    }
+
+    synth_2.set_voice_rendering_threads(0);
+    assert_eq(1, (int)synth_2.get_voice_rendering_threads());
+
+    synth_2.set_voice_rendering_threads(WorkerPool::MAX_THREADS + 1);
+    assert_eq(
+        (int)WorkerPool::MAX_THREADS,
+        (int)synth_2.get_voice_rendering_threads()
+    );
+})
+
+
 TEST(keeps_track_of_tape_state, {
     Synth synth;
 
@@ -0,0 +1,275 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "test.cpp"
+#include "utils.cpp"
+
+#include "js80p.hpp"
+
+#include "dsp/cpu.cpp"
+#include "dsp/distortion.cpp"
+#include "dsp/envelope.cpp"
+#include "dsp/filter.cpp"
+#include "dsp/lfo.cpp"
+#include "dsp/lfo_envelope_list.cpp"
+#include "dsp/macro.cpp"
+#include "dsp/math.cpp"
+#include "dsp/midi_controller.cpp"
+#include "dsp/oscillator.cpp"
+#include "dsp/param.cpp"
+#include "dsp/queue.cpp"
+#include "dsp/signal_producer.cpp"
+#include "dsp/wavetable.cpp"
+
+#include "table_cache.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer SIZE = 100;
+
+
+std::string get_test_directory()
+{
+#ifdef _WIN32
+    char const* const temp = std::getenv("TEMP");
+
+    return (
+        std::string(temp == NULL || *temp == '\x00' ? "." : temp)
+        + "\\js80p-test-table-cache"
+    );
+#else
+    char const* const temp = std::getenv("TMPDIR");
+
+    return (
+        std::string(temp == NULL || *temp == '\x00' ? "/tmp" : temp)
+        + "/js80p-test-table-cache"
+    );
+#endif
+}
+
+
+void remove_cache_file(std::string const& name, size_t const size)
+{
+    TableCache const table_cache(get_test_directory(), name, size);
+
+    std::remove(table_cache.get_path().c_str());
+}
+
+
+TEST(when_directory_is_empty_then_nothing_is_cached, {
+    Number tables[SIZE];
+    TableCache table_cache("", "test", sizeof(tables));
+
+    std::fill_n(tables, SIZE, 1.0);
+
+    assert_eq("", table_cache.get_path());
+    assert_eq(NULL, table_cache.get_data());
+    assert_false(table_cache.store(tables));
+})
+
+
+TEST(stored_tables_are_mapped_by_the_next_instance, {
+    Number tables[SIZE];
+
+    for (Integer i = 0; i != SIZE; ++i) {
+        tables[i] = (Number)i * 0.5;
+    }
+
+    remove_cache_file("test", sizeof(tables));
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_eq(NULL, table_cache.get_data());
+        assert_true(table_cache.store(tables));
+        assert_eq(NULL, table_cache.get_data());
+    }
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_false(table_cache.get_data() == NULL);
+        assert_eq(tables, (Number const*)table_cache.get_data(), SIZE, 0.0);
+        assert_false(table_cache.store(tables));
+    }
+
+    remove_cache_file("test", sizeof(tables));
+})
+
+
+TEST(cache_file_with_different_size_is_ignored, {
+    Number tables[SIZE];
+
+    std::fill_n(tables, SIZE, 1.0);
+    remove_cache_file("test", sizeof(tables));
+
+    {
+        TableCache table_cache(
+            get_test_directory(), "test", sizeof(tables) / 2
+        );
+
+        assert_true(table_cache.store(tables));
+    }
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_eq(NULL, table_cache.get_data());
+    }
+
+    remove_cache_file("test", sizeof(tables));
+})
+
+
+void overwrite_file(
+        std::string const& path,
+        std::streamoff const offset,
+        char const* const data,
+        std::streamsize const size
+) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+
+    assert_true(file.is_open(), "path=%s", path.c_str());
+
+    file.seekp(offset);
+    file.write(data, size);
+}
+
+
+TEST(corrupted_cache_file_is_ignored, {
+    Number tables[SIZE];
+    char const garbage[] = {'x', 'y', 'z'};
+
+    std::fill_n(tables, SIZE, 1.0);
+    remove_cache_file("test", sizeof(tables));
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_true(table_cache.store(tables));
+        overwrite_file(
+            table_cache.get_path(),
+            (std::streamoff)sizeof(tables),
+            garbage,
+            (std::streamsize)sizeof(garbage)
+        );
+    }
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_eq(NULL, table_cache.get_data());
+    }
+
+    remove_cache_file("test", sizeof(tables));
+})
+
+
+TEST(cache_file_of_different_tables_with_the_same_size_is_ignored, {
+    Number tables[SIZE];
+
+    std::fill_n(tables, SIZE, 1.0);
+    remove_cache_file("test", sizeof(tables));
+    remove_cache_file("other", sizeof(tables));
+
+    {
+        TableCache other(get_test_directory(), "other", sizeof(tables));
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_true(other.store(tables));
+        assert_eq(
+            0,
+            std::rename(other.get_path().c_str(), table_cache.get_path().c_str())
+        );
+    }
+
+    {
+        TableCache table_cache(get_test_directory(), "test", sizeof(tables));
+
+        assert_eq(NULL, table_cache.get_data());
+    }
+
+    remove_cache_file("test", sizeof(tables));
+    remove_cache_file("other", sizeof(tables));
+})
+
+
+void assert_distortion_tables_eq(
+        Distortion::Tables const& expected,
+        Distortion::Tables const& actual
+) {
+    for (Byte type = 0; type != Distortion::TYPES; ++type) {
+        assert_eq(
+            expected.get_f_table(type),
+            actual.get_f_table(type),
+            Distortion::Tables::SIZE,
+            0.0,
+            "type=%d",
+            (int)type
+        );
+        assert_eq(
+            expected.get_F0_table(type),
+            actual.get_F0_table(type),
+            Distortion::Tables::SIZE,
+            0.0,
+            "type=%d",
+            (int)type
+        );
+    }
+}
+
+
+TEST(distortion_tables_loaded_from_the_cache_are_the_same_as_computed_ones, {
+    std::string const name = (
+        "distortion-v"
+        + std::to_string(Distortion::Tables::VERSION)
+        + "-"
+        + std::to_string(Distortion::TYPES)
+        + "x"
+        + std::to_string(Distortion::Tables::SIZE)
+        + "-"
+        + std::to_string((int)Distortion::Tables::INPUT_MAX)
+    );
+    size_t const size = (
+        sizeof(Distortion::Table) * Distortion::TYPES * 2
+    );
+
+    remove_cache_file(name, size);
+
+    Distortion::Tables const computed("");
+    Distortion::Tables const stored(get_test_directory());
+    Distortion::Tables const loaded(get_test_directory());
+
+    {
+        TableCache table_cache(get_test_directory(), name, size);
+
+        assert_false(table_cache.get_data() == NULL);
+    }
+
+    assert_distortion_tables_eq(computed, stored);
+    assert_distortion_tables_eq(computed, loaded);
+
+    remove_cache_file(name, size);
+})
@@ -27,7 +27,9 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/effect.cpp"
 #include "dsp/envelope.cpp"
@@ -45,6 +47,8 @@
 #include "dsp/tape.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
+
 
 using namespace JS80P;
 
@@ -190,6 +194,104 @@ TEST(tape_is_only_engaged_when_bypass_toggle_value_is_matched, {
 })
 
 
+typedef Tape<FixedSignalProducer, ToggleParam::ON> TapeOn;
+
+
+void set_up_tape_params(TapeParams& params, bool const is_engaged) noexcept
+{
+    params.stop_start.set_value(0.0);
+    params.wnf_amp.set_value(is_engaged ? 0.001 : 0.0);
+    params.distortion_level.set_value(is_engaged ? 1.0 : 0.0);
+    params.distortion_type.set_value(Distortion::TYPE_TANH_10);
+    params.color.set_value(is_engaged ? 0.8 : 0.5);
+    params.hiss_level.set_value(is_engaged ? 0.001 : 0.0);
+}
+
+
+void assert_tape_output(
+        TapeOn& tape,
+        Integer const round,
+        Sample const* const expected,
+        char const* const message
+) {
+    Sample const* const* const rendered = SignalProducer::produce<TapeOn>(
+        tape, round, BLOCK_SIZE
+    );
+
+    assert_eq(expected, rendered[0], DOUBLE_DELTA, "%s, channel=0", message);
+    assert_eq(expected, rendered[1], DOUBLE_DELTA, "%s, channel=1", message);
+}
+
+
+TEST(tape_commits_its_delay_buffer_in_the_arena_only_while_it_is_engaged, {
+    constexpr Frequency sample_rate = 1000.0;
+    constexpr Integer idle_rounds = (Integer)(6.0 * sample_rate) / BLOCK_SIZE;
+
+    Sample input_channel[BLOCK_SIZE] = {
+        0.9, 0.9, 0.9, 0.9, 0.9, 0.9, 0.9, 0.9, 0.9, 0.9,
+    };
+    Sample distorted[BLOCK_SIZE] = {
+        1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+    };
+    Sample* const input_channels[FixedSignalProducer::CHANNELS] = {
+        input_channel, input_channel
+    };
+    FixedSignalProducer input(input_channels);
+    ToggleParam toggle("B", ToggleParam::ON);
+    TapeParams params("T", toggle);
+    DelayBufferArena arena;
+    TapeOn tape("T", params, input, rng);
+    Integer round = 0;
+
+    tape.set_sample_rate(sample_rate);
+    tape.use_delay_buffer_arena(arena);
+    arena.allocate();
+
+    set_up_tape_params(params, false);
+    assert_tape_output(tape, ++round, input_channel, "neutral");
+
+    set_up_tape_params(params, true);
+    assert_tape_output(
+        tape, ++round, input_channel, "engaged, waiting for memory"
+    );
+
+    arena.update_regions();
+    assert_tape_output(tape, ++round, distorted, "engaged, memory committed");
+
+    set_up_tape_params(params, false);
+
+    for (Integer i = 0; i != idle_rounds; ++i) {
+        assert_tape_output(tape, ++round, input_channel, "idle");
+    }
+
+    arena.update_regions();
+
+    set_up_tape_params(params, true);
+    assert_tape_output(
+        tape, ++round, input_channel, "engaged again, waiting for memory"
+    );
+
+    arena.update_regions();
+    assert_tape_output(
+        tape, ++round, distorted, "engaged again, memory committed"
+    );
+
+    set_up_tape_params(params, false);
+
+    for (Integer i = 0; i != idle_rounds; ++i) {
+        assert_tape_output(tape, ++round, input_channel, "idle again");
+    }
+
+    arena.update_regions();
+
+    tape.commit_delay_buffer_now();
+    set_up_tape_params(params, true);
+    assert_tape_output(
+        tape, ++round, distorted, "engaged after committing in advance"
+    );
+})
+
+
 class TapeStopTestStep
 {
     public:
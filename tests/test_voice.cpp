@@ -25,7 +25,9 @@
 #include "js80p.hpp"
 
 #include "dsp/biquad_filter.cpp"
+#include "dsp/cpu.cpp"
 #include "dsp/delay.cpp"
+#include "dsp/delay_buffer_arena.cpp"
 #include "dsp/distortion.cpp"
 #include "dsp/envelope.cpp"
 #include "dsp/filter.cpp"
@@ -42,6 +44,7 @@
 #include "dsp/wavefolder.cpp"
 #include "dsp/wavetable.cpp"
 
+#include "table_cache.cpp"
 #include "voice.cpp"
 
 
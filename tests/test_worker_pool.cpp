@@ -0,0 +1,196 @@
+/*
+ * This file is part of JS80P, a synthesizer plugin.
+ * Copyright (C) 2026  Attila M. Magyar
+ *
+ * JS80P is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JS80P is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "test.cpp"
+
+#include "js80p.hpp"
+
+#include "worker_pool.cpp"
+
+
+using namespace JS80P;
+
+
+constexpr Integer JOBS = 64;
+
+
+class Jobs
+{
+    public:
+        static void run(
+                void* context,
+                Integer const job,
+                Integer const thread
+        ) noexcept {
+            Jobs& jobs = *(Jobs*)context;
+
+            jobs.runs[job].fetch_add(1);
+            jobs.threads[job] = thread;
+        }
+
+        Jobs()
+        {
+            for (Integer i = 0; i != JOBS; ++i) {
+                runs[i].store(0);
+                threads[i] = -1;
+            }
+        }
+
+        std::atomic<Integer> runs[JOBS];
+        Integer threads[JOBS];
+};
+
+
+void assert_all_jobs_run_exactly_once(
+        WorkerPool& worker_pool,
+        Integer const batches,
+        bool const vary_count = false
+) {
+    for (Integer b = 0; b != batches; ++b) {
+        Jobs jobs;
+        Integer const count = vary_count ? 2 + (b * 7) % (JOBS - 1) : JOBS;
+
+        worker_pool.run(&Jobs::run, (void*)&jobs, count);
+
+        for (Integer i = 0; i != JOBS; ++i) {
+            if (i >= count) {
+                assert_eq(0, (int)jobs.runs[i].load());
+
+                continue;
+            }
+
+            assert_eq(
+                1,
+                (int)jobs.runs[i].load(),
+                "batch=%d, job=%d",
+                (int)b,
+                (int)i
+            );
+            assert_gte((int)jobs.threads[i], 0);
+            assert_lt(
+                (int)jobs.threads[i], (int)worker_pool.get_threads()
+            );
+        }
+    }
+}
+
+
+TEST(number_of_threads_is_clamped, {
+    WorkerPool worker_pool;
+
+    assert_eq(1, (int)worker_pool.get_threads());
+
+    worker_pool.set_threads(0);
+    assert_eq(1, (int)worker_pool.get_threads());
+
+    worker_pool.set_threads(WorkerPool::MAX_THREADS + 1);
+    assert_eq((int)WorkerPool::MAX_THREADS, (int)worker_pool.get_threads());
+})
+
+
+TEST(when_single_threaded_then_jobs_are_run_on_the_calling_thread, {
+    WorkerPool worker_pool;
+    Jobs jobs;
+
+    worker_pool.run(&Jobs::run, (void*)&jobs, JOBS);
+
+    for (Integer i = 0; i != JOBS; ++i) {
+        assert_eq(1, (int)jobs.runs[i].load());
+        assert_eq(0, (int)jobs.threads[i]);
+    }
+})
+
+
+TEST(each_job_of_each_batch_is_run_exactly_once, {
+    WorkerPool worker_pool;
+
+    worker_pool.set_threads(4);
+    assert_all_jobs_run_exactly_once(worker_pool, 500);
+
+    worker_pool.set_threads(2);
+    assert_all_jobs_run_exactly_once(worker_pool, 500);
+})
+
+
+TEST(when_batch_sizes_vary_then_stale_tickets_do_not_claim_jobs, {
+    WorkerPool worker_pool;
+
+    worker_pool.set_threads(4);
+    assert_all_jobs_run_exactly_once(worker_pool, 2000, true);
+})
+
+
+class WaitingJobs
+{
+    public:
+        /*
+        The first job to be claimed keeps its thread busy until the second job
+        is done, so the second one can only be run by another thread.
+        */
+        static void run(
+                void* context,
+                Integer const job,
+                Integer const thread
+        ) noexcept {
+            WaitingJobs& jobs = *(WaitingJobs*)context;
+
+            if (jobs.claimed.fetch_add(1) != 0) {
+                jobs.is_done.store(true);
+
+                return;
+            }
+
+            std::chrono::steady_clock::time_point const deadline = (
+                std::chrono::steady_clock::now() + std::chrono::seconds(2)
+            );
+
+            while (
+                    !jobs.is_done.load()
+                    && std::chrono::steady_clock::now() < deadline
+            ) {
+                std::this_thread::yield();
+            }
+        }
+
+        WaitingJobs() : claimed(0), is_done(false)
+        {
+        }
+
+        std::atomic<Integer> claimed;
+        std::atomic<bool> is_done;
+};
+
+
+TEST(idle_workers_are_woken_up_by_the_next_batch, {
+    WorkerPool worker_pool;
+
+    worker_pool.set_threads(2);
+
+    for (Integer i = 0; i != 3; ++i) {
+        WaitingJobs jobs;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        worker_pool.run(&WaitingJobs::run, (void*)&jobs, 2);
+
+        assert_true(jobs.is_done.load(), "batch=%d", (int)i);
+    }
+})
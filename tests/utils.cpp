@@ -230,6 +230,7 @@ class SumOfSines : public SignalProducer
         void reset() noexcept override
         {
             current_time = 0.0;
+            current_sample = 0;
             rendered_samples = 0;
             cached_round = -1;
             events.drop(0);